@@ -192,6 +192,14 @@ public:
 	 */
 	virtual Common::SeekableReadStream *createReadStreamForAltStream(Common::AltStreamType altStreamType);
 
+	/**
+	 * Gets the time the object referred by this node was last modified,
+	 * in seconds. It is only meant to tell whether the file changed.
+	 *
+	 * @return false if the backend cannot tell the modification time
+	 */
+	virtual bool getModificationTime(int64 &time) const;
+
 	/**
 	 * Creates a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
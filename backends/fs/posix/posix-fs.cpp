@@ -67,6 +67,15 @@ bool POSIXFilesystemNode::isWritable() const {
 	return access(_path.c_str(), W_OK) == 0;
 }
 
+bool POSIXFilesystemNode::getModificationTime(int64 &time) const {
+	struct stat st;
+	if (stat(_path.c_str(), &st) != 0)
+		return false;
+
+	time = st.st_mtime;
+	return true;
+}
+
 void POSIXFilesystemNode::setFlags() {
 	struct stat st;
 
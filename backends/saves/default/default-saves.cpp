@@ -36,6 +36,8 @@
 #include "common/fs.h"
 #include "common/archive.h"
 #include "common/config-manager.h"
+#include "common/memstream.h"
+#include "common/events.h"
 #include "common/compression/deflate.h"
 
 #include <errno.h>	// for removeSavefile()
@@ -44,13 +46,84 @@
 const char *const DefaultSaveFileManager::TIMESTAMPS_FILENAME = "timestamps";
 #endif
 
-DefaultSaveFileManager::DefaultSaveFileManager() {
+/**
+ * Write stream handed out by openForSaving() when "async_saves" is enabled.
+ *
+ * The save file is opened right away, so that the engine is told about a
+ * file which can't be created as usual, but the engine serializes into
+ * memory. When the stream is finalized (or deleted), the buffer is handed
+ * over to the save file manager, which compresses and writes it from the
+ * event loop a chunk per poll, once the engine has moved on.
+ *
+ * This only spreads the work over several frames: it is still done on the
+ * engine thread, and thumbnails are still captured when the engine saves
+ * since they are read from the screen. Errors while writing are reported
+ * by SaveFileManager::waitForPendingSaves(), or by the next save.
+ */
+class AsyncSaveWriteStream : public Common::SeekableWriteStream {
+public:
+	AsyncSaveWriteStream(DefaultSaveFileManager *manager, const Common::String &filename, Common::WriteStream *file) :
+		_manager(manager), _filename(filename), _file(file), _failed(false), _buffer(DisposeAfterUse::NO) {}
+
+	~AsyncSaveWriteStream() override {
+		finalize();
+	}
+
+	uint32 write(const void *dataPtr, uint32 dataSize) override {
+		if (!_file)
+			return 0;
+		return _buffer.write(dataPtr, dataSize);
+	}
+
+	bool err() const override { return _failed; }
+	void clearErr() override { _failed = false; }
+
+	int64 pos() const override { return _buffer.pos(); }
+	int64 size() const override { return _buffer.size(); }
+	bool seek(int64 offset, int whence = SEEK_SET) override { return _file && _buffer.seek(offset, whence); }
+
+	void finalize() override {
+		if (!_file)
+			return;
+
+		// A previous save which failed to be written most likely means
+		// this one will fail too, so tell the engine now
+		Common::String errorDesc;
+		if (_manager->takePendingSavesError(errorDesc) != Common::kNoError) {
+			warning("DefaultSaveFileManager: Previous save failed: %s", errorDesc.c_str());
+			_failed = true;
+		}
+
+		// The manager takes ownership of the buffer and of the file
+		_manager->queueAsyncSave(_filename, _file, _buffer.getData(), _buffer.size());
+		_file = nullptr;
+	}
+
+private:
+	DefaultSaveFileManager *_manager;
+	Common::String _filename;
+	Common::WriteStream *_file;
+	bool _failed;
+	Common::MemoryWriteStreamDynamic _buffer;
+};
+
+DefaultSaveFileManager::DefaultSaveFileManager() : _pendingSavesError(Common::kNoError), _pollObserverInstalled(false) {
 }
 
-DefaultSaveFileManager::DefaultSaveFileManager(const Common::Path &defaultSavepath) {
+DefaultSaveFileManager::DefaultSaveFileManager(const Common::Path &defaultSavepath) : _pendingSavesError(Common::kNoError), _pollObserverInstalled(false) {
 	ConfMan.registerDefault("savepath", defaultSavepath);
 }
 
+DefaultSaveFileManager::~DefaultSaveFileManager() {
+	// Depending on the backend, the event manager may already be gone here.
+	Common::EventManager *eventMan = g_system->getEventManager();
+	if (_pollObserverInstalled && eventMan)
+		eventMan->getEventDispatcher()->unregisterObserver(this);
+
+	// Anything still queued is written out synchronously.
+	handlePendingSaves();
+}
+
 
 void DefaultSaveFileManager::checkPath(const Common::FSNode &dir) {
 	clearError();
@@ -92,6 +165,10 @@ Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &filename) {
+	// Make sure a save still queued for writing is on disk.
+	if (hasPendingSaves() && !waitForPendingSaves())
+		return nullptr;
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -108,6 +185,10 @@ Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &fi
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String &filename) {
+	// Make sure a save still queued for writing is on disk.
+	if (hasPendingSaves() && !waitForPendingSaves())
+		return nullptr;
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -163,11 +244,22 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 		fileNode = file->_value;
 	}
 
+	// A save of the same file still queued would be written to the same temporary file
+	if (hasPendingSave(filename))
+		handlePendingSaves();
+
 	// Open the file for saving.
 	Common::SeekableWriteStream *const sf = fileNode.createWriteStream();
 	if (!sf)
 		return nullptr;
-	Common::OutSaveFile *const result = new Common::OutSaveFile(compress ? Common::wrapCompressedWriteStream(sf) : sf);
+
+	Common::OutSaveFile *result;
+	if (ConfMan.getBool("async_saves")) {
+		// Serialize into memory, compression and writing are deferred to the event loop.
+		result = new Common::OutSaveFile(new AsyncSaveWriteStream(this, filename, compress ? Common::wrapCompressedWriteStream(sf) : sf));
+	} else {
+		result = new Common::OutSaveFile(compress ? Common::wrapCompressedWriteStream(sf) : sf);
+	}
 
 	// Add file to cache now that it exists.
 	_saveFileCache[filename] = Common::FSNode(fileNode.getPath());
@@ -176,6 +268,10 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 }
 
 bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
+	// Do not let a queued save recreate the file after it was removed.
+	if (hasPendingSaves())
+		waitForPendingSaves();
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -221,6 +317,115 @@ Common::ErrorCode DefaultSaveFileManager::removeFile(const Common::FSNode &fileN
 	return Common::kUnknownError;
 }
 
+void DefaultSaveFileManager::queueAsyncSave(const Common::String &filename, Common::WriteStream *file, byte *data, uint32 size) {
+	PendingSave save;
+	save.filename = filename;
+	save.file = file;
+	save.data = data;
+	save.size = size;
+	save.written = 0;
+
+	{
+		Common::StackLock lock(_pendingSavesMutex);
+		_pendingSaves.push_back(save);
+	}
+
+	// The queue is drained from pollEvent(). Observers can't be removed while
+	// polls are dispatched, so once installed the observer stays until we die.
+	if (!_pollObserverInstalled) {
+		Common::EventManager *eventMan = g_system->getEventManager();
+		if (!eventMan) {
+			handlePendingSaves();
+			return;
+		}
+		eventMan->getEventDispatcher()->registerObserver(this, 0, false, true);
+		_pollObserverInstalled = true;
+	}
+}
+
+void DefaultSaveFileManager::notifyPoll() {
+	// Only compress and write a chunk per poll, so that a large save
+	// doesn't stall a single frame.
+	writePendingSaves(kPendingSaveChunkSize);
+}
+
+bool DefaultSaveFileManager::writePendingSaves(uint32 maxSize) {
+	// Only the engine thread writes saves, the lock guards against saves
+	// queued from other threads
+	PendingSave *save;
+	{
+		Common::StackLock lock(_pendingSavesMutex);
+		if (_pendingSaves.empty())
+			return false;
+		save = &_pendingSaves.front();
+	}
+
+	const uint32 size = MIN(maxSize, save->size - save->written);
+	save->file->write(save->data + save->written, size);
+	save->written += size;
+	if (save->written < save->size && !save->file->err())
+		return true;
+
+	// Closing the file moves it over the previous save
+	save->file->finalize();
+	const bool failed = save->file->err();
+	delete save->file;
+	free(save->data);
+
+	Common::StackLock lock(_pendingSavesMutex);
+	if (failed) {
+		const Common::String errorDesc = Common::String::format("Failed to write savefile '%s'", save->filename.c_str());
+		warning("DefaultSaveFileManager: %s", errorDesc.c_str());
+
+		if (_pendingSavesError == Common::kNoError) {
+			_pendingSavesError = Common::kWritingFailed;
+			_pendingSavesErrorDesc = errorDesc;
+		}
+	}
+	_pendingSaves.pop_front();
+	return true;
+}
+
+bool DefaultSaveFileManager::hasPendingSave(const Common::String &filename) {
+	Common::StackLock lock(_pendingSavesMutex);
+	for (const auto &save : _pendingSaves) {
+		if (save.filename.equalsIgnoreCase(filename))
+			return true;
+	}
+	return false;
+}
+
+Common::ErrorCode DefaultSaveFileManager::takePendingSavesError(Common::String &errorDesc) {
+	Common::StackLock lock(_pendingSavesMutex);
+	Common::ErrorCode error = _pendingSavesError;
+	errorDesc = _pendingSavesErrorDesc;
+	_pendingSavesError = Common::kNoError;
+	_pendingSavesErrorDesc.clear();
+	return error;
+}
+
+void DefaultSaveFileManager::handlePendingSaves() {
+	while (writePendingSaves(0xFFFFFFFF))
+		;
+}
+
+bool DefaultSaveFileManager::hasPendingSaves() {
+	Common::StackLock lock(_pendingSavesMutex);
+	return !_pendingSaves.empty();
+}
+
+bool DefaultSaveFileManager::waitForPendingSaves() {
+	handlePendingSaves();
+
+	Common::String errorDesc;
+	Common::ErrorCode error = takePendingSavesError(errorDesc);
+	if (error != Common::kNoError) {
+		setError(error, errorDesc);
+		return false;
+	}
+	return true;
+}
+
 bool DefaultSaveFileManager::exists(const Common::String &filename) {
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
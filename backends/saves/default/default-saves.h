@@ -27,14 +27,18 @@
 #include "common/str.h"
 #include "common/fs.h"
 #include "common/hash-str.h"
+#include "common/mutex.h"
+#include "common/list.h"
+#include "common/events.h"
 
 /**
  * Provides a default savefile manager implementation for common platforms.
  */
-class DefaultSaveFileManager : public Common::SaveFileManager {
+class DefaultSaveFileManager : public Common::SaveFileManager, public Common::EventObserver {
 public:
 	DefaultSaveFileManager();
 	DefaultSaveFileManager(const Common::Path &defaultSavepath);
+	virtual ~DefaultSaveFileManager();
 
 	void updateSavefilesList(Common::StringArray &lockedFiles) override;
 	Common::StringArray listSavefiles(const Common::String &pattern) override;
@@ -43,6 +47,31 @@ public:
 	Common::OutSaveFile *openForSaving(const Common::String &filename, bool compress = true) override;
 	bool removeSavefile(const Common::String &filename) override;
 	bool exists(const Common::String &filename) override;
+	bool waitForPendingSaves() override;
+
+	/**
+	 * Queue a serialized save file for writing from the event loop.
+	 * Takes ownership of @p file, the opened save file, and of @p data,
+	 * which must have been allocated with malloc(). This is called by the
+	 * streams returned from openForSaving() when the "async_saves" option
+	 * is enabled.
+	 */
+	void queueAsyncSave(const Common::String &filename, Common::WriteStream *file, byte *data, uint32 size);
+
+	/**
+	 * Return and clear the first error raised by the deferred writer.
+	 */
+	Common::ErrorCode takePendingSavesError(Common::String &errorDesc);
+
+	/**
+	 * Write out all queued saves synchronously. Called from
+	 * waitForPendingSaves() and on destruction.
+	 */
+	void handlePendingSaves();
+
+	// EventObserver API, writes out a chunk of the oldest queued save
+	bool notifyEvent(const Common::Event &event) override { return false; }
+	void notifyPoll() override;
 
 #ifdef USE_LIBCURL
 
@@ -100,6 +129,38 @@ protected:
 	Common::StringArray _lockedFiles;
 
 private:
+	/** How much of a queued save is written per poll. */
+	static const uint32 kPendingSaveChunkSize = 64 * 1024;
+
+	struct PendingSave {
+		Common::String filename;
+		Common::WriteStream *file;
+		byte *data;
+		uint32 size;
+		uint32 written;
+	};
+
+	/**
+	 * Saves waiting to be written from the event loop. Protected by
+	 * _pendingSavesMutex.
+	 */
+	Common::List<PendingSave> _pendingSaves;
+	Common::Mutex _pendingSavesMutex;
+
+	/** First error raised by the deferred writer since the last wait. */
+	Common::ErrorCode _pendingSavesError;
+	Common::String _pendingSavesErrorDesc;
+	bool _pollObserverInstalled;
+
+	bool hasPendingSaves();
+	bool hasPendingSave(const Common::String &filename);
+
+	/**
+	 * Write up to @p maxSize bytes of the oldest queued save, and close it
+	 * once it is complete. Returns false if no save was queued.
+	 */
+	bool writePendingSaves(uint32 maxSize);
+
 	/**
 	 * The currently cached directory.
 	 */
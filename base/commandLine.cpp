@@ -347,6 +347,7 @@ void registerDefaults() {
 	ConfMan.registerDefault("dump_scripts", false);
 	ConfMan.registerDefault("save_slot", -1);
 	ConfMan.registerDefault("autosave_period", 5 * 60); // By default, trigger autosave every 5 minutes
+	ConfMan.registerDefault("async_saves", false); // Defer compressing and writing saves to the event loop
 	ConfMan.registerDefault("engine_speed", 60); // FPS limit for 3D games
 
 #if defined(ENABLE_SCUMM) || defined(ENABLE_SWORD2)
@@ -1061,11 +1062,10 @@ static void listGames(const Common::String &engineID) {
 	printf("Game ID                        Full Title                                                 \n"
 	       "------------------------------ -----------------------------------------------------------\n");
 
-	const PluginList &plugins = EngineMan.getPlugins(PLUGIN_TYPE_ENGINE);
-	for (const auto &plugin : plugins) {
-		const Plugin *p = EngineMan.findDetectionPlugin(plugin->getName());
-		/* If for some reason, we can't find the MetaEngineDetection for this Engine, just ignore it */
-		if (!p) {
+	const PluginList &plugins = EngineMan.getPlugins(PLUGIN_TYPE_ENGINE_DETECTION);
+	for (const auto &p : plugins) {
+		/* Only list engines which are actually available, without loading their plugins if possible */
+		if (!PluginMan.hasEnginePlugin(p->get<MetaEngineDetection>().getName())) {
 			continue;
 		}
 
@@ -1108,11 +1108,10 @@ static void listEngines() {
 	printf("Engine ID       Engine Name                                           \n"
 	       "--------------- ------------------------------------------------------\n");
 
-	const PluginList &plugins = EngineMan.getPlugins(PLUGIN_TYPE_ENGINE);
-	for (const auto &plugin : plugins) {
-		const Plugin *p = EngineMan.findDetectionPlugin(plugin->getName());
-		/* If for some reason, we can't find the MetaEngineDetection for this Engine, just ignore it */
-		if (!p) {
+	const PluginList &plugins = EngineMan.getPlugins(PLUGIN_TYPE_ENGINE_DETECTION);
+	for (const auto &p : plugins) {
+		/* Only list engines which are actually available, without loading their plugins if possible */
+		if (!PluginMan.hasEnginePlugin(p->get<MetaEngineDetection>().getName())) {
 			continue;
 		}
 
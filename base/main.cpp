@@ -318,6 +318,10 @@ static Common::Error runGame(const Plugin *enginePlugin, OSystem &system, const
 	// Run the engine
 	Common::Error result = engine->run();
 
+	// Make sure saves still being written in the background reach the disk
+	if (!system.getSavefileManager()->waitForPendingSaves())
+		warning("Failed to write saved game: %s", system.getSavefileManager()->popErrorDesc().c_str());
+
 	// Make sure we do not return to the launcher if this is not possible.
 	if (!engine->hasFeature(Engine::kSupportsReturnToLauncher))
 		ConfMan.setBool("gui_return_to_launcher_at_exit", false, Common::ConfigManager::kTransientDomain);
@@ -25,10 +25,8 @@
 #include "common/debug.h"
 #include "common/debug-channels.h"
 #include "common/config-manager.h"
-
-#ifdef DYNAMIC_MODULES
 #include "common/fs.h"
-#endif
+#include "common/stream.h"
 
 #include "base/detection/detection.h"
 
@@ -349,6 +347,8 @@ void PluginManagerUncached::init() {
 			}
  		}
  	}
+
+	validatePluginManifest();
 }
 
 /**
@@ -410,14 +410,8 @@ bool PluginManagerUncached::loadPluginByFileName(const Common::Path &filename) {
 void PluginManagerUncached::updateConfigWithFileName(const Common::String &engineId) {
 	// Check if we have a filename for the current plugin
 	if (!(*_currentPlugin)->getFileName().empty()) {
-		if (!ConfMan.hasMiscDomain("engine_plugin_files"))
-			ConfMan.addMiscDomain("engine_plugin_files");
-
-		Common::ConfigManager::Domain *domain = ConfMan.getDomain("engine_plugin_files");
-		assert(domain);
-		(*domain).setVal(engineId, (*_currentPlugin)->getFileName().toConfig());
-
-		ConfMan.flushToDisk();
+		addToPluginManifest(engineId, (*_currentPlugin)->getFileName());
+		flushPluginManifest();
 	}
 }
 
@@ -470,6 +464,7 @@ void PluginManagerUncached::loadFirstPlugin() {
 	for (_currentPlugin = _allEnginePlugins.begin(); _currentPlugin != _allEnginePlugins.end(); ++_currentPlugin) {
 		if ((*_currentPlugin)->loadPlugin()) {
 			addToPluginsInMemList(*_currentPlugin);
+			addToPluginManifest(*_currentPlugin);
 			break;
 		}
 	}
@@ -484,9 +479,13 @@ bool PluginManagerUncached::loadNextPlugin() {
 	for (++_currentPlugin; _currentPlugin != _allEnginePlugins.end(); ++_currentPlugin) {
 		if ((*_currentPlugin)->loadPlugin()) {
 			addToPluginsInMemList(*_currentPlugin);
+			addToPluginManifest(*_currentPlugin);
 			return true;
 		}
 	}
+
+	// We went through all the plugins, remember what we learned about them
+	flushPluginManifest();
 	return false; // no more in list
 }
 
@@ -807,6 +806,151 @@ const Plugin *PluginManager::findEnginePlugin(const Common::String &engineId) {
 	return nullptr;
 }
 
+bool PluginManager::hasEnginePlugin(const Common::String &engineId) {
+	return findLoadedPlugin(engineId) != nullptr;
+}
+
+/**
+ * Return a stamp identifying the current version of a plugin file. It holds
+ * the size and, where the backend provides it, the modification time, so that
+ * a rebuilt plugin of the same size is noticed as well.
+ **/
+static Common::String getPluginFileStamp(const Common::Path &filename) {
+	Common::FSNode node(filename);
+	Common::SeekableReadStream *stream = node.createReadStream();
+	if (!stream)
+		return Common::String();
+
+	Common::String stamp = Common::String::format("%u", (uint32)stream->size());
+	delete stream;
+
+	int64 modificationTime;
+	if (node.getModificationTime(modificationTime))
+		stamp += Common::String::format(":%lld", (long long)modificationTime);
+	return stamp;
+}
+
+/**
+ * Drop the manifest entries of plugin files which disappeared or changed since
+ * they were recorded. They are added again the next time the plugin is loaded.
+ **/
+void PluginManagerUncached::validatePluginManifest() {
+	Common::ConfigManager::Domain *files = ConfMan.getDomain("engine_plugin_files");
+	if (!files)
+		return;
+
+	const Common::ConfigManager::Domain *stamps = ConfMan.getDomain("engine_plugin_stamps");
+
+	Common::StringArray staleEngines;
+	for (const auto &entry : *files) {
+		const Common::Path filename(Common::Path::fromConfig(entry._value));
+
+		bool found = false;
+		for (const auto *enginePlugin : _allEnginePlugins) {
+			if (enginePlugin->getFileName() == filename) {
+				found = true;
+				break;
+			}
+		}
+
+		if (!found || !stamps || !stamps->contains(entry._key) || (*stamps)[entry._key] != getPluginFileStamp(filename))
+			staleEngines.push_back(entry._key);
+	}
+
+	for (const auto &engineId : staleEngines) {
+		debug(9, "Plugin of engine '%s' changed, removing it from the manifest", engineId.c_str());
+		files->erase(engineId);
+		if (stamps)
+			ConfMan.getDomain("engine_plugin_stamps")->erase(engineId);
+		_isManifestDirty = true;
+	}
+
+	flushPluginManifest();
+}
+
+void PluginManagerUncached::addToPluginManifest(const Plugin *plugin) {
+	if (plugin->getType() != PLUGIN_TYPE_ENGINE || plugin->getFileName().empty())
+		return;
+
+	addToPluginManifest(plugin->get<MetaEngine>().getName(), plugin->getFileName());
+}
+
+void PluginManagerUncached::addToPluginManifest(const Common::String &engineId, const Common::Path &filename) {
+	if (!ConfMan.hasMiscDomain("engine_plugin_files"))
+		ConfMan.addMiscDomain("engine_plugin_files");
+	if (!ConfMan.hasMiscDomain("engine_plugin_stamps"))
+		ConfMan.addMiscDomain("engine_plugin_stamps");
+
+	Common::ConfigManager::Domain *files = ConfMan.getDomain("engine_plugin_files");
+	Common::ConfigManager::Domain *stamps = ConfMan.getDomain("engine_plugin_stamps");
+	assert(files && stamps);
+
+	const Common::String file = filename.toConfig();
+	const Common::String stamp = getPluginFileStamp(filename);
+	if (files->getValOrDefault(engineId) == file && stamps->getValOrDefault(engineId) == stamp)
+		return;
+
+	files->setVal(engineId, file);
+	stamps->setVal(engineId, stamp);
+	_isManifestDirty = true;
+}
+
+void PluginManagerUncached::flushPluginManifest() {
+	if (!_isManifestDirty)
+		return;
+
+	ConfMan.flushToDisk();
+	_isManifestDirty = false;
+}
+
+/**
+ * Make sure every plugin file is recorded in the manifest. Only plugins which
+ * are not in it yet get loaded, so this is free once the manifest is complete.
+ **/
+void PluginManagerUncached::updatePluginManifest() {
+	if (_isManifestComplete)
+		return;
+
+	const Common::ConfigManager::Domain *files = ConfMan.getDomain("engine_plugin_files");
+	Common::HashMap<Common::String, bool> knownFiles;
+	if (files) {
+		for (const auto &entry : *files)
+			knownFiles[entry._value] = true;
+	}
+
+	for (auto *enginePlugin : _allEnginePlugins) {
+		const Common::Path filename = enginePlugin->getFileName();
+		if (filename.empty() || knownFiles.contains(filename.toConfig()))
+			continue;
+
+		// Do not unload a plugin which is in use
+		if (Common::find(_pluginsInMem[PLUGIN_TYPE_ENGINE].begin(), _pluginsInMem[PLUGIN_TYPE_ENGINE].end(), enginePlugin) != _pluginsInMem[PLUGIN_TYPE_ENGINE].end()) {
+			addToPluginManifest(enginePlugin);
+		} else if (enginePlugin->loadPlugin()) {
+			addToPluginManifest(enginePlugin);
+			enginePlugin->unloadPlugin();
+		}
+	}
+
+	flushPluginManifest();
+	_isManifestComplete = true;
+}
+
+bool PluginManagerUncached::hasEnginePlugin(const Common::String &engineId) {
+	updatePluginManifest();
+
+	const Common::ConfigManager::Domain *files = ConfMan.getDomain("engine_plugin_files");
+	if (files && files->contains(engineId))
+		return true;
+
+	// Static engine plugins always stay in memory
+	for (const auto *enginePlugin : _allEnginePlugins) {
+		if (enginePlugin->getFileName().empty() && engineId == enginePlugin->get<MetaEngine>().getName())
+			return true;
+	}
+	return false;
+}
+
 QualifiedGameDescriptor EngineManager::findTarget(const Common::String &target) const {
 	// Ignore empty targets
 	if (target.empty())
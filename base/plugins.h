@@ -315,6 +315,14 @@ public:
 	 */
 	const Plugin *findEnginePlugin(const Common::String &engineId);
 
+	/**
+	 * Check whether an engine plugin is available for the provided engineId,
+	 * without loading it if it can be avoided.
+	 *
+	 * @param engineId The engine ID
+	 */
+	virtual bool hasEnginePlugin(const Common::String &engineId);
+
 	// Functions used by the uncached PluginManager
 	virtual void init()	{}
 	virtual void loadFirstPlugin() {}
@@ -346,9 +354,25 @@ protected:
 
 	bool _isDetectionLoaded;
 
-	PluginManagerUncached() : _detectionPlugin(nullptr), _currentPlugin(nullptr), _isDetectionLoaded(false) {}
+	/**
+	 * The plugin manifest maps engine IDs to their plugin file and a stamp of
+	 * that file, so that engines can be found without loading every plugin.
+	 * It is stored in the 'engine_plugin_files' and 'engine_plugin_stamps'
+	 * domains of the configuration file.
+	 */
+	bool _isManifestDirty;
+	bool _isManifestComplete;
+
+	PluginManagerUncached() : _detectionPlugin(nullptr), _currentPlugin(nullptr), _isDetectionLoaded(false),
+		_isManifestDirty(false), _isManifestComplete(false) {}
 	bool loadPluginByFileName(const Common::Path &filename);
 
+	void validatePluginManifest();
+	void updatePluginManifest();
+	void addToPluginManifest(const Plugin *plugin);
+	void addToPluginManifest(const Common::String &engineId, const Common::Path &filename);
+	void flushPluginManifest();
+
 public:
 	virtual ~PluginManagerUncached();
 	void init() override;
@@ -356,6 +380,7 @@ public:
 	bool loadNextPlugin() override;
 	bool loadPluginFromEngineId(const Common::String &engineId) override;
 	void updateConfigWithFileName(const Common::String &engineId) override;
+	bool hasEnginePlugin(const Common::String &engineId) override;
 #ifndef DETECTION_STATIC
 	void loadDetectionPlugin() override;
 	void unloadDetectionPlugin() override;
@@ -23,6 +23,7 @@
 #include "common/archive.h"
 #include "common/fs.h"
 #include "common/memstream.h"
+#include "common/stream.h"
 #include "common/system.h"
 
 namespace Common {
@@ -78,6 +79,13 @@ void XMLParser::close() {
 bool XMLParser::parserError(const String &errStr) {
 	_state = kParserError;
 
+	// A compiled document has no text to point at
+	if (_parsingCompiled || !_stream) {
+		Common::String errorMessage = Common::String::format("\n  File <%s>:\n\nParser error: %s\n\n", _fileName.toString().c_str(), errStr.c_str());
+		g_system->logMessage(LogMessageType::kError, errorMessage.c_str());
+		return false;
+	}
+
 	const int startPosition = _stream->pos();
 	int currentPosition = startPosition;
 	int lineCount = 1;
@@ -351,6 +359,10 @@ bool XMLParser::parse() {
 						parserError("Unexpected end of file.");
 						break;
 					}
+					if (_compiledOut) {
+						_compiledOut->writeByte(kCompiledText);
+						writeCompiledString(text);
+					}
 					if (!textCallback(text)) {
 						parserError("Failed to process text segment.");
 						break;
@@ -411,6 +423,9 @@ bool XMLParser::parse() {
 
 		case kParserNeedPropertyName:
 			if (activeClosure) {
+				if (_compiledOut)
+					_compiledOut->writeByte(kCompiledClosure);
+
 				if (!closeKey()) {
 					parserError("Missing data when closing key '" + _activeKey.top()->name + "'.");
 					break;
@@ -437,7 +452,22 @@ bool XMLParser::parse() {
 			if (_char == '>') {
 				if (activeHeader && !selfClosure) {
 					parserError("XML Header must be self-closed.");
-				} else if (parseActiveKey(selfClosure)) {
+					break;
+				}
+
+				if (_compiledOut) {
+					const ParserNode *node = _activeKey.top();
+					_compiledOut->writeByte(kCompiledKey);
+					_compiledOut->writeByte((node->header ? 1 : 0) | (selfClosure ? 2 : 0));
+					writeCompiledString(node->name);
+					_compiledOut->writeUint16LE(node->values.size());
+					for (const auto &value : node->values) {
+						writeCompiledString(value._key);
+						writeCompiledString(value._value);
+					}
+				}
+
+				if (parseActiveKey(selfClosure)) {
 					_char = _stream->readByte();
 					_state = kParserNeedKey;
 				}
@@ -486,6 +516,110 @@ bool XMLParser::parse() {
 	return true;
 }
 
+bool XMLParser::parseCompiled(SeekableReadStream *stream, const String &name) {
+	if (stream == nullptr)
+		return false;
+
+	if (_XMLkeys == nullptr)
+		buildLayout();
+
+	while (!_activeKey.empty())
+		freeNode(_activeKey.pop());
+
+	cleanup();
+
+	_fileName = name;
+	_parsingCompiled = true;
+	_state = kParserNeedKey;
+
+	while (_state != kParserError) {
+		byte record = stream->readByte();
+		if (stream->eos())
+			break;
+
+		switch (record) {
+		case kCompiledKey: {
+			byte flags = stream->readByte();
+
+			ParserNode *node = allocNode();
+			node->name = readCompiledString(stream);
+			node->ignore = false;
+			node->header = (flags & 1) != 0;
+			node->depth = _activeKey.size();
+			node->layout = nullptr;
+			_activeKey.push(node);
+
+			uint16 count = stream->readUint16LE();
+			while (count--) {
+				String key = readCompiledString(stream);
+				node->values[key] = readCompiledString(stream);
+			}
+
+			if (stream->eos() || stream->err()) {
+				parserError("Truncated compiled key.");
+				break;
+			}
+
+			// Self closed keys are closed right away, and closing may fail without an error set
+			String keyName = node->name;
+			if (!parseActiveKey((flags & 2) != 0) && _state != kParserError)
+				parserError("Failed to process key '" + keyName + "'.");
+			break;
+		}
+
+		case kCompiledClosure:
+			if (_activeKey.empty()) {
+				parserError("Unexpected closure.");
+			} else {
+				String keyName = _activeKey.top()->name;
+				if (!closeKey())
+					parserError("Missing data when closing key '" + keyName + "'.");
+			}
+			break;
+
+		case kCompiledText:
+			if (!_allowText || !textCallback(readCompiledString(stream)))
+				parserError("Failed to process text segment.");
+			break;
+
+		default:
+			parserError("Invalid compiled record.");
+			break;
+		}
+	}
+
+	_parsingCompiled = false;
+
+	if (_state == kParserError)
+		return false;
+
+	if (!_activeKey.empty())
+		return parserError("Unexpected end of file.");
+
+	return true;
+}
+
+void XMLParser::writeCompiledString(const String &str) {
+	_compiledOut->writeUint32LE(str.size());
+	_compiledOut->writeString(str);
+}
+
+String XMLParser::readCompiledString(SeekableReadStream *stream) {
+	uint32 size = stream->readUint32LE();
+	if (size > (uint32)(stream->size() - stream->pos()))
+		return String();
+
+	String str;
+	char buf[256];
+	while (size > 0) {
+		uint32 chunk = MIN<uint32>(size, sizeof(buf));
+		stream->read(buf, chunk);
+		str += String(buf, chunk);
+		size -= chunk;
+	}
+	return str;
+}
+
 bool XMLParser::skipSpaces() {
 	if (!isSpace(_char))
 		return false;
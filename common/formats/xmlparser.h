@@ -45,6 +45,7 @@ namespace Common {
  */
 
 class SeekableReadStream;
+class WriteStream;
 
 #define MAX_XML_DEPTH 8
 
@@ -100,7 +101,7 @@ public:
 	/**
 	 * Parser constructor.
 	 */
-	XMLParser() : _XMLkeys(nullptr), _stream(nullptr), _allowText(false), _char(0) {}
+	XMLParser() : _XMLkeys(nullptr), _stream(nullptr), _allowText(false), _char(0), _compiledOut(nullptr), _parsingCompiled(false) {}
 
 	virtual ~XMLParser();
 
@@ -195,6 +196,24 @@ public:
 	 */
 	bool parse();
 
+	/**
+	 * Records every key, key closure and text node parsed from now on into
+	 * the given stream, in a compact binary form which can be fed to
+	 * parseCompiled() later. Pass nullptr to stop recording.
+	 * The stream is not owned by the parser.
+	 */
+	void setCompiledOutput(WriteStream *out) {
+		_compiledOut = out;
+	}
+
+	/**
+	 * Parses a document previously recorded with setCompiledOutput().
+	 * The same callbacks are issued as when parsing the original XML, but
+	 * the text does not need to be tokenized again.
+	 * Returns true if successful. The stream is not owned by the parser.
+	 */
+	bool parseCompiled(SeekableReadStream *stream, const String &name = "Compiled Stream");
+
 	/**
 	 * Returns the active node being parsed (the one on top of
 	 * the node stack).
@@ -385,6 +404,19 @@ private:
 	String _token; /** Current text token */
 
 	Stack<ParserNode *> _activeKey; /** Node stack of the parsed keys */
+
+	/** Record types of the compiled form, see setCompiledOutput() */
+	enum CompiledRecord {
+		kCompiledKey = 1,
+		kCompiledClosure = 2,
+		kCompiledText = 3
+	};
+
+	WriteStream *_compiledOut; /** Stream receiving the compiled form of the document */
+	bool _parsingCompiled; /** Set while parsing a compiled document */
+
+	void writeCompiledString(const String &str);
+	String readCompiledString(SeekableReadStream *stream);
 };
 
 /** @} */
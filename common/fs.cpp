@@ -263,6 +263,13 @@ SeekableReadStream *FSNode::createReadStreamForAltStream(AltStreamType altStream
 	return _realNode->createReadStreamForAltStream(altStreamType);
 }
 
+bool FSNode::getModificationTime(int64 &time) const {
+	if (_realNode == nullptr || !_realNode->exists())
+		return false;
+
+	return _realNode->getModificationTime(time);
+}
+
 SeekableWriteStream *FSNode::createWriteStream(bool atomic) const {
 	if (_realNode == nullptr)
 		return nullptr;
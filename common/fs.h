@@ -271,6 +271,15 @@ public:
 	 */
 	SeekableReadStream *createReadStreamForAltStream(AltStreamType altStreamType) const override;
 
+	/**
+	 * Get the time the object referred by this node was last modified, in
+	 * seconds. It is only meant to tell whether the file changed, and not
+	 * every backend provides it.
+	 *
+	 * @return True if the modification time is known, false otherwise.
+	 */
+	bool getModificationTime(int64 &time) const;
+
 	/**
 	 * Create a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
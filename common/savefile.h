@@ -276,6 +276,18 @@ public:
 	 * @return true if the file exists. false otherwise.
 	 */
 	virtual bool exists(const String &name) = 0;
+
+	/**
+	 * Block until all save files queued for writing in the background have
+	 * been committed to storage. Managers that write synchronously return
+	 * immediately.
+	 *
+	 * If a background save failed, the error is reported via getError()
+	 * and getErrorDesc() once this returns.
+	 *
+	 * @return True if all pending saves were written, false otherwise.
+	 */
+	virtual bool waitForPendingSaves() { return true; }
 };
 
 /** @} */
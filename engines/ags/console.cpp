@@ -35,6 +35,7 @@ AGSConsole::AGSConsole(AGSEngine *vm) : GUI::Debugger(), _vm(vm), _logOutputTarg
 	registerCmd("ags_set_script_dump", WRAP_METHOD(AGSConsole, Cmd_SetScriptDump));
 	registerCmd("ags_sprite_info",   WRAP_METHOD(AGSConsole, Cmd_getSpriteInfo));
 	registerCmd("ags_sprite_dump",  WRAP_METHOD(AGSConsole, Cmd_dumpSprite));
+	registerCmd("ags_sprite_cache",  WRAP_METHOD(AGSConsole, Cmd_spriteCacheStats));
 
 	_logOutputTarget = new LogOutputTarget();
 	_agsDebuggerOutput = _GP(DbgMgr).RegisterOutput("ScummVMLog", _logOutputTarget, AGS3::AGS::Shared::kDbgMsg_None);
@@ -244,6 +245,24 @@ bool AGSConsole::Cmd_dumpSprite(int argc, const char **argv) {
 	return true;
 }
 
+bool AGSConsole::Cmd_spriteCacheStats(int argc, const char **argv) {
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "reset") != 0)) {
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	const AGS3::AGS::Shared::SpriteCache::Stats &stats = _GP(spriteset).GetStats();
+	debugPrintf("Size: %u KB of %u KB (%u KB locked)\n",
+		(uint)(_GP(spriteset).GetCacheSize() / 1024), (uint)(_GP(spriteset).GetMaxCacheSize() / 1024),
+		(uint)(_GP(spriteset).GetLockedSize() / 1024));
+	debugPrintf("Hits: %u, misses: %u, evictions: %u, prefetched: %u\n",
+		stats.Hits, stats.Misses, stats.Evictions, stats.Prefetched);
+
+	if (argc == 2)
+		_GP(spriteset).ResetStats();
+	return true;
+}
+
 LogOutputTarget::LogOutputTarget() {
 }
 
@@ -2080,6 +2080,7 @@ void animate_character(CharacterInfo *chap, int loopn, int sppd, int rept, int d
 
 	chap->wait = sppd + _GP(views)[chap->view].loops[loopn].frames[chap->frame].speed;
 	_GP(charextra)[chap->index_id].cur_anim_volume = Math::Clamp(volume, 0, 100);
+	prefetch_view_loop(chap->view, loopn);
 
 	_GP(charextra)[chap->index_id].CheckViewFrame(chap);
 }
@@ -632,6 +632,13 @@ void reset_drawobj_for_overlay(int objnum) {
 	}
 }
 
+// Tells the renderer that something was drawn outside of its draw lists;
+// unlike the sprites' own invalid rects, this means the frame has changed
+static void notify_content_changed() {
+	if (_G(gfxDriver))
+		_G(gfxDriver)->InvalidateContent();
+}
+
 void notify_sprite_changed(int sprnum, bool deleted) {
 	assert(sprnum >= 0 && sprnum < (int)_GP(game).SpriteInfos.size());
 
@@ -647,6 +654,8 @@ void notify_sprite_changed(int sprnum, bool deleted) {
 		*it_notify->_value = UINT32_MAX;
 		_G(drawstate).SpriteNotifyMap.erase(sprnum);
 	}
+	// the sprite's bitmap may be drawn by the renderer as is
+	notify_content_changed();
 }
 
 void mark_screen_dirty() {
@@ -659,14 +668,17 @@ bool is_screen_dirty() {
 
 void invalidate_screen() {
 	invalidate_all_rects();
+	notify_content_changed();
 }
 
 void invalidate_camera_frame(int index) {
 	invalidate_all_camera_rects(index);
+	notify_content_changed();
 }
 
 void invalidate_rect(int x1, int y1, int x2, int y2, bool in_room) {
 	invalidate_rect_ds(x1, y1, x2, y2, in_room);
+	notify_content_changed();
 }
 
 void invalidate_sprite(int x1, int y1, IDriverDependantBitmap *pic, bool in_room) {
@@ -679,6 +691,7 @@ void invalidate_sprite_glob(int x1, int y1, IDriverDependantBitmap *pic) {
 
 void mark_current_background_dirty() {
 	_G(current_background_is_dirty) = true;
+	notify_content_changed();
 }
 
 
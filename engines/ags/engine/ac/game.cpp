@@ -1388,6 +1388,17 @@ void precache_view(int view, int first_loop, int last_loop, bool with_sounds) {
 	Debug::Printf("\tSprite cache: %zu -> %zu KB", spcache_before / 1024u, spcache_after / 1024u);
 }
 
+void prefetch_view_loop(int view, int loop) {
+	if (view < 0 || view >= _GP(game).numviews)
+		return;
+	if (loop < 0 || loop >= _GP(views)[view].numLoops)
+		return;
+
+	const auto &vloop = _GP(views)[view].loops[loop];
+	for (int i = 0; i < vloop.numFrames; ++i)
+		_GP(spriteset).PrefetchSprite(vloop.frames[i].pic);
+}
+
 
 //=============================================================================
 //
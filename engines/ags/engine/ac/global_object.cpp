@@ -243,6 +243,7 @@ void AnimateObjectImpl(int obn, int loopn, int spdd, int rept, int direction, in
 	if (pic > UINT16_MAX)
 		debug_script_warn("Warning: object's (id %d) sprite %d is outside of internal range (%d), reset to 0", obn, pic, UINT16_MAX);
 	obj.cur_anim_volume = Math::Clamp(volume, 0, 100);
+	prefetch_view_loop(obj.view, loopn);
 
 	_G(objs)[obn].CheckViewFrame();
 
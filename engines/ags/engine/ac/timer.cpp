@@ -24,6 +24,7 @@
 #include "ags/shared/core/platform.h"
 #include "ags/engine/ac/sys_events.h"
 #include "ags/engine/platform/base/ags_platform_driver.h"
+#include "ags/shared/ac/sprite_cache.h"
 #include "ags/ags.h"
 #include "ags/globals.h"
 
@@ -80,8 +81,16 @@ void WaitForNextFrame() {
 	}
 
 	if (_G(next_frame_timestamp) > now) {
-		auto frame_time_remaining = _G(next_frame_timestamp) - now;
-		std::this_thread::sleep_for(frame_time_remaining);
+		// Use the spare time to load sprites that are going to be needed soon
+		const int64_t spare_ms = ToMilliseconds(_G(next_frame_timestamp) - now);
+		if (spare_ms > 1)
+			_GP(spriteset).ProcessPrefetch(spare_ms - 1);
+
+		const auto after_prefetch = AGS_Clock::now();
+		if (_G(next_frame_timestamp) > after_prefetch) {
+			auto frame_time_remaining = _G(next_frame_timestamp) - after_prefetch;
+			std::this_thread::sleep_for(frame_time_remaining);
+		}
 	}
 
 	_G(last_tick_time) = _G(next_frame_timestamp);
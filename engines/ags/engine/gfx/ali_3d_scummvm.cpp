@@ -145,6 +145,16 @@ void ScummVMRendererGraphicsDriver::UpdateDeviceScreen(const Size &screen_sz) {
 #endif
 }
 
+void ScummVMRendererGraphicsDriver::InvalidateDeviceScreen() {
+	// The screen no longer holds the last presented frame
+	_frameDiff.Reset();
+	_contentChanged = true;
+}
+
+void ScummVMRendererGraphicsDriver::InvalidateContent() {
+	_contentChanged = true;
+}
+
 void ScummVMRendererGraphicsDriver::CreateVirtualScreen() {
 	if (!IsNativeSizeValid())
 		return;
@@ -159,6 +169,8 @@ void ScummVMRendererGraphicsDriver::CreateVirtualScreen() {
 
 	_lastTexPixels = nullptr;
 	_lastTexPitch = -1;
+	_frameDiff.Reset();
+	_contentChanged = true;
 }
 
 void ScummVMRendererGraphicsDriver::DestroyVirtualScreen() {
@@ -173,6 +185,8 @@ void ScummVMRendererGraphicsDriver::DestroyVirtualScreen() {
 void ScummVMRendererGraphicsDriver::ReleaseDisplayMode() {
 	OnModeReleased();
 	ClearDrawLists();
+	_frameDiff.Reset();
+	_contentChanged = true;
 }
 
 bool ScummVMRendererGraphicsDriver::SetNativeResolution(const GraphicResolution &native_res) {
@@ -246,14 +260,17 @@ int ScummVMRendererGraphicsDriver::GetCompatibleBitmapFormat(int color_depth) {
 }
 
 IDriverDependantBitmap *ScummVMRendererGraphicsDriver::CreateDDB(int width, int height, int color_depth, bool opaque) {
+	_contentChanged = true;
 	return new ALSoftwareBitmap(width, height, color_depth, opaque);
 }
 
 IDriverDependantBitmap *ScummVMRendererGraphicsDriver::CreateDDBFromBitmap(Bitmap *bitmap, bool has_alpha, bool opaque) {
+	_contentChanged = true;
 	return new ALSoftwareBitmap(bitmap, has_alpha, opaque);
 }
 
 IDriverDependantBitmap *ScummVMRendererGraphicsDriver::CreateRenderTargetDDB(int width, int height, int color_depth, bool opaque) {
+	_contentChanged = true;
 	return new ALSoftwareBitmap(width, height, color_depth, opaque);
 }
 
@@ -261,10 +278,13 @@ void ScummVMRendererGraphicsDriver::UpdateDDBFromBitmap(IDriverDependantBitmap *
 	ALSoftwareBitmap *alSwBmp = (ALSoftwareBitmap *)bitmapToUpdate;
 	alSwBmp->_bmp = bitmap;
 	alSwBmp->_hasAlpha = has_alpha;
+	// The bitmap may be the same, but redrawn
+	_contentChanged = true;
 }
 
 void ScummVMRendererGraphicsDriver::DestroyDDB(IDriverDependantBitmap *bitmap) {
 	delete (ALSoftwareBitmap *)bitmap;
+	_contentChanged = true;
 }
 
 void ScummVMRendererGraphicsDriver::InitSpriteBatch(size_t index, const SpriteBatchDesc &desc) {
@@ -501,15 +521,15 @@ size_t ScummVMRendererGraphicsDriver::RenderSpriteBatch(const ALSpriteBatch &bat
 	return from;
 }
 
-void ScummVMRendererGraphicsDriver::copySurface(const Graphics::Surface &src, bool mode) {
+void ScummVMRendererGraphicsDriver::copySurface(const Graphics::Surface &src, const Common::Rect &area, bool mode) {
 	assert(src.w == _screen->w && src.h == _screen->h && src.pitch == _screen->pitch);
-	const uint32 *srcP = (const uint32 *)src.getPixels();
-	uint32 *destP = (uint32 *)_screen->getPixels();
 	uint32 pixel;
 	int x1 = 9999, y1 = 9999, x2 = -1, y2 = -1;
 
-	for (int y = 0; y < src.h; ++y) {
-		for (int x = 0; x < src.w; ++x, ++srcP, ++destP) {
+	for (int y = area.top; y < area.bottom; ++y) {
+		const uint32 *srcP = (const uint32 *)src.getBasePtr(area.left, y);
+		uint32 *destP = (uint32 *)_screen->getBasePtr(area.left, y);
+		for (int x = area.left; x < area.right; ++x, ++srcP, ++destP) {
 			if (!mode) {
 				pixel = (*srcP & 0xff00ff00) |
 					((*srcP & 0xff) << 16) |
@@ -534,6 +554,10 @@ void ScummVMRendererGraphicsDriver::copySurface(const Graphics::Surface &src, bo
 }
 
 void ScummVMRendererGraphicsDriver::Present(int xoff, int yoff, Shared::GraphicFlip flip) {
+	// Fades and other effects present the virtual screen on their own;
+	// Render() restores this flag when presenting a composed frame
+	_contentChanged = true;
+
 	Graphics::Surface *srcTransformed = nullptr;
 	if (xoff != 0 || yoff != 0 || flip != Shared::kFlip_None) {
 		srcTransformed = new Graphics::Surface();
@@ -586,15 +610,25 @@ void ScummVMRendererGraphicsDriver::Present(int xoff, int yoff, Shared::GraphicF
 	if (renderMode != kRenderDirect && !_screen)
 		_screen = new Graphics::Screen();
 
+	// Only the parts of the frame which differ from the last presented one
+	// have to be converted and sent to the screen
+	if (renderMode != _lastRenderMode) {
+		_frameDiff.Reset();
+		_lastRenderMode = renderMode;
+	}
+	const std::vector<Common::Rect> &changed = _frameDiff.Update(src);
+
 	switch (renderMode) {
 	case kRenderToABGR:
 		// ARGB to ABGR
-		copySurface(src, false);
+		for (const auto &r : changed)
+			copySurface(src, r, false);
 		break;
 
 	case kRenderToRGBA:
 		// ARGB to RGBA
-		copySurface(src, true);
+		for (const auto &r : changed)
+			copySurface(src, r, true);
 		break;
 
 	case kRenderOther: {
@@ -603,14 +637,16 @@ void ScummVMRendererGraphicsDriver::Present(int xoff, int yoff, Shared::GraphicF
 		Graphics::Surface srcCopy = src;
 		srcCopy.format.aLoss = 8;
 
-		_screen->blitFrom(srcCopy);
+		for (const auto &r : changed)
+			_screen->blitFrom(srcCopy, r, Common::Point(r.left, r.top));
 		break;
 	}
 
 	case kRenderDirect:
 		// Blit the virtual surface directly to the screen
-		g_system->copyRectToScreen(src.getPixels(), src.pitch,
-			0, 0, src.w, src.h);
+		for (const auto &r : changed)
+			g_system->copyRectToScreen(src.getBasePtr(r.left, r.top), src.pitch,
+				r.left, r.top, r.width(), r.height());
 		g_system->updateScreen();
 		if (srcTransformed) {
 			srcTransformed->free();
@@ -631,9 +667,70 @@ void ScummVMRendererGraphicsDriver::Present(int xoff, int yoff, Shared::GraphicF
 		_screen->update();
 }
 
+bool ScummVMRendererGraphicsDriver::UpdateDrawListState(int xoff, int yoff, GraphicFlip flip) {
+	_drawListState.clear();
+	_drawListState.push_back(xoff);
+	_drawListState.push_back(yoff);
+	_drawListState.push_back(flip);
+	for (size_t i = 0; i < _spriteBatchDesc.size(); ++i) {
+		const auto &batch = _spriteBatches[i];
+		_drawListState.push_back(_spriteBatchDesc[i].Parent);
+		_drawListState.push_back(_spriteBatchRange[i].first);
+		_drawListState.push_back(_spriteBatchRange[i].second);
+		_drawListState.push_back(batch.Viewport.Left);
+		_drawListState.push_back(batch.Viewport.Top);
+		_drawListState.push_back(batch.Viewport.Right);
+		_drawListState.push_back(batch.Viewport.Bottom);
+		_drawListState.push_back(batch.Transform.X);
+		_drawListState.push_back(batch.Transform.Y);
+		_drawListState.push_back((uintptr)batch.Surface.get());
+		_drawListState.push_back(batch.IsParentRegion);
+		_drawListState.push_back(batch.Opaque);
+	}
+
+	bool changed = false;
+	for (const auto &sprite : _spriteList) {
+		_drawListState.push_back(sprite.node);
+		_drawListState.push_back((uintptr)sprite.ddb);
+		_drawListState.push_back(sprite.x);
+		_drawListState.push_back(sprite.y);
+		if (sprite.ddb == nullptr) {
+			// Plugins may draw anything on the stage buffer
+			changed = true;
+		} else if (sprite.ddb == reinterpret_cast<ALSoftwareBitmap *>(DRAWENTRY_TINT)) {
+			_drawListState.push_back(_tint_red);
+			_drawListState.push_back(_tint_green);
+			_drawListState.push_back(_tint_blue);
+		} else {
+			_drawListState.push_back((uintptr)sprite.ddb->_bmp);
+			_drawListState.push_back(sprite.ddb->_alpha);
+			_drawListState.push_back(sprite.ddb->_opaque);
+			_drawListState.push_back(sprite.ddb->_hasAlpha);
+		}
+	}
+
+	changed |= !(_drawListState == _lastDrawListState);
+	_drawListState.swap(_lastDrawListState);
+	return changed;
+}
+
 void ScummVMRendererGraphicsDriver::Render(int xoff, int yoff, GraphicFlip flip) {
+	// The frame is the same as the last one if it is made of the same sprites
+	// in the same batches, and none of their bitmaps were reported changed.
+	// An external back buffer is drawn upon directly, so never assume that.
+	const bool changed = UpdateDrawListState(xoff, yoff, flip) || _contentChanged ||
+		(virtualScreen != _origVirtualScreen.get());
+
+	// Still compose the frame, because the game's invalid regions have already
+	// repainted the room background under the sprites
 	RenderToBackBuffer();
+	if (!changed) {
+		g_system->updateScreen();
+		return;
+	}
+
 	Present(xoff, yoff, flip);
+	_contentChanged = false;
 }
 
 void ScummVMRendererGraphicsDriver::Render() {
@@ -653,6 +750,7 @@ void ScummVMRendererGraphicsDriver::SetMemoryBackBuffer(Bitmap *backBuffer) {
 		virtualScreen = _origVirtualScreen.get();
 	}
 	_stageVirtualScreen = virtualScreen;
+	_contentChanged = true;
 
 	// Reset old virtual screen's subbitmaps;
 	// NOTE: this MUST NOT be called in the midst of the RenderSpriteBatches!
@@ -665,7 +763,8 @@ void ScummVMRendererGraphicsDriver::SetMemoryBackBuffer(Bitmap *backBuffer) {
 	}
 }
 
-Bitmap *ScummVMRendererGraphicsDriver::GetStageBackBuffer(bool /*mark_dirty*/) {
+Bitmap *ScummVMRendererGraphicsDriver::GetStageBackBuffer(bool mark_dirty) {
+	_contentChanged |= mark_dirty;
 	return _stageVirtualScreen;
 }
 
@@ -677,6 +776,7 @@ void ScummVMRendererGraphicsDriver::SetStageBackBuffer(Bitmap *backBuffer) {
 		_stageVirtualScreen = backBuffer;
 	else
 		_stageVirtualScreen = cur_stage;
+	_contentChanged = true;
 }
 
 bool ScummVMRendererGraphicsDriver::GetCopyOfScreenIntoBitmap(Bitmap *destination, const Rect *src_rect, bool at_native_res,
@@ -41,6 +41,7 @@
 #include "ags/engine/gfx/ddb.h"
 #include "ags/engine/gfx/gfx_driver_factory_base.h"
 #include "ags/engine/gfx/gfx_driver_base.h"
+#include "ags/engine/gfx/frame_diff.h"
 
 namespace AGS3 {
 namespace AGS {
@@ -176,6 +177,8 @@ public:
 	void SetTintMethod(TintMethod /*method*/) override;
 	bool SetDisplayMode(const DisplayMode &mode) override;
 	void UpdateDeviceScreen(const Size &screen_sz) override;
+	void InvalidateDeviceScreen() override;
+	void InvalidateContent() override;
 	bool SetNativeResolution(const GraphicResolution &native_res) override;
 	bool SetRenderFrame(const Rect &dst_rect) override;
 	bool IsModeSupported(const DisplayMode &mode) override;
@@ -282,6 +285,15 @@ private:
 	ALSpriteBatches _spriteBatches;
 	// List of sprites to render
 	std::vector<ALDrawListEntry> _spriteList;
+	// Tracks the regions of the virtual screen changed since the last present
+	FrameDiff _frameDiff;
+	int _lastRenderMode = -1;
+	// Description of the draw lists of the last presented frame, and whether
+	// anything they refer to could have changed since; these let skip
+	// comparing and presenting a frame which is the same as the last one
+	std::vector<uintptr> _drawListState;
+	std::vector<uintptr> _lastDrawListState;
+	bool _contentChanged = true;
 
 	void InitSpriteBatch(size_t index, const SpriteBatchDesc &desc) override;
 	void ResetAllBatches() override;
@@ -291,6 +303,9 @@ private:
 	void DestroyVirtualScreen();
 	// Unset parameters and release resources related to the display mode
 	void ReleaseDisplayMode();
+	// Records the state of the current draw lists, returns whether it differs
+	// from the last presented one
+	bool UpdateDrawListState(int xoff, int yoff, Shared::GraphicFlip flip);
 	// Renders single sprite batch on the precreated surface
 	size_t RenderSpriteBatch(const ALSpriteBatch &batch, size_t from, Shared::Bitmap *surface, int surf_offx, int surf_offy);
 
@@ -298,8 +313,8 @@ private:
 	void highcolor_fade_out(Bitmap *vs, void(*draw_callback)(), int speed, int targetColourRed, int targetColourGreen, int targetColourBlue);
 	void __fade_from_range(PALETTE source, PALETTE dest, int speed, int from, int to);
 	void __fade_out_range(int speed, int from, int to, int targetColourRed, int targetColourGreen, int targetColourBlue);
-	// Copy raw screen bitmap pixels to the screen
-	void copySurface(const Graphics::Surface &src, bool mode);
+	// Copy raw screen bitmap pixels within the area to the screen
+	void copySurface(const Graphics::Surface &src, const Common::Rect &area, bool mode);
 	// Render bitmap on screen
 	void Present(int xoff = 0, int yoff = 0, Shared::GraphicFlip flip = Shared::kFlip_None);
 };
@@ -0,0 +1,93 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ags/engine/gfx/frame_diff.h"
+
+namespace AGS3 {
+namespace AGS {
+namespace Engine {
+
+FrameDiff::~FrameDiff() {
+	_last.free();
+}
+
+void FrameDiff::Reset() {
+	_last.free();
+	_rects.clear();
+}
+
+void FrameDiff::AddRect(const Common::Rect &r) {
+	if (!_rects.empty()) {
+		Common::Rect &prev = _rects.back();
+		if (prev.bottom == r.top && prev.left < r.right && r.left < prev.right) {
+			prev.extend(r);
+			return;
+		}
+	}
+	_rects.push_back(r);
+}
+
+const std::vector<Common::Rect> &FrameDiff::Update(const Graphics::Surface &frame) {
+	_rects.clear();
+
+	if (_last.getPixels() == nullptr || _last.w != frame.w || _last.h != frame.h || _last.format != frame.format) {
+		_last.free();
+		_last.copyFrom(frame);
+		_rects.push_back(Common::Rect(frame.w, frame.h));
+		return _rects;
+	}
+
+	const int bpp = frame.format.bytesPerPixel;
+	const int row_size = frame.w * bpp;
+	for (int band_y = 0; band_y < frame.h; band_y += BandHeight) {
+		const int band_end = MIN<int>(band_y + BandHeight, frame.h);
+		int x1 = row_size, x2 = 0, y1 = -1, y2 = -1;
+		for (int y = band_y; y < band_end; ++y) {
+			const byte *cur = (const byte *)frame.getBasePtr(0, y);
+			const byte *old = (const byte *)_last.getBasePtr(0, y);
+			if (memcmp(cur, old, row_size) == 0)
+				continue;
+
+			// Find the changed span in bytes, it's rounded to pixels below
+			int left = 0, right = row_size;
+			while (left < x1 && cur[left] == old[left])
+				++left;
+			while (right > x2 && cur[right - 1] == old[right - 1])
+				--right;
+			x1 = MIN(x1, left);
+			x2 = MAX(x2, right);
+			if (y1 < 0)
+				y1 = y;
+			y2 = y + 1;
+		}
+
+		if (y1 < 0)
+			continue;
+		const Common::Rect r(x1 / bpp, y1, (x2 + bpp - 1) / bpp, y2);
+		_last.copyRectToSurface(frame, r.left, r.top, r);
+		AddRect(r);
+	}
+	return _rects;
+}
+
+} // namespace Engine
+} // namespace AGS
+} // namespace AGS3
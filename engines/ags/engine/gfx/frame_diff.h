@@ -0,0 +1,73 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+//=============================================================================
+//
+// FrameDiff finds out which parts of the rendered frame changed since the
+// last one was presented. The software renderer composes the whole virtual
+// screen each frame, but in most scenes only a few sprites move; sending
+// only the changed regions to the backend saves the copy and the upload of
+// the rest of the screen.
+//
+//=============================================================================
+
+#ifndef AGS_ENGINE_GFX_FRAME_DIFF_H
+#define AGS_ENGINE_GFX_FRAME_DIFF_H
+
+#include "common/rect.h"
+#include "common/std/vector.h"
+#include "ags/shared/core/types.h"
+#include "graphics/surface.h"
+
+namespace AGS3 {
+namespace AGS {
+namespace Engine {
+
+class FrameDiff {
+public:
+	// Height of the bands the frame is compared in; changed rows within
+	// a band are joined into a single rectangle
+	static const int BandHeight = 16;
+
+	FrameDiff() = default;
+	~FrameDiff();
+
+	// Forgets the last frame, so that next one is reported as changed entirely
+	void Reset();
+	// Compares the frame with the last one and remembers it; returns the
+	// regions that have changed, empty list if the frame is the same
+	const std::vector<Common::Rect> &Update(const Graphics::Surface &frame);
+	// Returns the regions found by the last Update
+	const std::vector<Common::Rect> &GetChangedRects() const { return _rects; }
+
+private:
+	// Adds a changed rectangle, merging it with the previous one if they touch
+	void AddRect(const Common::Rect &r);
+
+	Graphics::Surface _last;
+	std::vector<Common::Rect> _rects;
+};
+
+} // namespace Engine
+} // namespace AGS
+} // namespace AGS3
+
+#endif
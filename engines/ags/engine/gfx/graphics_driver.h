@@ -117,6 +117,12 @@ public:
 	virtual bool SetDisplayMode(const DisplayMode &mode) = 0;
 	// Updates previously set display mode, accommodating to the new screen size
 	virtual void UpdateDeviceScreen(const Size &screen_size) = 0;
+	// Tells the driver that the device screen was drawn to directly, bypassing
+	// it, so that the next frame has to be presented in full
+	virtual void InvalidateDeviceScreen() = 0;
+	// Tells the driver that the bitmaps it draws from were changed in place,
+	// so that the next frame may differ even if the draw lists are the same
+	virtual void InvalidateContent() = 0;
 	// Gets if a graphics mode was initialized
 	virtual bool IsModeSet() const = 0;
 	// Set the size of the native image size
@@ -110,6 +110,9 @@ static bool play_video(Video::VideoDecoder *decoder, const char *name, int flags
 			}
 
 			scr.update();
+			// The frame was drawn past the graphics driver, which has to
+			// redraw the whole screen when the game resumes
+			_G(gfxDriver)->InvalidateDeviceScreen();
 		}
 
 		g_system->delayMillis(10);
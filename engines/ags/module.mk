@@ -236,6 +236,7 @@ MODULE_OBJS = \
 	engine/gfx/ali_3d_scummvm.o \
 	engine/gfx/blender.o \
 	engine/gfx/color_engine.o \
+	engine/gfx/frame_diff.o \
 	engine/gfx/gfx_driver_base.o \
 	engine/gfx/gfx_driver_factory.o \
 	engine/gfx/gfx_util.o \
@@ -379,6 +380,7 @@ MODULE_OBJS += \
 	tests/test_inifile.o \
 	tests/test_math.o \
 	tests/test_memory.o \
+	tests/test_script.o \
 	tests/test_sprintf.o \
 	tests/test_string.o \
 	tests/test_version.o
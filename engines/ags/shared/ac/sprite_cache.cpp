@@ -47,6 +47,10 @@ using namespace AGS::Shared;
 #define SPRCACHEFLAG_ERROR	  0x04
 // Locked sprites are ones that should not be freed when out of cache space.
 #define SPRCACHEFLAG_LOCKED	  0x08
+// Tells that the sprite is linked into the MRU list
+#define SPRCACHEFLAG_INMRU	  0x10
+// Tells that the sprite is waiting in the prefetch queue
+#define SPRCACHEFLAG_QUEUED	  0x20
 
 // High-verbosity sprite cache log
 #if DEBUG_SPRITECACHE
@@ -103,7 +107,10 @@ bool SpriteCache::IsAssetSprite(sprkey_t index) const {
 void SpriteCache::Reset() {
 	_file.Close();
 	_spriteData.clear();
-	_mru.clear();
+	_mruFirst = _mruLast = -1;
+	_mruCount = 0;
+	_prefetchQueue.clear();
+	_prefetchPos = 0;
 	_cacheSize = 0;
 	_lockedSize = 0;
 }
@@ -124,6 +131,7 @@ bool SpriteCache::SetSprite(sprkey_t index, std::unique_ptr<Bitmap> image, int f
 		| (SPF_TRUECOLOR * image->GetColorDepth() > 16);
 	_sprInfos[index] = SpriteInfo(image->GetWidth(), image->GetHeight(), spf_flags);
 	// Assign sprite with 0 size, as it will not be included into the cache size
+	MruRemove(index);
 	_spriteData[index] = SpriteData(image.release(), 0, SPRCACHEFLAG_EXTERNAL | SPRCACHEFLAG_LOCKED);
 	SprCacheLog("SetSprite: (external) %d", index);
 	return true;
@@ -178,6 +186,7 @@ sprkey_t SpriteCache::GetFreeIndex() {
 	for (size_t i = MIN_SPRITE_INDEX; i < _spriteData.size(); ++i) {
 		// slot empty
 		if (!DoesSpriteExist(i)) {
+			MruRemove(i);
 			_sprInfos[i] = SpriteInfo();
 			_spriteData[i] = SpriteData();
 			return i;
@@ -208,6 +217,14 @@ bool SpriteCache::SpriteData::IsLocked() const {
 	return (Flags & SPRCACHEFLAG_LOCKED) != 0;
 }
 
+bool SpriteCache::SpriteData::IsInMru() const {
+	return (Flags & SPRCACHEFLAG_INMRU) != 0;
+}
+
+bool SpriteCache::SpriteData::IsQueued() const {
+	return (Flags & SPRCACHEFLAG_QUEUED) != 0;
+}
+
 bool SpriteCache::DoesSpriteExist(sprkey_t index) const {
 	return (index >= 0 && (size_t)index < _spriteData.size()) &&  // in the valid range
 		   _spriteData[index].IsValid();  // has assigned sprite
@@ -223,25 +240,81 @@ Bitmap *SpriteCache::operator[](sprkey_t index) {
 		return _placeholder.get();
 
 	// Externally added sprite or locked sprite, don't put it into MRU list
-	if (_spriteData[index].IsExternalSprite() || _spriteData[index].IsLocked())
+	if (_spriteData[index].IsExternalSprite())
 		return _spriteData[index].Image.get();
+	if (_spriteData[index].IsLocked()) {
+		if (_spriteData[index].Image)
+			_stats.Hits++;
+		return _spriteData[index].Image.get();
+	}
 	// Either use ready image, or load one from assets
 	if (_spriteData[index].Image) {
 		// Move to the beginning of the MRU list
-		_mru.splice(_mru.begin(), _mru, _spriteData[index].MruIt);
+		MruMoveToFront(index);
+		_stats.Hits++;
 		return _spriteData[index].Image.get();
 	} else {
 		// Sprite exists in file but is not in mem, load it and add to MRU list
+		_stats.Misses++;
 		if (LoadSprite(index)) {
-			_spriteData[index].MruIt = _mru.insert(_mru.begin(), index);
+			MruPushFront(index);
 			return _spriteData[index].Image.get();
 		}
 	}
 	return _placeholder.get();
 }
 
+void SpriteCache::MruPushFront(sprkey_t index) {
+	SpriteData &data = _spriteData[index];
+	assert(!data.IsInMru());
+	data.MruPrev = -1;
+	data.MruNext = _mruFirst;
+	if (_mruFirst >= 0)
+		_spriteData[_mruFirst].MruPrev = index;
+	else
+		_mruLast = index;
+	_mruFirst = index;
+	data.Flags |= SPRCACHEFLAG_INMRU;
+	_mruCount++;
+}
+
+void SpriteCache::MruRemove(sprkey_t index) {
+	SpriteData &data = _spriteData[index];
+	if (!data.IsInMru())
+		return;
+	if (data.MruPrev >= 0)
+		_spriteData[data.MruPrev].MruNext = data.MruNext;
+	else
+		_mruFirst = data.MruNext;
+	if (data.MruNext >= 0)
+		_spriteData[data.MruNext].MruPrev = data.MruPrev;
+	else
+		_mruLast = data.MruPrev;
+	data.MruPrev = data.MruNext = -1;
+	data.Flags &= ~SPRCACHEFLAG_INMRU;
+	_mruCount--;
+}
+
+void SpriteCache::MruMoveToFront(sprkey_t index) {
+	if (_mruFirst == index)
+		return;
+	MruRemove(index);
+	MruPushFront(index);
+}
+
+void SpriteCache::MruClear() {
+	for (sprkey_t i = _mruFirst; i >= 0;) {
+		SpriteData &data = _spriteData[i];
+		i = data.MruNext;
+		data.MruPrev = data.MruNext = -1;
+		data.Flags &= ~SPRCACHEFLAG_INMRU;
+	}
+	_mruFirst = _mruLast = -1;
+	_mruCount = 0;
+}
+
 void SpriteCache::FreeMem(size_t space) {
-	for (int tries = 0; (_mru.size() > 0) && (_cacheSize >= (_maxCacheSize - space)); ++tries) {
+	for (int tries = 0; (_mruCount > 0) && (_cacheSize >= (_maxCacheSize - space)); ++tries) {
 		DisposeOldest();
 		if (tries > 1000) { // ???
 			Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Error, "RUNTIME CACHE ERROR: STUCK IN FREE_UP_MEM; RESETTING CACHE");
@@ -251,11 +324,10 @@ void SpriteCache::FreeMem(size_t space) {
 }
 
 void SpriteCache::DisposeOldest() {
-	assert(_mru.size() > 0);
-	if (_mru.size() == 0)
+	assert(_mruCount > 0);
+	if (_mruCount == 0)
 		return;
-	auto it = std::prev(_mru.end());
-	const auto sprnum = *it;
+	const sprkey_t sprnum = _mruLast;
 	// Safety check: must be a sprite from resources
 	// TODO: compare with latest upstream
 	// Commented out the assertion, since it triggers for sprites that are in the list but remapped to the placeholder (sprite 0)
@@ -265,10 +337,7 @@ void SpriteCache::DisposeOldest() {
 
 	if (!_spriteData[sprnum].IsAssetSprite()) {
 		Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Error, "SpriteCache::DisposeOldest: in MRU list sprite %d is external or does not exist", sprnum);
-		_mru.erase(it);
-		// std::list::erase() invalidates iterators to the erased item.
-		// But our implementation does not.
-		_spriteData[sprnum].MruIt._node = nullptr;
+		MruRemove(sprnum);
 		return;
 	}
 	// Delete the image, unless is locked
@@ -276,19 +345,18 @@ void SpriteCache::DisposeOldest() {
 	if (!_spriteData[sprnum].IsLocked()) {
 		_cacheSize -= _spriteData[sprnum].Size;
 		_spriteData[sprnum].Image.reset();
+		_stats.Evictions++;
 		SprCacheLog("DisposeOldest: disposed %d, size now %d KB", sprnum, _cacheSize / 1024);
 	}
 	// Remove from the mru list
-	_mru.erase(it);
-	// std::list::erase() invalidates iterators to the erased item.
-	// But our implementation does not.
-	_spriteData[sprnum].MruIt._node = nullptr;
+	MruRemove(sprnum);
 }
 
 void SpriteCache::DisposeCached(sprkey_t index) {
 	if (IsAssetSprite(index)) {
 		_spriteData[index].Flags &= ~SPRCACHEFLAG_LOCKED;
 		_spriteData[index].Image.reset();
+		MruRemove(index);
 	}
 	_cacheSize = _lockedSize;
 }
@@ -302,7 +370,7 @@ void SpriteCache::DisposeAllFreeCached() {
 		}
 	}
 	_cacheSize = _lockedSize;
-	_mru.clear();
+	MruClear();
 }
 
 void SpriteCache::PrecacheSprite(sprkey_t index) {
@@ -318,10 +386,7 @@ void SpriteCache::PrecacheSprite(sprkey_t index) {
 	} else if (!_spriteData[index].IsLocked()) {
 		size = _spriteData[index].Size;
 		// Remove locked sprite from the MRU list
-		_mru.erase(_spriteData[index].MruIt);
-		// std::list::erase() invalidates iterators to the erased item.
-		// But our implementation does not.
-		_spriteData[index].MruIt._node = nullptr;
+		MruRemove(index);
 	}
 
 	// make sure locked sprites can't fill the cache
@@ -331,6 +396,58 @@ void SpriteCache::PrecacheSprite(sprkey_t index) {
 	SprCacheLog("Precached %d", index);
 }
 
+void SpriteCache::PrefetchSprite(sprkey_t index) {
+	if (index < 0 || (size_t)index >= _spriteData.size())
+		return;
+	SpriteData &data = _spriteData[index];
+	if (!data.IsAssetSprite() || data.IsError() || data.IsQueued() || data.Image)
+		return;
+	data.Flags |= SPRCACHEFLAG_QUEUED;
+	_prefetchQueue.push_back(index);
+}
+
+bool SpriteCache::ProcessPrefetch(uint32_t time_limit_ms) {
+	const uint32_t start = g_system->getMillis();
+	while (_prefetchPos < _prefetchQueue.size()) {
+		if (g_system->getMillis() - start >= time_limit_ms)
+			return true;
+
+		const sprkey_t index = _prefetchQueue[_prefetchPos++];
+		if ((size_t)index >= _spriteData.size())
+			continue;
+		SpriteData &data = _spriteData[index];
+		if (!data.IsQueued())
+			continue; // slot was reassigned, or queue was cleared
+		data.Flags &= ~SPRCACHEFLAG_QUEUED;
+		if (!data.IsAssetSprite() || data.IsError() || data.Image)
+			continue;
+
+		// Don't let prefetch push out sprites which are in use; the real
+		// size is only known after loading, so assume the largest format
+		const size_t expect_size = _sprInfos[index].Width * _sprInfos[index].Height * 4;
+		if (_cacheSize + expect_size > _maxCacheSize)
+			continue;
+
+		if (LoadSprite(index)) {
+			MruPushFront(index);
+			_stats.Prefetched++;
+			SprCacheLog("Prefetched %d", index);
+		}
+	}
+	ClearPrefetch();
+	return false;
+}
+
+void SpriteCache::ClearPrefetch() {
+	for (size_t i = _prefetchPos; i < _prefetchQueue.size(); ++i) {
+		const sprkey_t index = _prefetchQueue[i];
+		if ((size_t)index < _spriteData.size())
+			_spriteData[index].Flags &= ~SPRCACHEFLAG_QUEUED;
+	}
+	_prefetchQueue.clear();
+	_prefetchPos = 0;
+}
+
 void SpriteCache::LockSprite(sprkey_t index) {
 	assert(index >= 0); // out of positive range indexes are valid to fail
 	if (index < 0 || (size_t)index >= _spriteData.size())
@@ -391,6 +508,7 @@ size_t SpriteCache::LoadSprite(sprkey_t index, bool lock) {
 	FreeMem(size);
 	// Add to the cache, lock if requested or if it's sprite 0
 	const bool should_lock = lock || (index == 0);
+	MruRemove(index);
 	_spriteData[index] = SpriteData(image, size, SPRCACHEFLAG_ISASSET);
 	_spriteData[index].Flags |= (SPRCACHEFLAG_LOCKED * should_lock);
 	_cacheSize += size;
@@ -413,6 +531,7 @@ void SpriteCache::RemapSpriteToPlaceholder(sprkey_t index) {
 
 void SpriteCache::InitNullSprite(sprkey_t index) {
 	assert(index >= 0);
+	MruRemove(index);
 	_sprInfos[index] = SpriteInfo();
 	_spriteData[index] = SpriteData();
 }
@@ -438,7 +557,6 @@ HError SpriteCache::InitFile(const String &filename, const String &sprindex_file
 	size_t newsize = metrics.size();
 	_sprInfos.resize(newsize);
 	_spriteData.resize(newsize);
-	_mru.clear();
 	for (size_t i = 0; i < metrics.size(); ++i) {
 		if (!metrics[i].IsNull()) {
 			// Existing sprite
@@ -24,7 +24,9 @@
 //
 // SpriteFile handles sprite serialization and streaming.
 // SpriteCache provides bitmaps by demand; it uses SpriteFile to load sprites
-// and does MRU (most-recent-use) caching.
+// and does MRU (most-recent-use) caching. Sprites which are going to be
+// needed soon may be queued for prefetch, and then loaded in advance while
+// the engine waits for the next frame.
 //
 // TODO: store sprite data in a specialized container type that is optimized
 // for having most keys allocated in large continious sequences by default.
@@ -43,7 +45,6 @@
 
 #include "common/std/memory.h"
 #include "common/std/vector.h"
-#include "common/std/list.h"
 #include "ags/shared/ac/sprite_file.h"
 #include "ags/shared/core/platform.h"
 #include "ags/shared/gfx/bitmap.h"
@@ -95,6 +96,14 @@ public:
 		PfnPrewriteSprite PrewriteSprite;
 	};
 
+	// Cache usage counters, for diagnostic purposes
+	struct Stats {
+		uint32_t Hits = 0u;        // requested sprites which were already loaded
+		uint32_t Misses = 0u;      // requested sprites which had to be loaded
+		uint32_t Evictions = 0u;   // sprites disposed to free space
+		uint32_t Prefetched = 0u;  // sprites loaded by prefetch
+	};
+
 	SpriteCache(std::vector<SpriteInfo> &sprInfos, const Callbacks &callbacks);
 	~SpriteCache() = default;
 
@@ -138,6 +147,16 @@ public:
 	// Loads sprite using SpriteFile if such index is known,
 	// frees the space if cache size reaches the limit
 	void        PrecacheSprite(sprkey_t index);
+	// Queues an asset sprite to be loaded in advance by ProcessPrefetch;
+	// does nothing if the sprite is already in memory
+	void        PrefetchSprite(sprkey_t index);
+	// Loads queued sprites until the given number of milliseconds passes.
+	// Prefetch never disposes other sprites, sprites which do not fit
+	// into the free cache space are skipped. Returns if there are
+	// more sprites left in the queue.
+	bool        ProcessPrefetch(uint32_t time_limit_ms);
+	// Drops all sprites queued for prefetch
+	void        ClearPrefetch();
 	// Locks sprite, preventing it from getting removed by the normal cache limit.
 	// If this is a registered sprite from the game assets, then loads it first.
 	// If this is a sprite with SPRCACHEFLAG_EXTERNAL flag, then does nothing,
@@ -174,6 +193,10 @@ public:
 	void        SetEmptySprite(sprkey_t index, bool as_asset);
 	// Sets max cache size in bytes
 	void        SetMaxCacheSize(size_t size);
+	// Returns cache usage counters
+	const Stats &GetStats() const { return _stats; }
+	// Resets cache usage counters
+	void        ResetStats() { _stats = Stats(); }
 
 	// Loads (if it's not in cache yet) and returns bitmap by the sprite index
 	Bitmap *operator[](sprkey_t index);
@@ -185,6 +208,11 @@ private:
 	void        RemapSpriteToPlaceholder(sprkey_t index);
 	// Delete the oldest (least recently used) image in cache
 	void        DisposeOldest();
+	// MRU list operations
+	void        MruPushFront(sprkey_t index);
+	void        MruRemove(sprkey_t index);
+	void        MruMoveToFront(sprkey_t index);
+	void        MruClear();
 	// Keep disposing oldest elements until cache has at least the given free space
 	void        FreeMem(size_t space);
 	// Initialize the empty sprite slot
@@ -203,8 +231,9 @@ private:
 		uint32_t Flags = 0;			   // SPRCACHEFLAG* flags
 		std::unique_ptr<Bitmap> Image; // actual bitmap
 
-		// MRU list reference
-		std::list<sprkey_t>::iterator MruIt;
+		// MRU list links, -1 if there's no neighbour in that direction
+		sprkey_t MruPrev = -1;
+		sprkey_t MruNext = -1;
 
 		SpriteData() = default;
 		SpriteData(SpriteData &&other) = default;
@@ -224,6 +253,10 @@ private:
 		bool IsExternalSprite() const;
 		// Tells if sprite is locked and should not be disposed by cache logic
 		bool IsLocked() const;
+		// Tells if sprite is linked into the MRU list
+		bool IsInMru() const;
+		// Tells if sprite is queued for prefetch
+		bool IsQueued() const;
 	};
 
 	// Provided map of sprite infos, to fill in loaded sprite properties
@@ -242,8 +275,18 @@ private:
 
 	// MRU list: the way to track which sprites were used recently.
 	// When clearing up space for new sprites, cache first deletes the sprites
-	// that were last time used long ago.
-	std::list<sprkey_t> _mru;
+	// that were last time used long ago. The list is linked through the
+	// sprite slots themselves, so that any sprite can be moved or removed
+	// without searching or allocating list nodes.
+	sprkey_t _mruFirst = -1;  // most recently used
+	sprkey_t _mruLast = -1;   // least recently used
+	size_t _mruCount = 0u;
+
+	// Sprites waiting to be loaded by ProcessPrefetch, in order of request
+	std::vector<sprkey_t> _prefetchQueue;
+	size_t _prefetchPos = 0u;
+
+	Stats _stats;
 
 };
 
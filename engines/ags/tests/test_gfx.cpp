@@ -30,6 +30,7 @@
 #include "ags/shared/gfx/image.h"
 #include "ags/lib/allegro/surface.h"
 #include "ags/shared/debugging/debug_manager.h"
+#include "ags/engine/gfx/frame_diff.h"
 #include "ags/globals.h"
 #include "graphics/managed_surface.h"
 #include "graphics/pixelformat.h"
@@ -263,8 +264,89 @@ void Test_GfxTransparency() {
 	}
 }
 
+// Draws a square "sprite" over the frame, as a moving cursor or character would be
+static void Test_FrameDiffDrawSprite(Graphics::Surface &frame, int x, int y, int size, uint32 color) {
+	frame.fillRect(Common::Rect(x, y, x + size, y + size).findIntersectingRect(Common::Rect(frame.w, frame.h)), color);
+}
+
+void Test_FrameDiff() {
+	const Graphics::PixelFormat format(4, 8, 8, 8, 8, 16, 8, 0, 24);
+	Graphics::Surface frame;
+	frame.create(320, 200, format);
+	frame.fillRect(Common::Rect(320, 200), 0xFF102030);
+
+	AGS::Engine::FrameDiff diff;
+	// First frame is always sent as a whole
+	const std::vector<Common::Rect> *rects = &diff.Update(frame);
+	assert(rects->size() == 1 && (*rects)[0] == Common::Rect(320, 200));
+	// Nothing changed
+	rects = &diff.Update(frame);
+	assert(rects->empty());
+
+	// A single changed pixel gives a single pixel rect
+	*(uint32 *)frame.getBasePtr(101, 57) = 0xFFFFFFFF;
+	rects = &diff.Update(frame);
+	assert(rects->size() == 1 && (*rects)[0] == Common::Rect(101, 57, 102, 58));
+
+	// Sprite spanning several bands is reported as one rect covering it
+	Test_FrameDiffDrawSprite(frame, 10, 10, 40, 0xFF00FF00);
+	rects = &diff.Update(frame);
+	assert(rects->size() == 1 && (*rects)[0].contains(Common::Rect(10, 10, 50, 50)));
+	assert((*rects)[0].left == 10 && (*rects)[0].right == 50);
+
+	// Two sprites far apart produce separate rects
+	Test_FrameDiffDrawSprite(frame, 0, 0, 4, 0xFF0000FF);
+	Test_FrameDiffDrawSprite(frame, 300, 180, 4, 0xFF0000FF);
+	rects = &diff.Update(frame);
+	assert(rects->size() == 2);
+
+	// After reset the whole frame is reported again
+	diff.Reset();
+	rects = &diff.Update(frame);
+	assert(rects->size() == 1 && (*rects)[0] == Common::Rect(320, 200));
+
+	frame.free();
+}
+
+// Compares presenting a mostly static 640x480 scene with a moving cursor
+// as a full frame copy each time and as a copy of the changed regions only
+void Test_FrameDiffSpeed() {
+	const Graphics::PixelFormat format(4, 8, 8, 8, 8, 16, 8, 0, 24);
+	const int frames = 1000;
+	Graphics::Surface frame, screen;
+	frame.create(640, 480, format);
+	screen.create(640, 480, format);
+	for (int y = 0; y < frame.h; ++y)
+		for (int x = 0; x < frame.w; ++x)
+			*(uint32 *)frame.getBasePtr(x, y) = 0xFF000000 | ((x * 0x10101) ^ (y << 8));
+
+	uint32 start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < frames; ++i) {
+		Test_FrameDiffDrawSprite(frame, i % 600, (i * 3) % 440, 16, 0xFFFFFFFF - i);
+		screen.copyRectToSurface(frame, 0, 0, Common::Rect(frame.w, frame.h));
+	}
+	const uint32 time_full = std::chrono::high_resolution_clock::now() - start;
+
+	AGS::Engine::FrameDiff diff;
+	start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < frames; ++i) {
+		Test_FrameDiffDrawSprite(frame, i % 600, (i * 3) % 440, 16, 0xFFFFFFFF - i);
+		for (const auto &r : diff.Update(frame))
+			screen.copyRectToSurface(frame, r.left, r.top, r);
+	}
+	const uint32 time_diff = std::chrono::high_resolution_clock::now() - start;
+
+	debug("Present %d frames 640x480: full copy %u ms, changed regions %u ms", frames, time_full, time_diff);
+	frame.free();
+	screen.free();
+}
+
 void Test_Gfx() {
 	Test_GfxTransparency();
+	Test_FrameDiff();
+#if defined(SLOW_TESTS)
+	Test_FrameDiffSpeed();
+#endif
 #if (defined(SCUMMVM_AVX2) || defined(SCUMMVM_SSE2) || defined(SCUMMVM_NEON)) && defined(SLOW_TESTS)
 	Test_BlenderModes();
 	// This could take a LONG time
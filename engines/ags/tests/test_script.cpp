@@ -0,0 +1,153 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ags/shared/core/platform.h"
+#include "common/scummsys.h"
+#include "ags/shared/script/cc_common.h"
+#include "ags/shared/script/cc_internal.h"
+#include "ags/engine/script/cc_instance.h"
+#include "ags/shared/util/string_compat.h"
+
+namespace AGS3 {
+
+// Hand-assembled script exporting three functions of one int argument:
+//   sumsq(n)    - sum of i*i for i in [0; n), a loop with jumps back and forth
+//   calltest(n) - 3 * sumsq(n), a call within the same script
+//   div(n)      - 100 / n, which fails with an error if n is 0
+static const int32_t test_script_code[] = {
+	// sumsq$1
+	SCMD_LOADSPOFFS, 8,
+	SCMD_MEMREAD, SREG_CX,
+	SCMD_LITTOREG, SREG_DX, 0,
+	SCMD_LITTOREG, SREG_BX, 0,
+	SCMD_REGTOREG, SREG_BX, SREG_AX,    // 10: loop start
+	SCMD_LESSTHAN, SREG_AX, SREG_CX,
+	SCMD_JZ, 14,
+	SCMD_REGTOREG, SREG_BX, SREG_AX,
+	SCMD_MULREG, SREG_AX, SREG_BX,
+	SCMD_ADDREG, SREG_DX, SREG_AX,
+	SCMD_ADD, SREG_BX, 1,
+	SCMD_JMP, -22,
+	SCMD_REGTOREG, SREG_DX, SREG_AX,    // 32: loop end
+	SCMD_RET,
+	// calltest$1
+	SCMD_LOADSPOFFS, 8,                 // 36
+	SCMD_MEMREAD, SREG_CX,
+	SCMD_PUSHREG, SREG_CX,
+	SCMD_LITTOREG, SREG_BX, 0,
+	SCMD_CALL, SREG_BX,
+	SCMD_SUB, SREG_SP, 4,
+	SCMD_MUL, SREG_AX, 3,
+	SCMD_RET,
+	// div$1
+	SCMD_LOADSPOFFS, 8,                 // 54
+	SCMD_MEMREAD, SREG_CX,
+	SCMD_LITTOREG, SREG_AX, 100,
+	SCMD_DIVREG, SREG_AX, SREG_CX,
+	SCMD_RET
+};
+
+static const char *test_script_exports[] = { "sumsq$1", "calltest$1", "div$1" };
+static const int32_t test_script_export_addr[] = { 0, 36, 54 };
+
+static PScript CreateTestScript() {
+	PScript scri(new ccScript());
+	scri->codesize = ARRAYSIZE(test_script_code);
+	scri->code = (int32_t *)malloc(sizeof(test_script_code));
+	memcpy(scri->code, test_script_code, sizeof(test_script_code));
+	// ccScript only releases the exports along with the imports table
+	scri->imports = (char **)malloc(sizeof(char *));
+	scri->numexports = ARRAYSIZE(test_script_exports);
+	scri->exports = (char **)malloc(scri->numexports * sizeof(char *));
+	scri->export_addr = (int32_t *)malloc(scri->numexports * sizeof(int32_t));
+	for (int i = 0; i < scri->numexports; ++i) {
+		scri->exports[i] = ags_strdup(test_script_exports[i]);
+		scri->export_addr[i] = (EXPORT_FUNCTION << 24) | test_script_export_addr[i];
+	}
+	return scri;
+}
+
+static int Test_CallScript(ccInstance *inst, const char *funcname, int arg, int &result) {
+	RuntimeScriptValue params[1];
+	params[0].SetInt32(arg);
+	const int ret = inst->CallScriptFunction(funcname, 1, params);
+	result = inst->returnValue;
+	return ret;
+}
+
+// Expected results of the test script functions
+static bool Test_ScriptExpected(const char *funcname, int arg, int &result) {
+	if (strcmp(funcname, "div") == 0) {
+		if (arg == 0)
+			return false;
+		result = 100 / arg;
+		return true;
+	}
+
+	int sumsq = 0;
+	for (int i = 0; i < arg; ++i)
+		sumsq += i * i;
+	result = (strcmp(funcname, "calltest") == 0) ? 3 * sumsq : sumsq;
+	return true;
+}
+
+// Tests that the interpreter gives the expected results and errors
+static void Test_ScriptResults(ccInstance *inst) {
+	static const char *funcs[] = { "sumsq", "calltest", "div" };
+	static const int args[] = { 0, 1, 7, 10, 100, -5 };
+
+	for (int f = 0; f < ARRAYSIZE(funcs); ++f) {
+		for (int a = 0; a < ARRAYSIZE(args); ++a) {
+			int expected = 0, result = 0;
+			const bool valid = Test_ScriptExpected(funcs[f], args[a], expected);
+			const int ret = Test_CallScript(inst, funcs[f], args[a], result);
+			assert((ret == 0) == valid);
+			if (valid)
+				assert(result == expected);
+			cc_clear_error();
+		}
+	}
+}
+
+void Test_Script() {
+	PScript scri = CreateTestScript();
+
+	std::unique_ptr<ccInstance> inst = ccInstance::CreateFromScript(scri);
+	assert(inst);
+	// There are no imports, so resolving them must succeed
+	const bool importsResolved = inst->ResolveScriptImports(scri.get());
+	assert(importsResolved);
+	const bool fixupsResolved = inst->ResolveImportFixups(scri.get());
+	assert(fixupsResolved);
+
+	Test_ScriptResults(inst.get());
+
+	// Forked instances share the code with their parent
+	std::unique_ptr<ccInstance> fork = inst->Fork();
+	assert(fork);
+	assert(fork->code == inst->code);
+	Test_ScriptResults(fork.get());
+
+	fork.reset();
+	inst.reset();
+}
+
+} // namespace AGS3
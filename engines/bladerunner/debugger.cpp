@@ -43,6 +43,7 @@
 #include "bladerunner/item_pickup.h"
 #include "bladerunner/screen_effects.h"
 #include "bladerunner/settings.h"
+#include "bladerunner/slice_animations.h"
 #include "bladerunner/set.h"
 #include "bladerunner/set_effects.h"
 #include "bladerunner/text_resource.h"
@@ -146,6 +147,7 @@ Debugger::Debugger(BladeRunnerEngine *vm) : GUI::Debugger() {
 	registerCmd("playvqa", WRAP_METHOD(Debugger, cmdPlayVqa));
 	registerCmd("ammo", WRAP_METHOD(Debugger, cmdAmmo));
 	registerCmd("cheat", WRAP_METHOD(Debugger, cmdCheatReport));
+	registerCmd("pagecache", WRAP_METHOD(Debugger, cmdPageCache));
 #if BLADERUNNER_ORIGINAL_BUGS
 #else
 	registerCmd("effect", WRAP_METHOD(Debugger, cmdEffect));
@@ -3331,4 +3333,52 @@ bool Debugger::cmdCheatReport(int argc, const char** argv) {
 	return true;
 }
 
+bool Debugger::cmdPageCache(int argc, const char **argv) {
+	bool invalidSyntax = false;
+	SliceAnimations *sliceAnimations = _vm->_sliceAnimations;
+
+	if (argc == 2) {
+		Common::String argName = argv[1];
+		argName.toLowercase();
+		if (argName == "reset") {
+			sliceAnimations->resetPageCacheStats();
+		} else if (argName == "on") {
+			sliceAnimations->setPrefetchEnabled(true);
+		} else if (argName == "off") {
+			sliceAnimations->setPrefetchEnabled(false);
+		} else {
+			invalidSyntax = true;
+		}
+	} else if (argc == 3) {
+		Common::String argName = argv[1];
+		argName.toLowercase();
+		if (argName == "budget" && Common::isDigit(*argv[2])) {
+			sliceAnimations->setPageBudget(atoi(argv[2]));
+		} else {
+			invalidSyntax = true;
+		}
+	} else if (argc != 1) {
+		invalidSyntax = true;
+	}
+
+	if (invalidSyntax) {
+		debugPrintf("Show the slice animation page cache statistics, or change how pages are read ahead.\n");
+		debugPrintf("A budget of 0 means no limit on the number of loaded pages.\n");
+		debugPrintf("Usage: %s [reset | on | off | budget <pages>]\n", argv[0]);
+		return true;
+	}
+
+	const SliceAnimations::PageCacheStats &stats = sliceAnimations->getPageCacheStats();
+	uint32 accesses = stats.hits + stats.misses;
+	debugPrintf("Frames: %u, hits: %u, misses: %u, hit rate: %u%%\n", accesses, stats.hits, stats.misses, accesses ? stats.hits * 100 / accesses : 0);
+	debugPrintf("Pages read ahead: %u, used: %u, evicted: %u\n", stats.prefetched, stats.prefetchedUsed, stats.evicted);
+	if (sliceAnimations->getPageBudget()) {
+		debugPrintf("Loaded pages: %u of %u\n", sliceAnimations->getLoadedPageCount(), sliceAnimations->getPageBudget());
+	} else {
+		debugPrintf("Loaded pages: %u (no limit)\n", sliceAnimations->getLoadedPageCount());
+	}
+	debugPrintf("Reading ahead is %s, %u pages queued\n", sliceAnimations->isPrefetchEnabled() ? "on" : "off", sliceAnimations->getPrefetchQueueLength());
+	return true;
+}
+
 } // End of namespace BladeRunner
@@ -22,6 +22,7 @@
 #include "bladerunner/framelimiter.h"
 
 #include "bladerunner/bladerunner.h"
+#include "bladerunner/slice_animations.h"
 #include "bladerunner/time.h"
 
 #include "common/debug.h"
@@ -55,10 +56,17 @@ void Framelimiter::wait() {
 	uint32 frameDuration = timeNow - _timeFrameStart;
 	if (frameDuration < _speedLimitMs) {
 		uint32 waittime = _speedLimitMs - frameDuration;
+		// Spend the spare time reading ahead the slice animation pages of the next frames
+		if (_vm->_sliceAnimations) {
+			_vm->_sliceAnimations->prefetchPages(timeNow + waittime);
+		}
 		if (_vm->_noDelayMillisFramelimiter) {
 			while (_vm->_time->currentSystem() - timeNow < waittime) { }
 		} else {
-			_vm->_system->delayMillis(waittime);
+			uint32 elapsed = _vm->_time->currentSystem() - timeNow;
+			if (elapsed < waittime) {
+				_vm->_system->delayMillis(waittime - elapsed);
+			}
 		}
 		timeNow += waittime;
 	}
@@ -30,6 +30,10 @@
 
 namespace BladeRunner {
 
+const uint32 SliceAnimations::kPrefetchFrames;
+const uint32 SliceAnimations::kPrefetchKeepTime;
+const uint32 SliceAnimations::kMinPageBudget;
+
 bool SliceAnimations::open(const Common::String &name) {
 	Common::File file;
 	if (!file.open(_vm->getResourceStream(name), name))
@@ -270,23 +274,131 @@ void *SliceAnimations::getFramePtr(uint32 animation, uint32 frame) {
 
 	if (page._data == nullptr) {                          // if not cached already
 		newPage = true;
-		page._data = _coreAnimPageFile.loadPage(pageId);    // look in COREANIM first
-
-		if (page._data == nullptr) {                      // if not in COREAMIM
-			page._data = _framesPageFile.loadPage(pageId);  // Look in CDFRAMES or HDFRAMES loaded data
+		++_stats.misses;
+		page._data = loadPage(pageId);
 
-			if (page._data == nullptr) {
-				error("Unable to locate page %d for animation %d frame %d", pageId, animation, frame);
-			}
+		if (page._data == nullptr) {
+			error("Unable to locate page %d for animation %d frame %d", pageId, animation, frame);
+		}
+	} else {
+		++_stats.hits;
+		if (page._prefetched) {
+			++_stats.prefetchedUsed;
+			page._prefetched = false;
 		}
 	}
 
 	page._lastAccess = _vm->_time->currentSystem();
 	updatePagesList(page, newPage);
 
+	if (newPage && _pageBudget) {
+		trimPages(_pageBudget, page._lastAccess);
+	}
+
 	return (byte *)page._data + pageOffset;
 }
 
+void *SliceAnimations::loadPage(uint32 pageId) {
+	void *data = _coreAnimPageFile.loadPage(pageId);    // look in COREANIM first
+	if (data == nullptr) {                             // if not in COREAMIM
+		data = _framesPageFile.loadPage(pageId);        // Look in CDFRAMES or HDFRAMES loaded data
+	}
+	if (data != nullptr) {
+		++_loadedPageCount;
+	}
+	return data;
+}
+
+void SliceAnimations::queuePrefetch(uint32 animation, uint32 frame) {
+	if (!_prefetchEnabled || animation >= _animations.size()) {
+		return;
+	}
+
+	const Animation &anim = _animations[animation];
+	if (anim.frameCount == 0) {
+		return;
+	}
+
+	// Animations loop, so the frames after the last one are the first ones again
+	uint32 frames = MIN(kPrefetchFrames, anim.frameCount - 1);
+	for (uint32 i = 1; i <= frames; ++i) {
+		uint32 nextFrame = (frame + i) % anim.frameCount;
+		uint32 frameOffset = anim.offset + nextFrame * anim.frameSize;
+
+		// A frame can straddle two pages
+		uint32 firstPage = frameOffset / _pageSize;
+		uint32 lastPage = (frameOffset + anim.frameSize - 1) / _pageSize;
+		for (uint32 pageId = firstPage; pageId <= lastPage && pageId < _pageCount; ++pageId) {
+			Page &page = _pages[pageId];
+			if (page._data == nullptr && !page._queued) {
+				page._queued = true;
+				_prefetchQueue.push_back(pageId);
+			}
+		}
+	}
+}
+
+void SliceAnimations::prefetchPages(uint32 deadline) {
+	while (_prefetchQueueHead < _prefetchQueue.size()) {
+		uint32 now = _vm->_time->currentSystem();
+		if ((int32)(deadline - now) <= 0) {
+			return;
+		}
+
+		if (_pageBudget && _loadedPageCount >= _pageBudget) {
+			// Only make room by freeing pages that are not in use right now
+			trimPages(_pageBudget - 1, now >= kPrefetchKeepTime ? now - kPrefetchKeepTime : 0);
+			if (_loadedPageCount >= _pageBudget) {
+				break;
+			}
+		}
+
+		uint32 pageId = _prefetchQueue[_prefetchQueueHead++];
+		Page &page = _pages[pageId];
+		page._queued = false;
+
+		if (page._data != nullptr) {
+			continue;
+		}
+
+		// Pages of frame files that are not open can't be read ahead
+		page._data = loadPage(pageId);
+		if (page._data == nullptr) {
+			continue;
+		}
+
+		++_stats.prefetched;
+		page._prefetched = true;
+		page._lastAccess = now;
+		updatePagesList(page, true);
+	}
+
+	// Either everything was read, or there is no room left for it
+	clearPrefetchQueue();
+}
+
+void SliceAnimations::clearPrefetchQueue() {
+	for (uint32 i = _prefetchQueueHead; i < _prefetchQueue.size(); ++i) {
+		_pages[_prefetchQueue[i]]._queued = false;
+	}
+	_prefetchQueue.resize(0);
+	_prefetchQueueHead = 0;
+}
+
+void SliceAnimations::setPrefetchEnabled(bool enabled) {
+	_prefetchEnabled = enabled;
+	if (!enabled) {
+		clearPrefetchQueue();
+	}
+}
+
+void SliceAnimations::setPageBudget(uint32 pages) {
+	_pageBudget = pages ? MAX(pages, kMinPageBudget) : 0;
+	if (_pageBudget) {
+		trimPages(_pageBudget, _vm->_time->currentSystem());
+	}
+}
+
 void SliceAnimations::updatePagesList(Page &page, bool newPage) {
 	// We are already at the end, nothing to update
 	// Only cleanup old pages if any
@@ -362,11 +474,36 @@ void SliceAnimations::cleanupOutdatedPages() {
 		page->_lastAccess = 0;
 		page->_prevPage = nullptr;
 		page->_nextPage = nullptr;
+		page->_prefetched = false;
+		--_loadedPageCount;
 
 		page = next;
 	}
 }
 
+void SliceAnimations::trimPages(uint32 maxPages, uint32 usedBefore) {
+	// _lastUsedPage->_nextPage is the oldest page in the list,
+	// and _lastUsedPage itself is always kept
+	while (_lastUsedPage && _loadedPageCount > maxPages) {
+		Page *page = _lastUsedPage->_nextPage;
+		if (page == _lastUsedPage || page->_lastAccess >= usedBefore) {
+			break;
+		}
+
+		_lastUsedPage->_nextPage = page->_nextPage;
+		page->_nextPage->_prevPage = _lastUsedPage;
+
+		free(page->_data);
+		page->_data = nullptr;
+		page->_lastAccess = 0;
+		page->_prevPage = nullptr;
+		page->_nextPage = nullptr;
+		page->_prefetched = false;
+		--_loadedPageCount;
+		++_stats.evicted;
+	}
+}
+
 Vector3 SliceAnimations::getPositionChange(int animation) const {
 	return _animations[animation].positionChange;
 }
@@ -39,6 +39,25 @@ class BladeRunnerEngine;
 class SliceAnimations {
 	friend class SliceRenderer;
 
+public:
+	struct PageCacheStats {
+		uint32 hits;           // frames whose page was already loaded
+		uint32 misses;         // frames that had to wait for their page to be read
+		uint32 prefetched;     // pages read ahead of time
+		uint32 prefetchedUsed; // pages read ahead of time that were used afterwards
+		uint32 evicted;        // pages freed to stay within the page budget
+
+		PageCacheStats() : hits(0), misses(0), prefetched(0), prefetchedUsed(0), evicted(0) {}
+	};
+
+private:
+	// How many frames ahead of the current one are read ahead
+	static const uint32 kPrefetchFrames = 8;
+	// Pages used more recently than this are not freed to make room for prefetched ones
+	static const uint32 kPrefetchKeepTime = 2000;
+	// The page budget can't be lower than this, as a frame may span several pages
+	static const uint32 kMinPageBudget = 32;
+
 	struct Animation {
 		uint32 frameCount;
 		uint32 frameSize;
@@ -61,8 +80,10 @@ class SliceAnimations {
 		// Use a doubly linked list to sort pages by access time
 		Page   *_prevPage;
 		Page   *_nextPage;
+		bool   _queued;     // waiting in the prefetch queue
+		bool   _prefetched; // read ahead of time, not used yet
 
-		Page() : _data(nullptr), _lastAccess(0), _prevPage(nullptr), _nextPage(nullptr) {}
+		Page() : _data(nullptr), _lastAccess(0), _prevPage(nullptr), _nextPage(nullptr), _queued(false), _prefetched(false) {}
 	};
 
 	struct PageFile {
@@ -90,12 +111,26 @@ class SliceAnimations {
 	Common::Array<Animation>    _animations;
 	Common::Array<Page>         _pages;
 	Page                       *_lastUsedPage;
+	uint32                      _loadedPageCount;
+	uint32                      _pageBudget;
+
+	bool                        _prefetchEnabled;
+	Common::Array<uint32>       _prefetchQueue;
+	uint32                      _prefetchQueueHead;
+	PageCacheStats              _stats;
 
 	PageFile _coreAnimPageFile;
 	PageFile _framesPageFile;
 
+	void *loadPage(uint32 pageId);
 	void updatePagesList(Page &page, bool newPage);
 	void cleanupOutdatedPages();
+	/**
+	 * Free the least recently used pages, down to maxPages. Only pages that
+	 * were last used before usedBefore are freed.
+	 */
+	void trimPages(uint32 maxPages, uint32 usedBefore);
+	void clearPrefetchQueue();
 
 public:
 	SliceAnimations(BladeRunnerEngine *vm)
@@ -106,7 +141,11 @@ public:
 		, _pageSize(0)
 		, _pageCount(0)
 		, _paletteCount(0)
-		, _lastUsedPage(nullptr) {}
+		, _lastUsedPage(nullptr)
+		, _loadedPageCount(0)
+		, _pageBudget(0)
+		, _prefetchEnabled(true)
+		, _prefetchQueueHead(0) {}
 	~SliceAnimations();
 
 	bool open(const Common::String &name);
@@ -122,6 +161,29 @@ public:
 
 	Vector3 getPositionChange(int animation) const;
 	float   getFacingChange(int animation) const;
+
+	/**
+	 * Queue the pages of the frames following the given one for reading ahead.
+	 */
+	void queuePrefetch(uint32 animation, uint32 frame);
+	/**
+	 * Read queued pages until the deadline, in the spare time of a frame.
+	 */
+	void prefetchPages(uint32 deadline);
+
+	void   setPrefetchEnabled(bool enabled);
+	bool   isPrefetchEnabled() const { return _prefetchEnabled; }
+	/**
+	 * Limit the number of loaded pages. Zero means no limit, in which case only
+	 * pages unused for a minute are freed.
+	 */
+	void   setPageBudget(uint32 pages);
+	uint32 getPageBudget() const { return _pageBudget; }
+	uint32 getLoadedPageCount() const { return _loadedPageCount; }
+	uint32 getPrefetchQueueLength() const { return _prefetchQueue.size() - _prefetchQueueHead; }
+
+	const PageCacheStats &getPageCacheStats() const { return _stats; }
+	void  resetPageCacheStats() { _stats = PageCacheStats(); }
 };
 
 } // End of namespace BladeRunner
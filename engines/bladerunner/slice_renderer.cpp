@@ -26,6 +26,7 @@
 #include "bladerunner/screen_effects.h"
 #include "bladerunner/set_effects.h"
 #include "bladerunner/slice_animations.h"
+#include "bladerunner/slice_span.h"
 
 #include "common/memstream.h"
 #include "common/rect.h"
@@ -265,6 +266,8 @@ void SliceRenderer::loadFrame(int animation, int frame) {
 	_animation = animation;
 	_frame = frame;
 	_sliceFramePtr = _vm->_sliceAnimations->getFramePtr(_animation, _frame);
+	// Read the next frames ahead, so that they don't stall a later frame
+	_vm->_sliceAnimations->queuePrefetch(_animation, _frame);
 
 	Common::MemoryReadStream stream((byte *)_sliceFramePtr, _vm->_sliceAnimations->_animations[_animation].frameSize);
 
@@ -544,6 +547,12 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 
 	SliceAnimations::Palette &palette = _vm->_sliceAnimations->getPalette(_framePaletteIndex);
 
+	// Spans never reach past kOriginalGameWidth, so on a surface at least that
+	// wide the horizontal clipping of the old per pixel code never triggers
+	// and whole spans can be written through a row pointer.
+	const bool directSpans = surface.w >= BladeRunnerEngine::kOriginalGameWidth;
+	byte *rowPtr = (byte *)surface.getBasePtr(0, CLIP(y, 0, surface.h - 1));
+
 	byte *p = (byte *)_sliceFramePtr + 0x20 + 4 * slice;
 
 	uint32 polyOffset = READ_LE_UINT32(p);
@@ -585,12 +594,14 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 						outColor = _pixelFormat.RGBToColor(Color::get8BitColorFrom5Bit(color.r), Color::get8BitColorFrom5Bit(color.g), Color::get8BitColorFrom5Bit(color.b));
 					}
 
-					for (int x = previousVertexX; x != vertexX; ++x) {
-						if (vertexZ < zbufferLine[x]) {
-							zbufferLine[x] = (uint16)vertexZ;
+					if (!directSpans || !drawSliceSpan(rowPtr, surface.format.bytesPerPixel, zbufferLine, previousVertexX, vertexX, (uint16)vertexZ, outColor)) {
+						for (int x = previousVertexX; x != vertexX; ++x) {
+							if (vertexZ < zbufferLine[x]) {
+								zbufferLine[x] = (uint16)vertexZ;
 
-							void *dstPtr = surface.getBasePtr(CLIP(x, 0, surface.w - 1), CLIP(y, 0, surface.h - 1));
-							drawPixel(surface, dstPtr, outColor);
+								void *dstPtr = surface.getBasePtr(CLIP(x, 0, surface.w - 1), CLIP(y, 0, surface.h - 1));
+								drawPixel(surface, dstPtr, outColor);
+							}
 						}
 					}
 				}
@@ -0,0 +1,61 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BLADERUNNER_SLICE_SPAN_H
+#define BLADERUNNER_SLICE_SPAN_H
+
+#include "common/scummsys.h"
+
+namespace BladeRunner {
+
+// Fills the pixels of a slice span which are nearer than the z-buffer,
+// all with the same depth and color
+template<typename PixelType>
+inline void drawSliceSpan(PixelType *dst, uint16 *zbuffer, int count, uint16 z, uint32 color) {
+	for (int x = 0; x != count; ++x) {
+		if (z < zbuffer[x]) {
+			zbuffer[x] = z;
+			dst[x] = (PixelType)color;
+		}
+	}
+}
+
+// Draws the span [x0, x1) of a slice line through the pointer to the start
+// of the line. Returns false for pixel depths the spans are not written for.
+inline bool drawSliceSpan(byte *rowPtr, int bytesPerPixel, uint16 *zbufferLine, int x0, int x1, uint16 z, uint32 color) {
+	switch (bytesPerPixel) {
+	case 1:
+		drawSliceSpan(rowPtr + x0, zbufferLine + x0, x1 - x0, z, color);
+		return true;
+	case 2:
+		drawSliceSpan((uint16 *)rowPtr + x0, zbufferLine + x0, x1 - x0, z, color);
+		return true;
+	case 4:
+		drawSliceSpan((uint32 *)rowPtr + x0, zbufferLine + x0, x1 - x0, z, color);
+		return true;
+	default:
+		return false;
+	}
+}
+
+} // End of namespace BladeRunner
+
+#endif
@@ -114,6 +114,7 @@ Debugger::Debugger(): GUI::Debugger() {
 
 	registerCmd("draw", WRAP_METHOD(Debugger, cmdDraw));
 	registerCmd("forceredraw", WRAP_METHOD(Debugger, cmdForceRedraw));
+	registerCmd("inkbench", WRAP_METHOD(Debugger, cmdInkBench));
 
 	_nextFrame = false;
 	_nextFrameCounter = 0;
@@ -199,6 +200,7 @@ bool Debugger::cmdHelp(int argc, const char **argv) {
 	debugPrintf("\n");
 	debugPrintf("GFX:\n");
 	debugPrintf(" draw [cast|frame|off] - Draws debug outlines for cast or frame number\n");
+	debugPrintf(" inkbench [iterations] - Times sprite blits for every ink and checks them against the per-pixel renderer\n");
 	return true;
 }
 
@@ -1018,6 +1020,105 @@ bool Debugger::cmdDraw(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmdInkBench(int argc, const char **argv) {
+	static const InkType inks[] = {
+		kInkTypeCopy, kInkTypeTransparent, kInkTypeReverse, kInkTypeGhost,
+		kInkTypeNotCopy, kInkTypeNotTrans, kInkTypeNotReverse, kInkTypeNotGhost,
+		kInkTypeMatte, kInkTypeMask, kInkTypeBlend, kInkTypeAddPin,
+		kInkTypeAdd, kInkTypeSubPin, kInkTypeBackgndTrans, kInkTypeLight,
+		kInkTypeSub, kInkTypeDark
+	};
+
+	int iterations = argc > 1 ? atoi(argv[1]) : 20;
+	if (iterations <= 0) {
+		debugPrintf("Usage: %s [iterations]\n", argv[0]);
+		return true;
+	}
+
+	Graphics::MacWindowManager *wm = g_director->_wm;
+	const Graphics::PixelFormat &format = wm->_pixelformat;
+	const bool clut8 = format.bytesPerPixel == 1;
+	const int width = 320, height = 240;
+
+	// A sprite mixing arbitrary colours with the black and white entries
+	// that the colourized inks look for, plus a round matte mask.
+	Graphics::ManagedSurface sprite(width, height, format);
+	Graphics::Surface mask;
+	mask.create(width, height, Graphics::PixelFormat::createFormatCLUT8());
+
+	for (int y = 0; y < height; y++) {
+		for (int x = 0; x < width; x++) {
+			uint32 color;
+			if ((x + y) % 5 == 0)
+				color = wm->_colorBlack;
+			else if ((x ^ y) % 7 == 0)
+				color = wm->_colorWhite;
+			else if (clut8)
+				color = (x * 3 + y * 5) & 0xff;
+			else
+				color = format.RGBToColor(x * 3, y * 5, x ^ y);
+			sprite.setPixel(x, y, color);
+
+			int dx = x - width / 2, dy = y - height / 2;
+			*(byte *)mask.getBasePtr(x, y) = (dx * dx * 4 + dy * dy * 7 < width * width) ? 1 : 0;
+		}
+	}
+
+	Graphics::ManagedSurface background(width * 2, height * 2, format);
+	for (int y = 0; y < background.h; y++)
+		for (int x = 0; x < background.w; x++)
+			background.setPixel(x, y, clut8 ? (x + y) & 0xff : format.RGBToColor(x, y, 0x80));
+
+	Graphics::ManagedSurface pixelsDst(background.w, background.h, format);
+	Graphics::ManagedSurface spansDst(background.w, background.h, format);
+
+	Common::Rect rect(width, height);
+	rect.moveTo(width / 2, height / 2);
+
+	debugPrintf("Blitting a %dx%d sprite %d times (%d bpp)\n", width, height, iterations, format.bytesPerPixel * 8);
+
+	for (int colorize = 0; colorize < 2; colorize++) {
+		uint32 foreColor = colorize ? wm->findBestColor(0xff, 0x00, 0x00) : wm->_colorBlack;
+		uint32 backColor = colorize ? wm->findBestColor(0x00, 0x00, 0xff) : wm->_colorWhite;
+
+		for (int i = 0; i < ARRAYSIZE(inks); i++) {
+			int alpha = (inks[i] == kInkTypeBlend) ? 0x80 : 0;
+			const Graphics::Surface *inkMask = (inks[i] == kInkTypeMatte || inks[i] == kInkTypeMask) ? &mask : nullptr;
+
+			DirectorPlotData pd(g_director, kBitmapSprite, inks[i], alpha, backColor, foreColor);
+			pd.setApplyColor();
+			pd.srf = &sprite;
+			pd.destRect = rect;
+
+			pixelsDst.blitFrom(background);
+			pd.dst = &pixelsDst;
+			uint32 start = g_system->getMillis();
+			for (int n = 0; n < iterations; n++)
+				pd.inkBlitPixels(rect, inkMask);
+			uint32 pixelsTime = g_system->getMillis() - start;
+
+			spansDst.blitFrom(background);
+			pd.dst = &spansDst;
+			start = g_system->getMillis();
+			for (int n = 0; n < iterations; n++) {
+				if (clut8)
+					pd.inkBlitSpans<byte>(rect, inkMask);
+				else
+					pd.inkBlitSpans<uint32>(rect, inkMask);
+			}
+			uint32 spansTime = g_system->getMillis() - start;
+
+			bool match = !memcmp(pixelsDst.getPixels(), spansDst.getPixels(), spansDst.pitch * spansDst.h);
+
+			debugPrintf("%-14s%s: per-pixel %5d ms, spans %5d ms%s\n", inkType2str(inks[i]),
+					colorize ? " (colorized)" : "", pixelsTime, spansTime, match ? "" : " MISMATCH");
+		}
+	}
+
+	mask.free();
+	return true;
+}
+
 static void forceWindowRedraw(Window *window) {
 	if (!window->getCurrentMovie())
 		return;
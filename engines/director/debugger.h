@@ -123,6 +123,7 @@ private:
 
 	bool cmdDraw(int argc, const char **argv);
 	bool cmdForceRedraw(int argc, const char **argv);
+	bool cmdInkBench(int argc, const char **argv);
 
 	void bpUpdateState();
 	void bpTest(bool forceCheck = false);
@@ -503,6 +503,260 @@ void InkPrimitives<T>::drawPoint(int x, int y, uint32 src, void *data) {
 	}
 }
 
+/**
+ * Row based counterpart of InkPrimitives, used for blitting bitmap sprites.
+ * Everything that stays the same for the whole sprite (the ink, the
+ * colorization colours, the blend factor) is resolved once, so that the
+ * per-pixel work is reduced to a tight loop over a span of pixels.
+ **/
+template <typename T>
+class InkSpanBlitter {
+public:
+	InkSpanBlitter(DirectorPlotData *p);
+	void blit(T *dst, const T *src, int width);
+
+private:
+	inline void decompose(uint32 color, byte &r, byte &g, byte &b) const;
+	inline T compose(byte r, byte g, byte b) const;
+
+	void blitApplyColor(T *dst, const T *src, int width, bool inverse);
+	void blitArithmetic(T *dst, const T *src, int width);
+
+	DirectorPlotData *_p;
+	Graphics::MacWindowManager *_wm;
+	const byte *_palette;
+	Graphics::PixelFormat _format;
+
+	byte _rFor, _gFor, _bFor;
+	byte _rBak, _gBak, _bBak;
+};
+
+template <typename T>
+InkSpanBlitter<T>::InkSpanBlitter(DirectorPlotData *p) : _p(p), _wm(p->d->_wm) {
+	_palette = _wm->getPalette();
+	_format = _wm->_pixelformat;
+
+	// Only needed for colourizing 32-bit sprites
+	_rFor = _gFor = _bFor = 0;
+	_rBak = _gBak = _bBak = 0;
+	if (sizeof(T) != 1) {
+		decompose(p->foreColor, _rFor, _gFor, _bFor);
+		decompose(p->backColor, _rBak, _gBak, _bBak);
+	}
+}
+
+template <>
+inline void InkSpanBlitter<byte>::decompose(uint32 color, byte &r, byte &g, byte &b) const {
+	r = _palette[3 * (byte)color + 0];
+	g = _palette[3 * (byte)color + 1];
+	b = _palette[3 * (byte)color + 2];
+}
+
+template <>
+inline void InkSpanBlitter<uint32>::decompose(uint32 color, byte &r, byte &g, byte &b) const {
+	_format.colorToRGB(color, r, g, b);
+}
+
+template <>
+inline byte InkSpanBlitter<byte>::compose(byte r, byte g, byte b) const {
+	return _wm->findBestColor(r, g, b);
+}
+
+template <>
+inline uint32 InkSpanBlitter<uint32>::compose(byte r, byte g, byte b) const {
+	return _format.RGBToColor(r, g, b);
+}
+
+template <typename T>
+void InkSpanBlitter<T>::blit(T *dst, const T *src, int width) {
+	const T *end = src + width;
+
+	if (_p->alpha) {
+		// Sprite blend does not respect colourization; defaults to matte ink
+		const int alpha = _p->alpha;
+		byte rSrc, gSrc, bSrc;
+		byte rDst, gDst, bDst;
+
+		for (; src < end; src++, dst++) {
+			decompose(*src, rSrc, gSrc, bSrc);
+			decompose(*dst, rDst, gDst, bDst);
+			*dst = compose(lerpByte(rSrc, rDst, alpha, 255), lerpByte(gSrc, gDst, alpha, 255), lerpByte(bSrc, bDst, alpha, 255));
+		}
+		return;
+	}
+
+	const uint32 foreColor = _p->foreColor;
+	const uint32 backColor = _p->backColor;
+	const uint32 colorBlack = _p->colorBlack;
+	const uint32 colorWhite = _p->colorWhite;
+	const bool mono = _p->oneBitImage || _p->applyColor;
+
+	switch (_p->ink) {
+	case kInkTypeBackgndTrans:
+		if (_p->oneBitImage) {
+			for (; src < end; src++, dst++)
+				if (*src == colorBlack)
+					*dst = foreColor;
+		} else {
+			for (; src < end; src++, dst++)
+				if (*src != backColor)
+					*dst = *src;
+		}
+		break;
+	case kInkTypeMatte:
+	case kInkTypeMask:
+	case kInkTypeBlend:
+	case kInkTypeCopy:
+		if (_p->applyColor)
+			blitApplyColor(dst, src, width, false);
+		else
+			memcpy(dst, src, width * sizeof(T));
+		break;
+	case kInkTypeNotCopy:
+		if (_p->applyColor) {
+			blitApplyColor(dst, src, width, true);
+		} else {
+			// Find the inverse of the colour and match it back to the palette if required
+			byte rSrc, gSrc, bSrc;
+			for (; src < end; src++, dst++) {
+				decompose(*src, rSrc, gSrc, bSrc);
+				*dst = compose(~rSrc, ~gSrc, ~bSrc);
+			}
+		}
+		break;
+	case kInkTypeTransparent:
+		if (mono) {
+			for (; src < end; src++, dst++)
+				if (*src == colorBlack)
+					*dst = foreColor;
+		} else {
+			for (; src < end; src++, dst++)
+				*dst |= *src;
+		}
+		break;
+	case kInkTypeNotTrans:
+		if (mono) {
+			for (; src < end; src++, dst++)
+				if (*src == colorWhite)
+					*dst = foreColor;
+		} else {
+			for (; src < end; src++, dst++)
+				*dst |= (T)~*src;
+		}
+		break;
+	case kInkTypeReverse:
+		for (; src < end; src++, dst++)
+			*dst ^= *src;
+		break;
+	case kInkTypeNotReverse:
+		for (; src < end; src++, dst++)
+			*dst ^= (T)~*src;
+		break;
+	case kInkTypeGhost:
+		if (mono) {
+			for (; src < end; src++, dst++)
+				if (*src == colorBlack)
+					*dst = backColor;
+		} else {
+			for (; src < end; src++, dst++)
+				*dst &= (T)~*src;
+		}
+		break;
+	case kInkTypeNotGhost:
+		if (mono) {
+			for (; src < end; src++, dst++)
+				if (*src == colorWhite)
+					*dst = backColor;
+		} else {
+			for (; src < end; src++, dst++)
+				*dst &= *src;
+		}
+		break;
+	default:
+		blitArithmetic(dst, src, width);
+		break;
+	}
+}
+
+template <typename T>
+void InkSpanBlitter<T>::blitApplyColor(T *dst, const T *src, int width, bool inverse) {
+	const T *end = src + width;
+
+	if (sizeof(T) == 1) {
+		const T white = inverse ? _p->foreColor : _p->backColor;
+		const T black = inverse ? _p->backColor : _p->foreColor;
+
+		for (; src < end; src++, dst++) {
+			if (*src == 0xff)
+				*dst = black;
+			else if (*src == 0x00)
+				*dst = white;
+			else if (inverse)
+				*dst = *src;
+		}
+		return;
+	}
+
+	byte rSrc, gSrc, bSrc;
+	for (; src < end; src++, dst++) {
+		decompose(*src, rSrc, gSrc, bSrc);
+		if (inverse) {
+			rSrc = ~rSrc;
+			gSrc = ~gSrc;
+			bSrc = ~bSrc;
+		}
+		*dst = compose((rSrc | _rFor) & (~rSrc | _rBak),
+					   (gSrc | _gFor) & (~gSrc | _gBak),
+					   (bSrc | _bFor) & (~bSrc | _bBak));
+	}
+}
+
+template <typename T>
+void InkSpanBlitter<T>::blitArithmetic(T *dst, const T *src, int width) {
+	// Arithmetic ink types, based on real color values
+	const T *end = src + width;
+	byte rSrc, gSrc, bSrc;
+	byte rDst, gDst, bDst;
+
+#define ARITHMETIC_INK(r, g, b) \
+	for (; src < end; src++, dst++) { \
+		decompose(*src, rSrc, gSrc, bSrc); \
+		decompose(*dst, rDst, gDst, bDst); \
+		*dst = compose(r, g, b); \
+	}
+
+	switch (_p->ink) {
+	case kInkTypeAddPin:
+		// Add src to dst, but pinning each channel so it can't go above 0xff.
+		ARITHMETIC_INK(rDst + MIN(0xff - rDst, (int)rSrc), gDst + MIN(0xff - gDst, (int)gSrc), bDst + MIN(0xff - bDst, (int)bSrc));
+		break;
+	case kInkTypeAdd:
+		// Add src to dst, allowing each channel to overflow and wrap around.
+		ARITHMETIC_INK(rDst + rSrc, gDst + gSrc, bDst + bSrc);
+		break;
+	case kInkTypeSubPin:
+		// Subtract src from dst, but pinning each channel so it can't go below 0x00.
+		ARITHMETIC_INK(MAX(rDst - rSrc, 1) - 1, MAX(gDst - gSrc, 1) - 1, MAX(bDst - bSrc, 1) - 1);
+		break;
+	case kInkTypeLight:
+		// Pick the higher of src and dst for each channel, lightening the image.
+		ARITHMETIC_INK(MAX(rSrc, rDst), MAX(gSrc, gDst), MAX(bSrc, bDst));
+		break;
+	case kInkTypeSub:
+		// Subtract src from dst, allowing each channel to underflow and wrap around.
+		ARITHMETIC_INK(rDst - rSrc, gDst - gSrc, bDst - bSrc);
+		break;
+	case kInkTypeDark:
+		// Pick the lower of src and dst for each channel, darkening the image.
+		ARITHMETIC_INK(MIN(rSrc, rDst), MIN(gSrc, gDst), MIN(bSrc, bDst));
+		break;
+	default:
+		break;
+	}
+
+#undef ARITHMETIC_INK
+}
+
 Graphics::Primitives *DirectorEngine::getInkPrimitives() {
 	if (!_primitives) {
 		if (_pixelformat.bytesPerPixel == 1)
@@ -734,6 +988,26 @@ void DirectorPlotData::inkBlitSurface(Common::Rect &srcRect, const Graphics::Sur
 	// format as the window manager. Most of the time this is
 	// the job of BitmapCastMember::createWidget.
 
+	if (ms)
+		failedBoundsCheck = inkBlitPixels(srcRect, mask);
+	else if (d->_wm->_pixelformat.bytesPerPixel == 1)
+		failedBoundsCheck = inkBlitSpans<byte>(srcRect, mask);
+	else
+		failedBoundsCheck = inkBlitSpans<uint32>(srcRect, mask);
+
+	if (failedBoundsCheck) {
+		warning("DirectorPlotData::inkBlitSurface: Out of bounds - srfClip: %d,%d,%d,%d, srcRect: %d,%d,%d,%d, dstRect: %d,%d,%d,%d",
+				srfClip.left, srfClip.top, srfClip.right, srfClip.bottom,
+				srcRect.left, srcRect.top, srcRect.right, srcRect.bottom,
+				destRect.left, destRect.top, destRect.right, destRect.bottom);
+	}
+
+}
+
+bool DirectorPlotData::inkBlitPixels(Common::Rect &srcRect, const Graphics::Surface *mask) {
+	Common::Rect srfClip = srf->getBounds();
+	bool failedBoundsCheck = false;
+
 	Graphics::Primitives *primitives = g_director->getInkPrimitives();
 
 	srcPoint.y = abs(srcRect.top - destRect.top);
@@ -759,13 +1033,62 @@ void DirectorPlotData::inkBlitSurface(Common::Rect &srcRect, const Graphics::Sur
 		}
 	}
 
-	if (failedBoundsCheck) {
-		warning("DirectorPlotData::inkBlitSurface: Out of bounds - srfClip: %d,%d,%d,%d, srcRect: %d,%d,%d,%d, dstRect: %d,%d,%d,%d",
-				srfClip.left, srfClip.top, srfClip.right, srfClip.bottom,
-				srcRect.left, srcRect.top, srcRect.right, srcRect.bottom,
-				destRect.left, destRect.top, destRect.right, destRect.bottom);
+	return failedBoundsCheck;
+}
+
+template <typename T>
+bool DirectorPlotData::inkBlitSpans(Common::Rect &srcRect, const Graphics::Surface *mask) {
+	// Clip the blit against the source surface once, instead of per pixel
+	const int srcX = abs(srcRect.left - destRect.left);
+	const int srcY = abs(srcRect.top - destRect.top);
+	const int width = CLIP<int>(srf->w - srcX, 0, destRect.width());
+	const int height = CLIP<int>(srf->h - srcY, 0, destRect.height());
+	bool failedBoundsCheck = !destRect.isEmpty() && (width < destRect.width() || height < destRect.height());
+
+	if (width <= 0 || height <= 0)
+		return failedBoundsCheck;
+
+	InkSpanBlitter<T> blitter(this);
+
+	// Text sprites get their colours adjusted before the ink is applied
+	const bool preprocess = (sprite == kTextSprite);
+	Common::Array<T> row(preprocess ? width : 0);
+
+	for (int i = 0; i < height; i++) {
+		T *dstPtr = (T *)dst->getBasePtr(destRect.left, destRect.top + i);
+		const T *srcPtr = (const T *)srf->getBasePtr(srcX, srcY + i);
+
+		if (preprocess) {
+			for (int j = 0; j < width; j++)
+				row[j] = preprocessColor(srcPtr[j]);
+			srcPtr = row.data();
+		}
+
+		if (!mask) {
+			blitter.blit(dstPtr, srcPtr, width);
+			continue;
+		}
+
+		// Only the unmasked runs of the row are drawn
+		const byte *msk = (const byte *)mask->getBasePtr(srcX, srcY + i);
+		int j = 0;
+		while (j < width) {
+			while (j < width && !msk[j])
+				j++;
+
+			int start = j;
+			while (j < width && msk[j])
+				j++;
+
+			if (j > start)
+				blitter.blit(dstPtr + start, srcPtr + start, j - start);
+		}
 	}
 
+	return failedBoundsCheck;
 }
 
+template bool DirectorPlotData::inkBlitSpans<byte>(Common::Rect &srcRect, const Graphics::Surface *mask);
+template bool DirectorPlotData::inkBlitSpans<uint32>(Common::Rect &srcRect, const Graphics::Surface *mask);
+
 } // End of namespace Director
@@ -42,11 +42,13 @@
 #include "director/frame.h"
 #include "director/score.h"
 #include "director/movie.h"
+#include "director/picture.h"
 #include "director/sound.h"
 #include "director/channel.h"
 #include "director/sprite.h"
 #include "director/window.h"
 #include "director/castmember/castmember.h"
+#include "director/castmember/bitmap.h"
 #include "director/castmember/filmloop.h"
 #include "director/castmember/transition.h"
 
@@ -91,6 +93,9 @@ Score::Score(Movie *movie) {
 	_curFrameNumber = 1;
 	_framesStream = nullptr;
 	_currentFrame = nullptr;
+
+	_prefetchFrame = 0;
+	_prefetchCacheSize = 0;
 }
 
 Score::~Score() {
@@ -590,6 +595,9 @@ void Score::update() {
 			// like "go to frame", or open a new movie.
 			if (!_nextFrame) {
 				processFrozenScripts();
+
+				// Use the rest of the wait to decode what the next frames need
+				prefetchCastMembers();
 			}
 			return;
 		}
@@ -1598,6 +1606,9 @@ uint16 Score::getSpriteIdByMemberId(CastMemberID id) {
 }
 
 bool Score::refreshPointersForCastMemberID(CastMemberID id) {
+	// The member was changed from Lingo, so it is no longer ours to drop
+	releasePrefetchedMember(id, false);
+
 	// FIXME: This can be removed once Sprite is refactored to not
 	// keep a pointer to a CastMember.
 	bool hit = false;
@@ -1621,6 +1632,14 @@ bool Score::refreshPointersForCastMemberID(CastMemberID id) {
 }
 
 bool Score::refreshPointersForCastLib(uint16 castLib) {
+	Common::Array<CastMemberID> released;
+	for (auto &it : _prefetchCache) {
+		if (it._key.castLib == castLib)
+			released.push_back(it._key);
+	}
+	for (auto &it : released)
+		releasePrefetchedMember(it, false);
+
 	// FIXME: This can be removed once Sprite is refactored to not
 	// keep a pointer to a CastMember.
 	bool hit = false;
@@ -1894,6 +1913,123 @@ Frame *Score::getFrameData(int frameNum){
 	return nullptr;
 }
 
+// How many frames ahead of the playhead bitmaps are decoded, and how much
+// decoded image data may be held for frames which are not on stage yet.
+static const int kPrefetchFrames = 8;
+static const uint32 kPrefetchCacheLimit = 32 * 1024 * 1024;
+
+static CastMember *peekCastMember(Movie *movie, CastMemberID id) {
+	Cast *cast = movie->getCast(id);
+	CastMember *member = cast ? cast->getCastMember(id.member, false) : nullptr;
+
+	if (!member && movie->getSharedCast())
+		member = movie->getSharedCast()->getCastMember(id.member, false);
+
+	return member;
+}
+
+void Score::prefetchCastMembers() {
+	if (_playState != kPlayStarted || !_framesStream || !_currentFrame)
+		return;
+
+	if (_prefetchFrame != _curFrameNumber)
+		scanPrefetchFrames();
+
+	while (!_prefetchQueue.empty() && _prefetchCacheSize < kPrefetchCacheLimit) {
+		CastMemberID id = _prefetchQueue.remove_at(0);
+		CastMember *member = peekCastMember(_movie, id);
+
+		if (!member || member->_type != kCastBitmap || member->isLoaded())
+			continue;
+
+		// Go through the movie, so that the cast serializes archive access
+		_movie->getCastMember(id);
+		if (!member->isLoaded())
+			continue;
+
+		const Graphics::Surface &surface = ((BitmapCastMember *)member)->_picture->_surface;
+		uint32 size = surface.pitch * surface.h;
+
+		_prefetchCache[id] = size;
+		_prefetchCacheSize += size;
+
+		debugC(5, kDebugLoading, "Score::prefetchCastMembers(): Decoded %s ahead of frame %d, %d bytes cached",
+			id.asString().c_str(), _curFrameNumber, _prefetchCacheSize);
+
+		// One bitmap per update, so we don't overrun the wait for the next frame
+		break;
+	}
+}
+
+void Score::scanPrefetchFrames() {
+	_prefetchFrame = _curFrameNumber;
+	_prefetchQueue.clear();
+
+	// Whatever made it on stage is a regular loaded member now
+	for (auto &it : _channels)
+		releasePrefetchedMember(it->_sprite->_castId, false);
+
+	// Read the upcoming frames into a scratch copy of the current one,
+	// then rewind the frames stream so playback is not affected
+	Common::HashMap<CastMemberID, bool> upcoming;
+	int64 framesPos = _framesStream->pos();
+	Frame *currentFrame = _currentFrame;
+	_currentFrame = new Frame(*currentFrame);
+
+	for (int i = 0; i < kPrefetchFrames && readOneFrame(); i++) {
+		for (auto &sprite : _currentFrame->_sprites) {
+			CastMemberID id = sprite->_castId;
+			if (id.member <= 0 || upcoming.contains(id))
+				continue;
+
+			upcoming[id] = true;
+			if (!_prefetchCache.contains(id))
+				_prefetchQueue.push_back(id);
+		}
+	}
+
+	delete _currentFrame;
+	_currentFrame = currentFrame;
+	_framesStream->seek(framesPos);
+
+	// Give back the bitmaps decoded for frames that are no longer coming up,
+	// e.g. after a jump, and forget the ones that were modified meanwhile
+	Common::Array<CastMemberID> stale, modified;
+	for (auto &it : _prefetchCache) {
+		CastMember *member = peekCastMember(_movie, it._key);
+		if (!member || member->isModified())
+			modified.push_back(it._key);
+		else if (!upcoming.contains(it._key))
+			stale.push_back(it._key);
+	}
+
+	for (auto &it : modified)
+		releasePrefetchedMember(it, false);
+	for (auto &it : stale)
+		releasePrefetchedMember(it, true);
+}
+
+void Score::releasePrefetchedMember(CastMemberID id, bool unload) {
+	if (!_prefetchCache.contains(id))
+		return;
+
+	_prefetchCacheSize -= _prefetchCache[id];
+	_prefetchCache.erase(id);
+
+	if (!unload)
+		return;
+
+	// Only drop the bitmap if nothing started using it in the meantime
+	for (auto &it : _channels) {
+		if (it->_sprite->_castId == id)
+			return;
+	}
+
+	CastMember *member = peekCastMember(_movie, id);
+	if (member && member->_type == kCastBitmap && !member->isModified())
+		member->unload();
+}
+
 void Score::setSpriteCasts() {
 	// Update sprite cache of cast pointers/info
 	for (uint16 j = 0; j < _currentFrame->_sprites.size(); j++) {
@@ -150,6 +150,10 @@ private:
 	bool processImmediateFrameScript(Common::String s, int id);
 	bool processFrozenScripts(bool recursion = false, int count = 0);
 
+	void prefetchCastMembers();
+	void scanPrefetchFrames();
+	void releasePrefetchedMember(CastMemberID id, bool unload);
+
 public:
 	Common::Array<Channel *> _channels;
 	Common::SortedArray<Label *> *_labels;
@@ -208,6 +212,12 @@ private:
 	DirectorSound *_soundManager;
 
 	int _previousBuildBotBuild = -1;
+
+	// Bitmaps decoded ahead of the frames that use them
+	uint32 _prefetchFrame;
+	Common::Array<CastMemberID> _prefetchQueue;
+	Common::HashMap<CastMemberID, uint32> _prefetchCache;
+	uint32 _prefetchCacheSize;
 };
 
 } // End of namespace Director
@@ -0,0 +1,62 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "glk/glulx/debugger.h"
+#include "glk/glulx/glulx.h"
+
+namespace Glk {
+namespace Glulx {
+
+Debugger::Debugger() : Glk::Debugger() {
+	registerCmd("decodecache", WRAP_METHOD(Debugger, cmdDecodeCache));
+}
+
+bool Debugger::cmdDecodeCache(int argc, const char **argv) {
+	if (argc == 2 && !strcmp(argv[1], "on")) {
+		g_vm->setDecodeCache(true);
+		g_vm->resetDecodeStats();
+	} else if (argc == 2 && !strcmp(argv[1], "off")) {
+		g_vm->setDecodeCache(false);
+		g_vm->resetDecodeStats();
+	} else if (argc == 2 && !strcmp(argv[1], "reset")) {
+		g_vm->resetDecodeStats();
+	} else if (argc != 1) {
+		debugPrintf("decodecache [on | off | reset]\n");
+		return true;
+	}
+
+	const decodestats_t &stats = g_vm->getDecodeStats();
+	uint lookups = stats.hits + stats.misses;
+
+	debugPrintf("Decode cache is %s\n", g_vm->isDecodeCacheEnabled() ? "on" : "off");
+	debugPrintf("Hits %u, misses %u (%u%% hit rate), flushes %u\n", stats.hits, stats.misses,
+		lookups ? (uint)((uint64)stats.hits * 100 / lookups) : 0, stats.flushes);
+
+	if (stats.turns) {
+		debugPrintf("%u turns, average %u ms and %u instructions per turn\n", stats.turns,
+			stats.turnmillis / stats.turns, (uint)(stats.turnops / stats.turns));
+	}
+
+	return true;
+}
+
+} // End of namespace Glulx
+} // End of namespace Glk
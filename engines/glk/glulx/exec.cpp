@@ -20,6 +20,7 @@
  */
 
 #include "glk/glulx/glulx.h"
+#include "common/system.h"
 
 namespace Glk {
 namespace Glulx {
@@ -38,6 +39,8 @@ void Glulx::execute_loop() {
 	gfloat32 valf, valf1, valf2;
 #endif /* FLOAT_SUPPORT */
 
+	decode_turnstart = g_system->getMillis();
+
 	while (!done_executing && !g_vm->shouldQuit()) {
 
 		profile_tick();
@@ -47,6 +50,18 @@ void Glulx::execute_loop() {
 
 		/* Stash the current opcode's address, in case the interpreter needs to serialize the VM state out-of-band. */
 		prevpc = pc;
+		decode_stats.turnops++;
+
+		if (decode_cache_enabled) {
+			/* The instruction has (most likely) been run before, so its opcode and
+			   the operand addressing have already been worked out. */
+			const decodedop_t *decoded = lookup_decoded(pc);
+			opcode = decoded->opcode;
+			oplist = decoded->oplist;
+			fetch_decoded_operands(inst, decoded);
+			pc = decoded->nextpc;
+			goto Execute;
+		}
 
 		/* Fetch the opcode number. */
 		opcode = Mem1(pc);
@@ -87,6 +102,7 @@ void Glulx::execute_loop() {
 		   into inst. This moves the PC up to the end of the instruction. */
 		parse_operands(inst, oplist);
 
+Execute:
 		/* Perform the opcode. This switch statement is split in two, based
 		   on some paranoid suspicions about the ability of compilers to
 		   optimize large-range switches. Ignore that. */
@@ -635,7 +651,14 @@ PerformJump: /* goto label for successful jumping... ironic, no? */
 				profile_in(0xF0000000 + inst[0].value, stackptr, false);
 				value = inst[1].value;
 				arglist = pop_arguments(value, 0);
+				if (inst[0].value == 0x00C0) {
+					/* glk_select() ends the turn; count how long the VM ran for it. */
+					decode_stats.turns++;
+					decode_stats.turnmillis += g_system->getMillis() - decode_turnstart;
+				}
 				val0 = perform_glk(inst[0].value, value, arglist);
+				if (inst[0].value == 0x00C0)
+					decode_turnstart = g_system->getMillis();
 #ifdef TOLERATE_SUPERGLUS_BUG
 				if (inst[2].desttype == 1 && inst[2].value == 0)
 					inst[2].desttype = 0;
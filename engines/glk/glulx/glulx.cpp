@@ -20,6 +20,7 @@
  */
 
 #include "glk/glulx/glulx.h"
+#include "glk/glulx/debugger.h"
 #include "common/config-manager.h"
 #include "common/translation.h"
 
@@ -42,11 +43,16 @@ Glulx::Glulx(OSystem *syst, const GlkGameDescription &gameDesc) : GlkAPI(syst, g
 		accelentries(nullptr),
 		// heap
 		heap_start(0), alloc_count(0), heap_head(nullptr), heap_tail(nullptr),
+		// operand
+		decode_cache_enabled(true), decode_generation(1), decode_ramlo(0xFFFFFFFF), decode_ramhi(0),
+		decode_turnstart(0),
 		// serial
 		max_undo_level(8), undo_chain_size(0), undo_chain_num(0), undo_chain(nullptr), ramcache(nullptr),
+		undo_ramimage(nullptr), undo_ramend(0),
 		// string
 		iosys_mode(0), iosys_rock(0), tablecache_valid(false), glkio_unichar_han_ptr(nullptr) {
 	g_vm = this;
+	memset(&decode_stats, 0, sizeof(decode_stats));
 
 	glkopInit();
 }
@@ -76,6 +82,10 @@ void Glulx::runGame() {
 	profile_quit();
 }
 
+void Glulx::createDebugger() {
+	setDebugger(new Debugger());
+}
+
 bool Glulx::is_gamefile_valid() {
 	if (_gameFile.size() < 8) {
 		GUIErrorMessage(_("This is too short to be a valid Glulx file."));
@@ -25,6 +25,7 @@
 #define GLK_GLULXE
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/random.h"
 #include "glk/glk_api.h"
 #include "glk/glulx/glulx_types.h"
@@ -145,6 +146,22 @@ private:
 	 */
 	const operandlist_t *fast_operandlist[0x80];
 
+	/**
+	 * Instructions which have already been decoded, indexed by address. An entry is only valid if its
+	 * generation matches decode_generation, so flushing the cache just bumps the generation.
+	 */
+	Common::Array<decodedop_t> decode_cache;
+	bool decode_cache_enabled;
+	uint decode_generation;
+
+	/**
+	 * The range of RAM addresses covered by cached instructions. Writes to it flush the cache.
+	 */
+	uint decode_ramlo, decode_ramhi;
+
+	decodestats_t decode_stats;
+	uint decode_turnstart;
+
 	/**@}*/
 
 	/**
@@ -166,6 +183,14 @@ private:
 	 */
 	byte *ramcache;
 
+	/**
+	 * A copy of RAM (ramstart to undo_ramend) as it was when the most recent undo state was saved.
+	 * Each undo state only holds the pages which differ between it and the state before it, so this
+	 * is what the chain is rebuilt from. It's only meaningful while undo_chain_num is nonzero.
+	 */
+	byte *undo_ramimage;
+	uint undo_ramend;
+
 	/**@}*/
 
 	/**
@@ -357,6 +382,16 @@ protected:
 	uint read_memstate(dest_t *dest, uint chunklen);
 	uint read_heapstate(dest_t *dest, uint chunklen, int portable, uint *sumlen, uint **summary);
 	uint read_stackstate(dest_t *dest, uint chunklen, int portable);
+
+	/**
+	 * Write the RAM pages which changed since the previous undo state, and bring undo_ramimage up to date.
+	 */
+	uint write_undo_memstate(dest_t *dest);
+
+	/**
+	 * Reset RAM to undo_ramimage, then step undo_ramimage back to the previous undo state.
+	 */
+	uint read_undo_memstate(dest_t *dest, uint chunklen);
 	uint write_heapstate_sub(uint sumlen, uint *sumarray, dest_t *dest, int portable);
 	static int sort_heap_summary(const void *p1, const void *p2);
 
@@ -392,6 +427,11 @@ protected:
 	void dumpcache(cacheblock_t *cablist, int count, int indent);
 
 	/**@}*/
+protected:
+	/**
+	 * Create the debugger
+	 */
+	void createDebugger() override;
 public:
 	/**
 	 * Constructor
@@ -431,6 +471,30 @@ public:
 	 */
 	Common::Error writeGameData(Common::WriteStream *ws) override;
 
+	/**
+	 * Turns the decode cache on or off
+	 */
+	void setDecodeCache(bool enabled);
+
+	/**
+	 * Returns true if instructions are run from the decode cache
+	 */
+	bool isDecodeCacheEnabled() const {
+		return decode_cache_enabled;
+	}
+
+	/**
+	 * Returns the decode cache and turn time counters
+	 */
+	const decodestats_t &getDecodeStats() const {
+		return decode_stats;
+	}
+
+	/**
+	 * Clears the decode cache and turn time counters
+	 */
+	void resetDecodeStats();
+
 	/**
 	 * \defgroup Main access methods
 	 * @{
@@ -551,6 +615,28 @@ public:
 	*/
 	void parse_operands(oparg_t *opargs, const operandlist_t *oplist);
 
+	/**
+	 * Return the decoded form of the instruction at addr, decoding it into the cache if necessary.
+	 */
+	const decodedop_t *lookup_decoded(uint addr);
+
+	/**
+	 * Decode the instruction at addr into op, without touching the stack or the PC.
+	 */
+	void decode_instruction(decodedop_t *op, uint addr);
+
+	/**
+	 * The decode cache equivalent of parse_operands(). The PC is left alone; the caller moves it
+	 * on to op->nextpc.
+	 */
+	void fetch_decoded_operands(oparg_t *opargs, const decodedop_t *op);
+
+	/**
+	 * Invalidate every cached instruction. This must be called whenever memory which may hold code
+	 * is changed behind the back of the MemW macros.
+	 */
+	void flush_decode_cache();
+
 	/**
 	 * Store a result value, according to the desttype and destaddress given. This is usually used to store
 	 * the result of an opcode, but it's also used by any code that pulls a call-stub off the stack.
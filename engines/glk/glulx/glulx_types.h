@@ -91,9 +91,15 @@ class Glulx;
 #define Mem1(adr)  (Read1(memmap+(adr)))
 #define Mem2(adr)  (Read2(memmap+(adr)))
 #define Mem4(adr)  (Read4(memmap+(adr)))
-#define MemW1(adr, vl)  (VerifyW(adr, 1), Write1(memmap+(adr), (vl)))
-#define MemW2(adr, vl)  (VerifyW(adr, 2), Write2(memmap+(adr), (vl)))
-#define MemW4(adr, vl)  (VerifyW(adr, 4), Write4(memmap+(adr), (vl)))
+#define MemW1(adr, vl)  (VerifyW(adr, 1), DecodeW(adr, 1), Write1(memmap+(adr), (vl)))
+#define MemW2(adr, vl)  (VerifyW(adr, 2), DecodeW(adr, 2), Write2(memmap+(adr), (vl)))
+#define MemW4(adr, vl)  (VerifyW(adr, 4), DecodeW(adr, 4), Write4(memmap+(adr), (vl)))
+
+/**
+ * Writing over an instruction which has been decoded into the decode cache throws the cache away.
+ * Only code in RAM can be hit by this; ROM can't be written.
+ */
+#define DecodeW(adr, ln) ((adr) < decode_ramhi && (adr) + (ln) > decode_ramlo ? flush_decode_cache() : (void)0)
 
 #ifndef _HUGE_ENUF
 #define _HUGE_ENUF  1e+300  // _HUGE_ENUF*_HUGE_ENUF must overflow
@@ -351,6 +357,50 @@ typedef oparg_struct oparg_t;
 
 #define MAX_OPERANDS (8)
 
+/**
+ * How an operand of a decoded instruction is fetched. Everything that can be worked out from the
+ * instruction bytes alone is resolved when the instruction is decoded.
+ */
+enum decodedkind {
+	decoded_Const = 0,  ///< The value is the constant itself
+	decoded_Pop = 1,    ///< Pop the value off the stack
+	decoded_Mem = 2,    ///< The value is an absolute main memory address
+	decoded_Local = 3,  ///< The value is an offset into the locals segment
+	decoded_Store = 4   ///< The desttype and value are final
+};
+
+/**
+ * An instruction as it is held in the decode cache.
+ */
+struct decodedop_struct {
+	uint pc;                            ///< Address of the instruction
+	uint generation;                    ///< Cache generation the entry was decoded in
+	uint opcode;
+	uint nextpc;                        ///< Address of the following instruction
+	const operandlist_t *oplist;
+	byte kinds[MAX_OPERANDS];           ///< A decodedkind for each operand
+	oparg_t args[MAX_OPERANDS];
+};
+typedef decodedop_struct decodedop_t;
+
+/**
+ * Counters for the decode cache, and the time spent running VM code between two glk_select calls.
+ */
+struct decodestats_struct {
+	uint hits;
+	uint misses;
+	uint flushes;
+	uint turns;
+	uint turnmillis;
+	uint64 turnops;
+};
+typedef decodestats_struct decodestats_t;
+
+/**
+ * Number of entries in the decode cache. It's direct-mapped on the instruction address.
+ */
+#define DECODE_CACHE_SIZE (0x4000)
+
 typedef uint(Glulx::*acceleration_func)(uint argc, uint *argv);
 
 struct accelentry_struct {
@@ -372,6 +422,12 @@ struct heapblock_struct {
 };
 typedef heapblock_struct heapblock_t;
 
+/**
+ * Granularity of the RAM comparison done when saving undo states. RAM boundaries are always
+ * 256-byte aligned.
+ */
+#define UNDO_PAGE_SIZE (0x100)
+
 /**
  * This structure allows us to write either to a Glk stream or to a dynamically-allocated memory chunk.
  */
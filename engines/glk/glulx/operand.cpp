@@ -20,6 +20,7 @@
  */
 
 #include "glk/glulx/glulx.h"
+#include "common/system.h"
 
 namespace Glk {
 namespace Glulx {
@@ -66,6 +67,10 @@ static const operandlist_t list_LLSS = { 4, 4, &array_LLSS[0] };
 void Glulx::init_operands() {
 	for (int ix = 0; ix < 0x80; ix++)
 		fast_operandlist[ix] = lookup_operandlist(ix);
+
+	decode_cache.clear();
+	decode_cache.resize(DECODE_CACHE_SIZE);
+	flush_decode_cache();
 }
 
 const operandlist_t *Glulx::lookup_operandlist(uint opcode) {
@@ -516,6 +521,273 @@ WrLocalsAddr:
 	}
 }
 
+const decodedop_t *Glulx::lookup_decoded(uint addr) {
+	decodedop_t *op = &decode_cache[(addr ^ (addr >> 14)) & (DECODE_CACHE_SIZE - 1)];
+
+	if (op->pc == addr && op->generation == decode_generation) {
+		decode_stats.hits++;
+		return op;
+	}
+
+	decode_stats.misses++;
+	decode_instruction(op, addr);
+
+	/* Code in RAM can be overwritten, so remember where it is. */
+	if (addr >= ramstart) {
+		if (addr < decode_ramlo)
+			decode_ramlo = addr;
+		if (op->nextpc > decode_ramhi)
+			decode_ramhi = op->nextpc;
+	}
+
+	return op;
+}
+
+void Glulx::decode_instruction(decodedop_t *op, uint addr) {
+	const operandlist_t *oplist;
+	uint opcode;
+	uint modeaddr;
+	int modeval = 0;
+
+	op->generation = 0;
+	op->pc = addr;
+
+	/* This is the same decoding as in execute_loop() and parse_operands(),
+	   except that nothing which depends on the machine state is read. */
+	opcode = Mem1(addr);
+	addr++;
+	if (opcode & 0x80) {
+		if (opcode & 0x40) {
+			opcode &= 0x3F;
+			opcode = (opcode << 8) | Mem1(addr);
+			opcode = (opcode << 8) | Mem1(addr + 1);
+			opcode = (opcode << 8) | Mem1(addr + 2);
+			addr += 3;
+		} else {
+			opcode &= 0x7F;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+		}
+	}
+
+	if (opcode < 0x80)
+		oplist = fast_operandlist[opcode];
+	else
+		oplist = lookup_operandlist(opcode);
+
+	if (!oplist)
+		fatal_error_i("Encountered unknown opcode.", opcode);
+
+	modeaddr = addr;
+	addr += (oplist->num_ops + 1) / 2;
+
+	for (int ix = 0; ix < oplist->num_ops; ix++) {
+		int mode;
+		uint value = 0;
+		byte kind;
+
+		if ((ix & 1) == 0) {
+			modeval = Mem1(modeaddr);
+			mode = (modeval & 0x0F);
+		} else {
+			mode = ((modeval >> 4) & 0x0F);
+			modeaddr++;
+		}
+
+		switch (mode) {
+		case 0:
+		case 8:
+			break;
+		case 1:
+		case 5:
+		case 9:
+		case 13:
+			value = Mem1(addr);
+			addr++;
+			break;
+		case 2:
+		case 6:
+		case 10:
+		case 14:
+			value = Mem2(addr);
+			addr += 2;
+			break;
+		case 3:
+		case 7:
+		case 11:
+		case 15:
+			value = Mem4(addr);
+			addr += 4;
+			break;
+		default:
+			break;
+		}
+
+		if (oplist->formlist[ix] == modeform_Load) {
+			switch (mode) {
+			case 0: /* constant zero */
+				kind = decoded_Const;
+				break;
+			case 1: /* one-byte constant, sign-extended */
+				kind = decoded_Const;
+				value = (uint)(int)(signed char)value;
+				break;
+			case 2: /* two-byte constant, sign-extended from the first byte */
+				kind = decoded_Const;
+				value = (uint)(int)(int16)value;
+				break;
+			case 3: /* four-byte constant */
+				kind = decoded_Const;
+				break;
+			case 5:
+			case 6:
+			case 7:
+				kind = decoded_Mem;
+				break;
+			case 13:
+			case 14:
+			case 15:
+				kind = decoded_Mem;
+				value += ramstart;
+				break;
+			case 8: /* pop off stack */
+				kind = decoded_Pop;
+				break;
+			case 9:
+			case 10:
+			case 11:
+				kind = decoded_Local;
+				break;
+			default:
+				kind = decoded_Const;
+				fatal_error("Unknown addressing mode in load operand.");
+			}
+
+			op->args[ix].desttype = 0;
+			op->args[ix].value = value;
+
+		} else { /* modeform_Store */
+			kind = decoded_Store;
+
+			switch (mode) {
+			case 0: /* discard value */
+				op->args[ix].desttype = 0;
+				op->args[ix].value = 0;
+				break;
+			case 8: /* push on stack */
+				op->args[ix].desttype = 3;
+				op->args[ix].value = 0;
+				break;
+			case 5:
+			case 6:
+			case 7:
+				op->args[ix].desttype = 1;
+				op->args[ix].value = value;
+				break;
+			case 13:
+			case 14:
+			case 15:
+				op->args[ix].desttype = 1;
+				op->args[ix].value = value + ramstart;
+				break;
+			case 9:
+			case 10:
+			case 11:
+				/* Relative to the locals segment, as in parse_operands(). */
+				op->args[ix].desttype = 2;
+				op->args[ix].value = value;
+				break;
+			case 1:
+			case 2:
+			case 3:
+				fatal_error("Constant addressing mode in store operand.");
+				break;
+			default:
+				fatal_error("Unknown addressing mode in store operand.");
+			}
+		}
+
+		op->kinds[ix] = kind;
+	}
+
+	op->opcode = opcode;
+	op->oplist = oplist;
+	op->nextpc = addr;
+	op->generation = decode_generation;
+}
+
+void Glulx::fetch_decoded_operands(oparg_t *args, const decodedop_t *op) {
+	int numops = op->oplist->num_ops;
+	int argsize = op->oplist->arg_size;
+	uint addr;
+
+	for (int ix = 0; ix < numops; ix++) {
+		switch (op->kinds[ix]) {
+		case decoded_Pop:
+			if (stackptr < valstackbase + 4) {
+				fatal_error("Stack underflow in operand.");
+			}
+			stackptr -= 4;
+			args[ix].desttype = 0;
+			args[ix].value = Stk4(stackptr);
+			break;
+
+		case decoded_Mem:
+			addr = op->args[ix].value;
+			args[ix].desttype = 0;
+			if (argsize == 4) {
+				args[ix].value = Mem4(addr);
+			} else if (argsize == 2) {
+				args[ix].value = Mem2(addr);
+			} else {
+				args[ix].value = Mem1(addr);
+			}
+			break;
+
+		case decoded_Local:
+			addr = op->args[ix].value + localsbase;
+			args[ix].desttype = 0;
+			if (argsize == 4) {
+				args[ix].value = Stk4(addr);
+			} else if (argsize == 2) {
+				args[ix].value = Stk2(addr);
+			} else {
+				args[ix].value = Stk1(addr);
+			}
+			break;
+
+		default: /* constants and store operands are final */
+			args[ix] = op->args[ix];
+			break;
+		}
+	}
+}
+
+void Glulx::flush_decode_cache() {
+	if (decode_ramlo < decode_ramhi)
+		decode_stats.flushes++;
+
+	decode_ramlo = 0xFFFFFFFF;
+	decode_ramhi = 0;
+
+	if (++decode_generation == 0) {
+		/* Wrapped around; the old generation numbers would come back to life. */
+		for (uint ix = 0; ix < decode_cache.size(); ix++)
+			decode_cache[ix].generation = 0;
+		decode_generation = 1;
+	}
+}
+
+void Glulx::setDecodeCache(bool enabled) {
+	decode_cache_enabled = enabled;
+	flush_decode_cache();
+}
+
+void Glulx::resetDecodeStats() {
+	memset(&decode_stats, 0, sizeof(decode_stats));
+	decode_turnstart = g_system->getMillis();
+}
+
 void Glulx::store_operand(uint desttype, uint destaddr, uint storeval) {
 	switch (desttype) {
 
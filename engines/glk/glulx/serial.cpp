@@ -63,6 +63,12 @@ void Glulx::final_serial() {
 	undo_chain_size = 0;
 	undo_chain_num = 0;
 
+	if (undo_ramimage) {
+		glulx_free(undo_ramimage);
+		undo_ramimage = nullptr;
+	}
+	undo_ramend = 0;
+
 #ifdef SERIALIZE_CACHE_RAM
 	if (ramcache) {
 		glulx_free(ramcache);
@@ -81,7 +87,9 @@ uint Glulx::perform_saveundo() {
 	   just have a memory chunk, a heap chunk, and a stack chunk, in
 	   that order. We skip the IFF chunk headers (although the size
 	   fields are still there.) We also don't bother with IFF's 16-bit
-	   alignment. */
+	   alignment. The memory chunk isn't the one from save files either;
+	   it only holds the pages changed since the previous undo state
+	   (see write_undo_memstate). */
 
 	if (undo_chain_size == 0)
 		return 1;
@@ -94,7 +102,7 @@ uint Glulx::perform_saveundo() {
 	}
 	if (res == 0) {
 		memstart = dest._pos;
-		res = write_memstate(&dest);
+		res = write_undo_memstate(&dest);
 		memlen = dest._pos - memstart;
 	}
 	if (res == 0) {
@@ -158,6 +166,14 @@ uint Glulx::perform_saveundo() {
 			glulx_free(dest._ptr);
 			dest._ptr = nullptr;
 		}
+
+		/* The RAM image may already have moved on to the current state,
+		   in which case the older undo states can't be rebuilt from it. */
+		for (int ix = 0; ix < undo_chain_num; ix++) {
+			glulx_free(undo_chain[ix]);
+			undo_chain[ix] = nullptr;
+		}
+		undo_chain_num = 0;
 	}
 
 	return res;
@@ -186,7 +202,7 @@ uint Glulx::perform_restoreundo() {
 		res = read_long(&dest, &val);
 	}
 	if (res == 0) {
-		res = read_memstate(&dest, val);
+		res = read_undo_memstate(&dest, val);
 	}
 	if (res == 0) {
 		res = read_long(&dest, &val);
@@ -348,7 +364,8 @@ int Glulx::reposition_write(dest_t *dest, uint pos) {
 int Glulx::write_buffer(dest_t *dest, const byte *ptr, uint len) {
 	if (dest->_isMem) {
 		if (dest->_pos + len > dest->_size) {
-			dest->_size = dest->_pos + len + 1024;
+			/* Grow geometrically; undo states are written a page at a time. */
+			dest->_size = MAX(dest->_pos + len, dest->_size * 2) + 1024;
 			if (!dest->_ptr) {
 				dest->_ptr = (byte *)glulx_malloc(dest->_size);
 			} else {
@@ -556,6 +573,105 @@ uint Glulx::read_memstate(dest_t *dest, uint chunklen) {
 	return 0;
 }
 
+uint Glulx::write_undo_memstate(dest_t *dest) {
+	uint res, pos;
+	uint oldend = undo_chain_num ? undo_ramend : ramstart;
+	byte *newimage;
+
+	/* The chunk is the new end of memory, the end of memory in the previous
+	   undo state, and then the previous contents of each page which differs
+	   between the two, as a page address followed by UNDO_PAGE_SIZE bytes.
+	   Pages which didn't exist in the previous state aren't stored; they are
+	   dropped again when stepping back. */
+	res = write_long(dest, endmem);
+	if (res == 0)
+		res = write_long(dest, oldend);
+	if (res)
+		return res;
+
+	for (pos = ramstart; pos < oldend; pos += UNDO_PAGE_SIZE) {
+		byte *oldpage = undo_ramimage + (pos - ramstart);
+
+		if (pos < endmem && !memcmp(oldpage, memmap + pos, UNDO_PAGE_SIZE))
+			continue;
+
+		res = write_long(dest, pos);
+		if (res == 0)
+			res = write_buffer(dest, oldpage, UNDO_PAGE_SIZE);
+		if (res)
+			return res;
+
+		if (pos < endmem)
+			memcpy(oldpage, memmap + pos, UNDO_PAGE_SIZE);
+	}
+
+	/* Bring the rest of the image up to date with the current state. */
+	if (endmem != oldend || !undo_ramimage) {
+		newimage = (byte *)glulx_realloc(undo_ramimage, MAX<uint>(endmem - ramstart, 1));
+		if (!newimage)
+			return 1;
+		undo_ramimage = newimage;
+	}
+	if (endmem > oldend)
+		memcpy(undo_ramimage + (oldend - ramstart), memmap + oldend, endmem - oldend);
+	undo_ramend = endmem;
+
+	return 0;
+}
+
+uint Glulx::read_undo_memstate(dest_t *dest, uint chunklen) {
+	uint chunkend = dest->_pos + chunklen;
+	uint res, pos, newend, oldend;
+	uint protlo, prothi;
+	byte *newimage;
+
+	heap_clear();
+
+	res = read_long(dest, &newend);
+	if (res == 0)
+		res = read_long(dest, &oldend);
+	if (res)
+		return res;
+	if (newend != undo_ramend || oldend < ramstart)
+		return 1;
+
+	res = change_memsize(newend, false);
+	if (res)
+		return res;
+
+	/* All of RAM except the protected range comes back from the image. */
+	protlo = prothi = endmem;
+	if (protectstart < protectend) {
+		protlo = CLIP(protectstart, ramstart, endmem);
+		prothi = CLIP(protectend, protlo, endmem);
+	}
+	memcpy(memmap + ramstart, undo_ramimage, protlo - ramstart);
+	memcpy(memmap + prothi, undo_ramimage + (prothi - ramstart), endmem - prothi);
+	flush_decode_cache();
+
+	/* Then step the image back to the previous undo state. */
+	if (oldend != newend) {
+		newimage = (byte *)glulx_realloc(undo_ramimage, MAX<uint>(oldend - ramstart, 1));
+		if (!newimage)
+			return 1;
+		undo_ramimage = newimage;
+	}
+	undo_ramend = oldend;
+
+	while (dest->_pos < chunkend) {
+		res = read_long(dest, &pos);
+		if (res)
+			return res;
+		if (pos < ramstart || pos + UNDO_PAGE_SIZE > oldend)
+			return 1;
+		res = read_buffer(dest, undo_ramimage + (pos - ramstart), UNDO_PAGE_SIZE);
+		if (res)
+			return res;
+	}
+
+	return 0;
+}
+
 uint Glulx::write_heapstate(dest_t *dest, int portable) {
 	uint res;
 	uint sumlen;
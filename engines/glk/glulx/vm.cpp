@@ -154,6 +154,7 @@ void Glulx::vm_restart() {
 	for (lx = endgamefile; lx < origendmem; lx++) {
 		memmap[lx] = 0;
 	}
+	flush_decode_cache();
 
 	/* Reset all the registers */
 	stackptr = 0;
@@ -205,6 +206,7 @@ uint Glulx::change_memsize(uint newlen, bool internal) {
 			memmap[lx] = 0;
 		}
 	}
+	flush_decode_cache();
 
 	endmem = newlen;
 
@@ -249,7 +249,14 @@ long Mem::mem_diff(zbyte *a, zbyte *b, zword mem_size, zbyte *diff) {
 	zbyte c = 0;
 
 	for (;;) {
-		for (j = 0; size > 0 && (c = *a++ ^ *b++) == 0; j++)
+		// Most of dynamic memory is unchanged between two moves, so skip
+		// over identical stretches a word at a time first
+		for (j = 0; size >= 8 && !memcmp(a, b, 8); j += 8) {
+			a += 8;
+			b += 8;
+			size -= 8;
+		}
+		for (; size > 0 && (c = *a++ ^ *b++) == 0; j++)
 			size--;
 		if (size == 0) break;
 		size--;
@@ -20,12 +20,17 @@
  */
 
 #include "common/config-manager.h"
+#include "common/file.h"
 
 #include "graphics/renderer.h"
+#ifdef USE_TINYGL
+#include "graphics/tinygl/tinygl.h"
+#endif
 
 #include "engines/grim/debugger.h"
 #include "engines/grim/md5check.h"
 #include "engines/grim/grim.h"
+#include "engines/grim/resource.h"
 
 namespace Grim {
 
@@ -39,6 +44,8 @@ Debugger::Debugger() :
 	registerCmd("renderer_get", WRAP_METHOD(Debugger, cmd_renderer_get));
 	registerCmd("save", WRAP_METHOD(Debugger, cmd_save));
 	registerCmd("load", WRAP_METHOD(Debugger, cmd_load));
+	registerCmd("resource_cache", WRAP_METHOD(Debugger, cmd_resource_cache));
+	registerCmd("capture_frame", WRAP_METHOD(Debugger, cmd_capture_frame));
 }
 
 Debugger::~Debugger() {
@@ -134,4 +141,49 @@ bool Debugger::cmd_load(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmd_resource_cache(int argc, const char **argv) {
+	if (argc >= 2) {
+		if (!strcmp(argv[1], "reset")) {
+			g_resourceloader->resetCacheStats();
+		} else if (!strcmp(argv[1], "clear")) {
+			g_resourceloader->clearCache();
+		} else if (!strcmp(argv[1], "budget") && argc == 3) {
+			g_resourceloader->setCacheBudget(atoi(argv[2]) * 1024);
+		} else {
+			debugPrintf("Usage: resource_cache [reset|clear|budget <kilobytes>]\n");
+			return true;
+		}
+	}
+
+	const ResourceLoader::CacheStats &stats = g_resourceloader->getCacheStats();
+	debugPrintf("Files cached: %u, %u of %u kilobytes\n", g_resourceloader->getCacheEntryCount(),
+	            g_resourceloader->getCacheMemorySize() / 1024, g_resourceloader->getCacheBudget() / 1024);
+	debugPrintf("Hits: %u, misses: %u, evictions: %u\n", stats.hits, stats.misses, stats.evictions);
+	return true;
+}
+
+bool Debugger::cmd_capture_frame(int argc, const char **argv) {
+	if (argc < 2) {
+		debugPrintf("Usage: capture_frame <file name>\n");
+		debugPrintf("Saves the next frame drawn by the software renderer, to be replayed with 'make tinygl-replay'\n");
+		return true;
+	}
+
+#ifdef USE_TINYGL
+	if (g_grim->getRendererType() == Graphics::kRendererTypeTinyGL) {
+		Common::DumpFile *file = new Common::DumpFile();
+		if (!file->open(Common::Path(argv[1], Common::Path::kNativeSeparator))) {
+			debugPrintf("Could not open '%s'\n", argv[1]);
+			delete file;
+			return true;
+		}
+		TinyGL::captureFrame(file);
+		return false;
+	}
+#endif
+
+	debugPrintf("Frames can only be captured with the software renderer\n");
+	return true;
+}
+
 }
@@ -40,6 +40,8 @@ public:
 	bool cmd_renderer_set(int argc, const char **argv);
 	bool cmd_save(int argc, const char **argv);
 	bool cmd_load(int argc, const char **argv);
+	bool cmd_resource_cache(int argc, const char **argv);
+	bool cmd_capture_frame(int argc, const char **argv);
 };
 
 }
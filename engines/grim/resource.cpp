@@ -72,8 +72,9 @@ public:
 };
 
 ResourceLoader::ResourceLoader() {
-	_cacheDirty = false;
 	_cacheMemorySize = 0;
+	_cacheBudget = kDefaultCacheBudget;
+	resetCacheStats();
 
 	Lab *l;
 	Common::ArchiveMemberList files, updFiles;
@@ -230,11 +231,6 @@ void clearList(Common::List<T> &list) {
 }
 
 ResourceLoader::~ResourceLoader() {
-	for (Common::Array<ResourceCache>::iterator i = _cache.begin(); i != _cache.end(); ++i) {
-		ResourceCache &r = *i;
-		delete[] r.fname;
-		delete[] r.resPtr;
-	}
 	clearList(_models);
 	clearList(_colormaps);
 	clearList(_keyframeAnims);
@@ -242,33 +238,27 @@ ResourceLoader::~ResourceLoader() {
 	MD5Check::clear();
 }
 
-static int sortCallback(const void *entry1, const void *entry2) {
-	return scumm_stricmp(((const ResourceLoader::ResourceCache *)entry1)->fname, ((const ResourceLoader::ResourceCache *)entry2)->fname);
-}
-
 Common::SeekableReadStream *ResourceLoader::getFileFromCache(const Common::Path &filename) const {
 	ResourceLoader::ResourceCache *entry = getEntryFromCache(filename);
-	if (!entry)
+	if (!entry) {
+		_cacheStats.misses++;
 		return nullptr;
+	}
 
+	_cacheStats.hits++;
+	// Move the entry to the most recently used end of the list
+	Common::String name = Common::move(*entry->lruPos);
+	_cacheLru.erase(entry->lruPos);
+	entry->lruPos = _cacheLru.insert(_cacheLru.end(), Common::move(name));
 	return new Common::MemoryReadStream(entry->resPtr, entry->len);
 }
 
 ResourceLoader::ResourceCache *ResourceLoader::getEntryFromCache(const Common::Path &filename) const {
-	if (_cache.empty())
+	CacheMap::iterator it = _cache.find(filename.toString('/'));
+	if (it == _cache.end())
 		return nullptr;
 
-	if (_cacheDirty) {
-		qsort(_cache.begin(), _cache.size(), sizeof(ResourceCache), sortCallback);
-		_cacheDirty = false;
-	}
-
-	Common::String sFilename(filename.toString('/'));
-
-	ResourceCache key;
-	key.fname = const_cast<char *>(sFilename.c_str());
-
-	return (ResourceLoader::ResourceCache *)bsearch(&key, _cache.begin(), _cache.size(), sizeof(ResourceCache), sortCallback);
+	return &it->_value;
 }
 
 Common::SeekableReadStream *ResourceLoader::loadFile(const Common::Path &filename) const {
@@ -299,7 +289,8 @@ Common::SeekableReadStream *ResourceLoader::openNewStreamFile(const Common::Stri
 			s->read(buf, size);
 			putIntoCache(path, buf, size);
 			delete s;
-			s = new Common::MemoryReadStream(buf, size);
+			ResourceCache *entry = getEntryFromCache(path);
+			s = new Common::MemoryReadStream(entry->resPtr, entry->len);
 		}
 	} else {
 		s = loadFile(path);
@@ -309,16 +300,48 @@ Common::SeekableReadStream *ResourceLoader::openNewStreamFile(const Common::Stri
 }
 
 void ResourceLoader::putIntoCache(const Common::Path &fname, byte *res, uint32 len) const {
-	Common::String sFilename(fname.toString('/'));
+	uncache(fname);
+
+	// Make room before inserting, so the new entry itself is never evicted,
+	// even if it is bigger than the whole budget
+	trimCache(len < _cacheBudget ? _cacheBudget - len : 0);
 
+	Common::String name = fname.toString('/');
 	ResourceCache entry;
-	entry.resPtr = res;
+	entry.resPtr = Common::SharedPtr<byte>(res, Common::ArrayDeleter<byte>());
 	entry.len = len;
-	entry.fname = new char[sFilename.size() + 1];
-	Common::strcpy_s(entry.fname, sFilename.size() + 1, sFilename.c_str());
+	entry.lruPos = _cacheLru.insert(_cacheLru.end(), name);
 	_cacheMemorySize += len;
-	_cache.push_back(entry);
-	_cacheDirty = true;
+	_cache[name] = entry;
+}
+
+void ResourceLoader::trimCache(uint32 budget) const {
+	while (_cacheMemorySize > budget && !_cacheLru.empty()) {
+		CacheMap::iterator oldest = _cache.find(_cacheLru.front());
+		_cacheLru.pop_front();
+
+		// Streams still reading from the buffer keep it alive
+		_cacheMemorySize -= oldest->_value.len;
+		_cacheStats.evictions++;
+		_cache.erase(oldest);
+	}
+}
+
+void ResourceLoader::setCacheBudget(uint32 bytes) {
+	_cacheBudget = bytes;
+	trimCache(_cacheBudget);
+}
+
+void ResourceLoader::resetCacheStats() const {
+	_cacheStats.hits = 0;
+	_cacheStats.misses = 0;
+	_cacheStats.evictions = 0;
+}
+
+void ResourceLoader::clearCache() const {
+	_cache.clear();
+	_cacheLru.clear();
+	_cacheMemorySize = 0;
 }
 
 CMap *ResourceLoader::loadColormap(const Common::String &filename) {
@@ -602,22 +625,13 @@ Overlay *ResourceLoader::loadOverlay(const Common::String &filename) {
 void ResourceLoader::uncache(const Common::Path &filename) const {
 	Common::Path lower(filename);
 	lower.toLowercase();
-	Common::String fname(lower.toString('/'));
-
-	if (_cacheDirty) {
-		qsort(_cache.begin(), _cache.size(), sizeof(ResourceCache), sortCallback);
-		_cacheDirty = false;
-	}
+	CacheMap::iterator it = _cache.find(lower.toString('/'));
+	if (it == _cache.end())
+		return;
 
-	for (unsigned int i = 0; i < _cache.size(); i++) {
-		if (fname.equals(_cache[i].fname)) {
-			delete[] _cache[i].fname;
-			_cacheMemorySize -= _cache[i].len;
-			delete[] _cache[i].resPtr;
-			_cache.remove_at(i);
-			_cacheDirty = true;
-		}
-	}
+	_cacheMemorySize -= it->_value.len;
+	_cacheLru.erase(it->_value.lruPos);
+	_cache.erase(it);
 }
 
 void ResourceLoader::uncacheModel(Model *m) {
@@ -24,6 +24,10 @@
 
 #include "common/archive.h"
 #include "common/array.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/ptr.h"
 
 #include "engines/grim/object.h"
 
@@ -85,24 +89,57 @@ public:
 	void uncacheLipSync(LipSync *l);
 	void uncacheAnimationEmi(AnimationEmi *a);
 
+	/**
+	 * The raw contents of a file opened with caching enabled. Streams handed
+	 * out for the entry share the buffer, so it stays valid for them even
+	 * after the entry has been evicted.
+	 */
 	struct ResourceCache {
-		char *fname;
-		byte *resPtr;
+		Common::SharedPtr<byte> resPtr;
 		uint32 len;
+		/** The position of the entry in the recently used list */
+		Common::List<Common::String>::iterator lruPos;
 	};
 
+	struct CacheStats {
+		uint32 hits;
+		uint32 misses;
+		uint32 evictions;
+	};
+
+	/** Default for the total size of the cached files, in bytes */
+	static const uint32 kDefaultCacheBudget = 32 * 1024 * 1024;
+
 	static Common::String fixFilename(const Common::String &filename, bool append = true);
 
+	/**
+	 * Set the total size the cached files may take up. Least recently used
+	 * files are dropped from the cache once it grows beyond this.
+	 */
+	void setCacheBudget(uint32 bytes);
+	uint32 getCacheBudget() const { return _cacheBudget; }
+	uint32 getCacheMemorySize() const { return _cacheMemorySize; }
+	uint32 getCacheEntryCount() const { return _cache.size(); }
+	const CacheStats &getCacheStats() const { return _cacheStats; }
+	void resetCacheStats() const;
+	void clearCache() const;
+
 private:
+	typedef Common::HashMap<Common::String, ResourceCache, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> CacheMap;
+
 	Common::SeekableReadStream *loadFile(const Common::Path &filename) const;
 	Common::SeekableReadStream *getFileFromCache(const Common::Path &filename) const;
 	ResourceLoader::ResourceCache *getEntryFromCache(const Common::Path &filename) const;
 	void putIntoCache(const Common::Path &fname, byte *res, uint32 len) const;
 	void uncache(const Common::Path &fname) const;
-
-	mutable Common::Array<ResourceCache> _cache;
-	mutable bool _cacheDirty;
-	mutable int32 _cacheMemorySize;
+	void trimCache(uint32 budget) const;
+
+	mutable CacheMap _cache;
+	/** The names of the cached files, least recently used first */
+	mutable Common::List<Common::String> _cacheLru;
+	mutable uint32 _cacheMemorySize;
+	mutable CacheStats _cacheStats;
+	uint32 _cacheBudget;
 
 	Common::List<EMIModel *> _emiModels;
 	Common::List<Model *> _models;
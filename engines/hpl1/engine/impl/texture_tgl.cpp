@@ -136,6 +136,7 @@ bool TGLTexture::Create(unsigned int alWidth, unsigned int alHeight, cColor aCol
 //-----------------------------------------------------------------------
 
 static void generateMipmaps(eTextureTarget target) {
+	tglGenerateMipmap(TGL_TEXTURE_2D);
 }
 
 bool TGLTexture::CreateFromArray(unsigned char *apPixelData, int alChannels, const cVector3l &avSize) {
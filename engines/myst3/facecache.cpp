@@ -0,0 +1,162 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "engines/myst3/facecache.h"
+#include "engines/myst3/archive.h"
+#include "engines/myst3/database.h"
+#include "engines/myst3/myst3.h"
+#include "engines/myst3/state.h"
+
+namespace Myst3 {
+
+FaceCache::FaceCache(Myst3Engine *vm) :
+		_vm(vm),
+		_room(0),
+		_age(0),
+		_decodeDuration(kDefaultDecodeDuration) {
+}
+
+FaceCache::~FaceCache() {
+	clear();
+}
+
+void FaceCache::freeFace(Graphics::Surface *surface) {
+	surface->free();
+	delete surface;
+}
+
+void FaceCache::clear() {
+	for (FaceMap::iterator it = _faces.begin(); it != _faces.end(); ++it)
+		freeFace(it->_value);
+
+	_faces.clear();
+	_queue.clear();
+}
+
+void FaceCache::setRoom(uint32 room, uint32 age) {
+	if (room == _room && age == _age)
+		return;
+
+	clear();
+	_room = room;
+	_age = age;
+}
+
+Graphics::Surface *FaceCache::takeFace(uint16 node, uint32 room, uint32 age, uint16 face) {
+	FaceMap::iterator it = _faces.find(FaceKey(node, face, room, age));
+	if (it == _faces.end())
+		return nullptr;
+
+	Graphics::Surface *surface = it->_value;
+	_faces.erase(it);
+	return surface;
+}
+
+void FaceCache::addNeighbour(Common::Array<uint16> &neighbours, uint16 currentNode, int32 node) {
+	if (node <= 0 || node == currentNode || neighbours.size() >= kMaxNodes)
+		return;
+
+	for (uint i = 0; i < neighbours.size(); i++) {
+		if (neighbours[i] == node)
+			return;
+	}
+
+	neighbours.push_back(node);
+}
+
+void FaceCache::prefetchNeighbours(uint16 node, uint32 room, uint32 age) {
+	setRoom(room, age);
+
+	NodePtr nodeData = _vm->_db->getNodeData(node, room, age);
+	if (!nodeData)
+		return;
+
+	// Collect the script opcodes that move to another node in the same room
+	Common::Array<const Common::Array<Opcode> *> scripts;
+	for (uint i = 0; i < nodeData->hotspots.size(); i++)
+		scripts.push_back(&nodeData->hotspots[i].script);
+	for (uint i = 0; i < nodeData->scripts.size(); i++)
+		scripts.push_back(&nodeData->scripts[i].script);
+
+	Common::Array<uint16> neighbours;
+	for (uint i = 0; i < scripts.size(); i++) {
+		const Common::Array<Opcode> &script = *scripts[i];
+		for (uint j = 0; j < script.size(); j++) {
+			const Opcode &cmd = script[j];
+			if (cmd.op == 164 && cmd.args.size() >= 1) { // changeNode
+				addNeighbour(neighbours, node, _vm->_state->valueOrVarValue(cmd.args[0]));
+			} else if (cmd.op == 165 && cmd.args.size() >= 2) { // changeNodeRoom
+				if ((uint32)_vm->_state->valueOrVarValue(cmd.args[0]) == room)
+					addNeighbour(neighbours, node, _vm->_state->valueOrVarValue(cmd.args[1]));
+			}
+		}
+	}
+
+	// Forget about the nodes that cannot be reached from here
+	FaceMap kept;
+	for (FaceMap::iterator it = _faces.begin(); it != _faces.end(); ++it) {
+		bool reachable = false;
+		for (uint i = 0; i < neighbours.size(); i++)
+			reachable |= it->_key.node == neighbours[i];
+
+		if (reachable)
+			kept[it->_key] = it->_value;
+		else
+			freeFace(it->_value);
+	}
+	_faces = kept;
+
+	_queue.clear();
+	for (uint i = 0; i < neighbours.size(); i++) {
+		for (uint16 face = 1; face <= 6; face++) {
+			FaceKey key(neighbours[i], face, room, age);
+			if (!_faces.contains(key))
+				_queue.push_back(key);
+		}
+	}
+}
+
+bool FaceCache::prefetchStep(uint32 timeLeft) {
+	// Decoding must not make the frame late
+	if (_queue.empty() || timeLeft < _decodeDuration)
+		return false;
+
+	Common::String roomName = _vm->_db->getRoomName(_room, _age);
+	while (!_queue.empty()) {
+		FaceKey key = _queue.front();
+		_queue.remove_at(0);
+
+		// Nodes without cube faces, such as frame nodes, are skipped
+		ResourceDescription jpegDesc = _vm->getFileDescription(roomName, key.node, key.face, Archive::kCubeFace);
+		if (!jpegDesc.isValid())
+			continue;
+
+		uint32 start = g_system->getMillis();
+		_faces[key] = Myst3Engine::decodeJpeg(&jpegDesc);
+		_decodeDuration = g_system->getMillis() - start;
+		return true;
+	}
+
+	return false;
+}
+
+} // End of namespace Myst3
@@ -0,0 +1,115 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef MYST3_FACECACHE_H
+#define MYST3_FACECACHE_H
+
+#include "common/array.h"
+#include "common/hashmap.h"
+
+#include "graphics/surface.h"
+
+namespace Myst3 {
+
+class Myst3Engine;
+
+/**
+ * Decoded cube faces of the nodes that can be reached from the current one.
+ *
+ * Going to another node decodes its six JPEG faces, which causes a visible
+ * pause. Once a cube node has been loaded, the faces of the nodes its scripts
+ * can go to in the same room are decoded ahead of time, one per frame when
+ * the frame has enough time left for it.
+ */
+class FaceCache {
+public:
+	FaceCache(Myst3Engine *vm);
+	~FaceCache();
+
+	/**
+	 * Get the decoded face of a node, if it has been prefetched.
+	 * The caller takes ownership of the surface.
+	 */
+	Graphics::Surface *takeFace(uint16 node, uint32 room, uint32 age, uint16 face);
+
+	/**
+	 * Queue the faces of the nodes reachable from a node for decoding.
+	 * Cached faces of nodes that are not reachable anymore are dropped.
+	 */
+	void prefetchNeighbours(uint16 node, uint32 room, uint32 age);
+
+	/**
+	 * Decode one queued face, if that is expected to take less than the
+	 * time left for the frame. Returns true if a face was decoded.
+	 */
+	bool prefetchStep(uint32 timeLeft);
+
+	/** Drop everything if the location is not in the current room anymore */
+	void setRoom(uint32 room, uint32 age);
+
+	/** Drop everything, the node archive is about to change */
+	void clear();
+
+	uint getCachedFaceCount() const { return _faces.size(); }
+
+private:
+	/** At most that many nodes worth of faces are kept */
+	static const uint kMaxNodes = 4;
+
+	/** How long decoding a face is assumed to take until one has been timed */
+	static const uint32 kDefaultDecodeDuration = 10;
+
+	struct FaceKey {
+		uint16 node;
+		uint16 face;
+		uint32 room;
+		uint32 age;
+
+		FaceKey(uint16 n, uint16 f, uint32 r, uint32 a) : node(n), face(f), room(r), age(a) {}
+
+		bool operator==(const FaceKey &other) const {
+			return node == other.node && face == other.face && room == other.room && age == other.age;
+		}
+	};
+
+	struct FaceKeyHash {
+		uint operator()(const FaceKey &key) const {
+			return (key.age << 24) ^ (key.room << 16) ^ (key.node << 3) ^ key.face;
+		}
+	};
+
+	void addNeighbour(Common::Array<uint16> &neighbours, uint16 currentNode, int32 node);
+	void freeFace(Graphics::Surface *surface);
+
+	typedef Common::HashMap<FaceKey, Graphics::Surface *, FaceKeyHash> FaceMap;
+
+	Myst3Engine *_vm;
+	FaceMap _faces;
+	Common::Array<FaceKey> _queue;
+	uint32 _room;
+	uint32 _age;
+	uint32 _decodeDuration;
+};
+
+} // End of namespace Myst3
+
+#endif
@@ -7,6 +7,7 @@ MODULE_OBJS := \
 	cursor.o \
 	database.o \
 	effects.o \
+	facecache.o \
 	gfx.o \
 	gfx_opengl.o \
 	gfx_opengl_shaders.o \
@@ -37,6 +37,7 @@
 #include "engines/myst3/console.h"
 #include "engines/myst3/database.h"
 #include "engines/myst3/effects.h"
+#include "engines/myst3/facecache.h"
 #include "engines/myst3/myst3.h"
 #include "engines/myst3/nodecube.h"
 #include "engines/myst3/nodeframe.h"
@@ -63,7 +64,7 @@ namespace Myst3 {
 
 Myst3Engine::Myst3Engine(OSystem *syst, const Myst3GameDescription *version) :
 		Engine(syst), _system(syst), _gameDescription(version),
-		_db(nullptr), _scriptEngine(nullptr),
+		_db(nullptr), _faceCache(nullptr), _scriptEngine(nullptr),
 		_state(nullptr), _node(nullptr), _scene(nullptr), _archiveNode(nullptr),
 		_cursor(nullptr), _inventory(nullptr), _gfx(nullptr), _menu(nullptr),
 		_rnd(nullptr), _sound(nullptr), _ambient(nullptr),
@@ -113,6 +114,7 @@ Myst3Engine::~Myst3Engine() {
 	delete _cursor;
 	delete _scene;
 	delete _archiveNode;
+	delete _faceCache;
 	delete _db;
 	delete _scriptEngine;
 	delete _state;
@@ -169,6 +171,7 @@ Common::Error Myst3Engine::run() {
 		lang = getGameLanguage();
 	}
 	_db = new Database(getPlatform(), lang, getGameLocalizationType());
+	_faceCache = new FaceCache(this);
 	_state = new GameState(getPlatform(), _db);
 	_scene = new Scene(this);
 	if (getPlatform() == Common::kPlatformXbox) {
@@ -806,6 +809,7 @@ void Myst3Engine::drawFrame(bool noSwap) {
 	_gfx->flipBuffer();
 
 	if (!noSwap) {
+		_faceCache->prefetchStep(_frameLimiter->getRemainingFrameTime());
 		_frameLimiter->delayBeforeSwap();
 		_system->updateScreen();
 		_state->updateFrameCounters();
@@ -897,12 +901,14 @@ void Myst3Engine::loadNode(uint16 nodeID, uint32 roomID, uint32 ageID) {
 		ageID = _state->getLocationAge();
 
 	_db->cacheRoom(roomID, ageID);
+	_faceCache->setRoom(roomID, ageID);
 
 	Common::String newRoomName = _db->getRoomName(roomID, ageID);
 	if ((!_archiveNode || _archiveNode->getRoomName() != newRoomName) && !_db->isCommonRoom(roomID, ageID)) {
 
 		Common::String nodeFile = Common::String::format("%snodes.m3a", newRoomName.c_str());
 
+		_faceCache->clear();
 		_archiveNode->close();
 		if (!_archiveNode->open(nodeFile.c_str(), newRoomName.c_str())) {
 			error("Unable to open archive %s", nodeFile.c_str());
@@ -914,6 +920,10 @@ void Myst3Engine::loadNode(uint16 nodeID, uint32 roomID, uint32 ageID) {
 		return; // The main init script does not load a node
 	}
 
+	// Decode the faces of the next nodes the player may go to while idle
+	if (_state->getViewType() == kCube)
+		_faceCache->prefetchNeighbours(_state->getLocationNode(), roomID, ageID);
+
 	// The effects can only be created after running the node init scripts
 	_node->initEffects();
 	_shakeEffect = ShakeEffect::create(this);
@@ -66,6 +66,7 @@ class HotSpot;
 class Cursor;
 class Inventory;
 class Database;
+class FaceCache;
 class Scene;
 class Script;
 class SpotItemFace;
@@ -100,6 +101,7 @@ public:
 	Renderer *_gfx;
 	Menu *_menu;
 	Database *_db;
+	FaceCache *_faceCache;
 	Sound *_sound;
 	Ambient *_ambient;
 
@@ -20,8 +20,10 @@
  */
 
 #include "engines/myst3/archive.h"
+#include "engines/myst3/facecache.h"
 #include "engines/myst3/nodecube.h"
 #include "engines/myst3/myst3.h"
+#include "engines/myst3/state.h"
 
 #include "common/debug.h"
 
@@ -38,7 +40,12 @@ NodeCube::NodeCube(Myst3Engine *vm, uint16 id) :
 			error("Face %d does not exist", id);
 
 		_faces[i] = new Face(_vm, true);
-		_faces[i]->setTextureFromJPEG(&jpegDesc);
+
+		Graphics::Surface *bitmap = _vm->_faceCache->takeFace(id, _vm->_state->getLocationRoom(), _vm->_state->getLocationAge(), i + 1);
+		if (bitmap)
+			_faces[i]->setTextureFromBitmap(bitmap);
+		else
+			_faces[i]->setTextureFromJPEG(&jpegDesc);
 	}
 }
 
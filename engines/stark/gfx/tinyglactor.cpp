@@ -35,7 +35,11 @@ namespace Gfx {
 TinyGLActorRenderer::TinyGLActorRenderer(TinyGLDriver *gfx) :
 		VisualActor(),
 		_gfx(gfx),
-		_faceVBO(nullptr) {
+		_faceVBO(nullptr),
+		_vertexCount(0),
+		_skinningValid(false),
+		_lightingValid(false),
+		_shadowValid(false) {
 }
 
 TinyGLActorRenderer::~TinyGLActorRenderer() {
@@ -98,6 +102,16 @@ void TinyGLActorRenderer::render(const Math::Vector3d &position, float direction
 	Common::Array<Material *> mats = _model->getMaterials();
 	const Common::Array<BoneNode *> &bones = _model->getBones();
 
+	// Skinning, lighting and shadows are only computed again when their
+	// inputs have changed, which is seldom the case for idle actors
+	bool skinned = updateSkinning(bones);
+	updateLighting(lights, modelViewMatrix, normalMatrix, skinned);
+	if (drawShadow) {
+		updateShadow(lightDirection, skinned);
+	} else {
+		_shadowValid = false;
+	}
+
 	for (Common::Array<Face *>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
 		const Material *material = mats[(*face)->materialId];
 		Math::Vector3d color;
@@ -105,132 +119,21 @@ void TinyGLActorRenderer::render(const Math::Vector3d &position, float direction
 		if (tex) {
 			tex->bind();
 			tglEnable(TGL_TEXTURE_2D);
+			color = Math::Vector3d(1.0f, 1.0f, 1.0f);
 		} else {
 			tglBindTexture(TGL_TEXTURE_2D, 0);
 			tglDisable(TGL_TEXTURE_2D);
+			color = Math::Vector3d(material->r, material->g, material->b);
 		}
 		auto vertexIndices = _faceEBO[*face];
 		auto numVertexIndices = (*face)->vertexIndices.size();
 		for (uint32 i = 0; i < numVertexIndices; i++) {
-			if (tex) {
-				color = Math::Vector3d(1.0f, 1.0f, 1.0f);
-			} else {
-				color = Math::Vector3d(material->r, material->g, material->b);
-			}
 			uint32 index = vertexIndices[i];
-			auto vertex = _faceVBO[index];
-			uint32 bone1 = vertex.bone1;
-			uint32 bone2 = vertex.bone2;
-			Math::Vector3d position1 = Math::Vector3d(vertex.pos1x, vertex.pos1y, vertex.pos1z);
-			Math::Vector3d position2 = Math::Vector3d(vertex.pos2x, vertex.pos2y, vertex.pos2z);
-			Math::Vector3d bone1Position = Math::Vector3d(bones[bone1]->_animPos.x(),
-			                                              bones[bone1]->_animPos.y(),
-			                                              bones[bone1]->_animPos.z());
-			Math::Vector3d bone2Position = Math::Vector3d(bones[bone2]->_animPos.x(),
-			                                              bones[bone2]->_animPos.y(),
-			                                              bones[bone2]->_animPos.z());
-			Math::Quaternion bone1Rotation = Math::Quaternion(bones[bone1]->_animRot.x(),
-			                                                  bones[bone1]->_animRot.y(),
-			                                                  bones[bone1]->_animRot.z(),
-			                                                  bones[bone1]->_animRot.w());
-			Math::Quaternion bone2Rotation = Math::Quaternion(bones[bone2]->_animRot.x(),
-			                                                  bones[bone2]->_animRot.y(),
-			                                                  bones[bone2]->_animRot.z(),
-			                                                  bones[bone2]->_animRot.w());
-			float boneWeight = vertex.boneWeight;
-			Math::Vector3d normal = Math::Vector3d(vertex.normalx, vertex.normaly, vertex.normalz);
-
-			// Compute the vertex position in eye-space
-			bone1Rotation.transform(position1);
-			position1 += bone1Position;
-			bone2Rotation.transform(position2);
-			position2 += bone2Position;
-			Math::Vector3d modelPosition = Math::Vector3d::interpolate(position2, position1, boneWeight);
-			vertex.x = modelPosition.x();
-			vertex.y = modelPosition.y();
-			vertex.z = modelPosition.z();
-			Math::Vector4d modelEyePosition;
-			modelEyePosition = modelViewMatrix * Math::Vector4d(modelPosition.x(),
-			                                                    modelPosition.y(),
-			                                                    modelPosition.z(),
-			                                                    1.0);
-			// Compute the vertex normal in eye-space
-			Math::Vector3d n1 = normal;
-			bone1Rotation.transform(n1);
-			Math::Vector3d n2 = normal;
-			bone2Rotation.transform(n2);
-			Math::Vector3d modelNormal = Math::Vector3d(Math::Vector3d::interpolate(n2, n1, boneWeight)).getNormalized();
-			vertex.nx = modelNormal.x();
-			vertex.ny = modelNormal.y();
-			vertex.nz = modelNormal.z();
-			Math::Vector3d modelEyeNormal;
-			modelEyeNormal = normalMatrix.getRotation() * modelNormal;
-			modelEyeNormal.normalize();
-
-			if (drawShadow) {
-				Math::Vector3d shadowPosition = modelPosition + lightDirection * (-modelPosition.y() / lightDirection.y());
-				vertex.sx = shadowPosition.x();
-				vertex.sy = 0.0f;
-				vertex.sz = shadowPosition.z();
-			}
-
-			static const uint maxLights = 10;
-
-			assert(lights.size() >= 1);
-			assert(lights.size() <= maxLights);
-
-			const LightEntry *ambient = lights[0];
-			assert(ambient->type == LightEntry::kAmbient); // The first light must be the ambient light
-
-			Math::Vector3d lightColor = ambient->color;
-
-			for (uint li = 0; li < lights.size() - 1; li++) {
-				const LightEntry *l = lights[li + 1];
-
-				switch (l->type) {
-					case LightEntry::kPoint: {
-						Math::Vector3d vertexToLight = l->eyePosition.getXYZ() - modelEyePosition.getXYZ();
-
-						float dist = vertexToLight.length();
-						vertexToLight.normalize();
-						float attn = CLIP((l->falloffFar - dist) / MAX(0.001f,  l->falloffFar - l->falloffNear), 0.0f, 1.0f);
-						float incidence = MAX(0.0f, Math::Vector3d::dotProduct(modelEyeNormal, vertexToLight));
-						lightColor += l->color * attn * incidence;
-						break;
-					}
-					case LightEntry::kDirectional: {
-						float incidence = MAX(0.0f, Math::Vector3d::dotProduct(modelEyeNormal, -l->eyeDirection));
-						lightColor += (l->color * incidence);
-						break;
-					}
-					case LightEntry::kSpot: {
-						Math::Vector3d vertexToLight = l->eyePosition.getXYZ() - modelEyePosition.getXYZ();
-
-						float dist = vertexToLight.length();
-						float attn = CLIP((l->falloffFar - dist) / MAX(0.001f, l->falloffFar - l->falloffNear), 0.0f, 1.0f);
-
-						vertexToLight.normalize();
-						float incidence = MAX(0.0f, modelEyeNormal.dotProduct(vertexToLight));
-
-						float cosAngle = MAX(0.0f, vertexToLight.dotProduct(-l->eyeDirection));
-						float cone = CLIP((cosAngle - l->innerConeAngle.getCosine()) / MAX(0.001f, l->outerConeAngle.getCosine() - l->innerConeAngle.getCosine()), 0.0f, 1.0f);
-
-						lightColor += l->color * attn * incidence * cone;
-						break;
-					}
-					default:
-						break;
-				}
-			}
-
-			lightColor.x() = CLIP(lightColor.x(), 0.0f, 1.0f);
-			lightColor.y() = CLIP(lightColor.y(), 0.0f, 1.0f);
-			lightColor.z() = CLIP(lightColor.z(), 0.0f, 1.0f);
-			color = color * lightColor;
-			vertex.r = color.x();
-			vertex.g = color.y();
-			vertex.b = color.z();
-			_faceVBO[index] = vertex;
+			ActorVertex &vertex = _faceVBO[index];
+			const Math::Vector3d &lightColor = _vertexLight[index];
+			vertex.r = color.x() * lightColor.x();
+			vertex.g = color.y() * lightColor.y();
+			vertex.b = color.z() * lightColor.z();
 		}
 
 		tglEnableClientState(TGL_VERTEX_ARRAY);
@@ -276,9 +179,192 @@ void TinyGLActorRenderer::render(const Math::Vector3d &position, float direction
 	}
 }
 
+// Rotates (x, y, z) by the bone rotation, the same way as Math::Quaternion::transform
+static inline void rotateByBone(const SkinningBone &bone, float &x, float &y, float &z) {
+	float tx = bone.qy * z - bone.qz * y + bone.qw * x;
+	float ty = bone.qz * x - bone.qx * z + bone.qw * y;
+	float tz = bone.qx * y - bone.qy * x + bone.qw * z;
+	x += 2.0f * (bone.qy * tz - bone.qz * ty);
+	y += 2.0f * (bone.qz * tx - bone.qx * tz);
+	z += 2.0f * (bone.qx * ty - bone.qy * tx);
+}
+
+bool TinyGLActorRenderer::updateSkinning(const Common::Array<BoneNode *> &bones) {
+	// The skinned vertices only depend on the pose, which stays the same
+	// while the animation does not advance
+	bool samePose = _skinningValid && _skinningBones.size() == bones.size();
+	_skinningBones.resize(bones.size());
+	for (uint i = 0; i < bones.size(); i++) {
+		SkinningBone bone;
+		bone.px = bones[i]->_animPos.x();
+		bone.py = bones[i]->_animPos.y();
+		bone.pz = bones[i]->_animPos.z();
+		bone.qx = bones[i]->_animRot.x();
+		bone.qy = bones[i]->_animRot.y();
+		bone.qz = bones[i]->_animRot.z();
+		bone.qw = bones[i]->_animRot.w();
+
+		if (samePose && memcmp(&bone, &_skinningBones[i], sizeof(SkinningBone)) != 0)
+			samePose = false;
+		_skinningBones[i] = bone;
+	}
+
+	if (samePose)
+		return false;
+
+	const SkinningBone *skinningBones = _skinningBones.data();
+	for (uint32 i = 0; i < _vertexCount; i++) {
+		ActorVertex &vertex = _faceVBO[i];
+		const SkinningBone &bone1 = skinningBones[vertex.bone1];
+		const SkinningBone &bone2 = skinningBones[vertex.bone2];
+		float weight1 = vertex.boneWeight;
+		float weight2 = 1.0f - weight1;
+
+		float x1 = vertex.pos1x, y1 = vertex.pos1y, z1 = vertex.pos1z;
+		rotateByBone(bone1, x1, y1, z1);
+		float x2 = vertex.pos2x, y2 = vertex.pos2y, z2 = vertex.pos2z;
+		rotateByBone(bone2, x2, y2, z2);
+
+		vertex.x = (x2 + bone2.px) * weight2 + (x1 + bone1.px) * weight1;
+		vertex.y = (y2 + bone2.py) * weight2 + (y1 + bone1.py) * weight1;
+		vertex.z = (z2 + bone2.pz) * weight2 + (z1 + bone1.pz) * weight1;
+
+		float nx1 = vertex.normalx, ny1 = vertex.normaly, nz1 = vertex.normalz;
+		rotateByBone(bone1, nx1, ny1, nz1);
+		float nx2 = vertex.normalx, ny2 = vertex.normaly, nz2 = vertex.normalz;
+		rotateByBone(bone2, nx2, ny2, nz2);
+
+		Math::Vector3d normal(nx2 * weight2 + nx1 * weight1,
+		                      ny2 * weight2 + ny1 * weight1,
+		                      nz2 * weight2 + nz1 * weight1);
+		normal.normalize();
+		vertex.nx = normal.x();
+		vertex.ny = normal.y();
+		vertex.nz = normal.z();
+	}
+
+	_skinningValid = true;
+	return true;
+}
+
+void TinyGLActorRenderer::updateLighting(const LightEntryArray &lights, const Math::Matrix4 &modelViewMatrix,
+		const Math::Matrix4 &normalMatrix, bool skinned) {
+	static const uint maxLights = 10;
+
+	assert(lights.size() >= 1);
+	assert(lights.size() <= maxLights);
+
+	const LightEntry *ambient = lights[0];
+	assert(ambient->type == LightEntry::kAmbient); // The first light must be the ambient light
+
+	// Everything the lighting depends on, besides the skinned vertices
+	Common::Array<float> lightingInputs;
+	lightingInputs.reserve(16 + lights.size() * 16);
+	for (int i = 0; i < 16; i++)
+		lightingInputs.push_back(modelViewMatrix.getData()[i]);
+	for (uint i = 0; i < lights.size(); i++) {
+		const LightEntry *l = lights[i];
+		const float values[] = {
+			(float)l->type, l->color.x(), l->color.y(), l->color.z(),
+			l->eyePosition.x(), l->eyePosition.y(), l->eyePosition.z(),
+			l->eyeDirection.x(), l->eyeDirection.y(), l->eyeDirection.z(),
+			l->falloffNear, l->falloffFar,
+			l->innerConeAngle.getCosine(), l->outerConeAngle.getCosine()
+		};
+		for (uint j = 0; j < ARRAYSIZE(values); j++)
+			lightingInputs.push_back(values[j]);
+	}
+
+	if (!skinned && _lightingValid && lightingInputs == _lightingInputs)
+		return;
+
+	_lightingInputs = lightingInputs;
+	_lightingValid = true;
+
+	Math::Matrix3 normalRotation = normalMatrix.getRotation();
+
+	for (uint32 index = 0; index < _vertexCount; index++) {
+		const ActorVertex &vertex = _faceVBO[index];
+
+		// Compute the vertex position and normal in eye-space
+		Math::Vector4d modelEyePosition = modelViewMatrix * Math::Vector4d(vertex.x, vertex.y, vertex.z, 1.0);
+		Math::Vector3d modelEyeNormal = normalRotation * Math::Vector3d(vertex.nx, vertex.ny, vertex.nz);
+		modelEyeNormal.normalize();
+
+		Math::Vector3d lightColor = ambient->color;
+
+		for (uint li = 0; li < lights.size() - 1; li++) {
+			const LightEntry *l = lights[li + 1];
+
+			switch (l->type) {
+				case LightEntry::kPoint: {
+					Math::Vector3d vertexToLight = l->eyePosition.getXYZ() - modelEyePosition.getXYZ();
+
+					float dist = vertexToLight.length();
+					vertexToLight.normalize();
+					float attn = CLIP((l->falloffFar - dist) / MAX(0.001f,  l->falloffFar - l->falloffNear), 0.0f, 1.0f);
+					float incidence = MAX(0.0f, Math::Vector3d::dotProduct(modelEyeNormal, vertexToLight));
+					lightColor += l->color * attn * incidence;
+					break;
+				}
+				case LightEntry::kDirectional: {
+					float incidence = MAX(0.0f, Math::Vector3d::dotProduct(modelEyeNormal, -l->eyeDirection));
+					lightColor += (l->color * incidence);
+					break;
+				}
+				case LightEntry::kSpot: {
+					Math::Vector3d vertexToLight = l->eyePosition.getXYZ() - modelEyePosition.getXYZ();
+
+					float dist = vertexToLight.length();
+					float attn = CLIP((l->falloffFar - dist) / MAX(0.001f, l->falloffFar - l->falloffNear), 0.0f, 1.0f);
+
+					vertexToLight.normalize();
+					float incidence = MAX(0.0f, modelEyeNormal.dotProduct(vertexToLight));
+
+					float cosAngle = MAX(0.0f, vertexToLight.dotProduct(-l->eyeDirection));
+					float cone = CLIP((cosAngle - l->innerConeAngle.getCosine()) / MAX(0.001f, l->outerConeAngle.getCosine() - l->innerConeAngle.getCosine()), 0.0f, 1.0f);
+
+					lightColor += l->color * attn * incidence * cone;
+					break;
+				}
+				default:
+					break;
+			}
+		}
+
+		lightColor.x() = CLIP(lightColor.x(), 0.0f, 1.0f);
+		lightColor.y() = CLIP(lightColor.y(), 0.0f, 1.0f);
+		lightColor.z() = CLIP(lightColor.z(), 0.0f, 1.0f);
+		_vertexLight[index] = lightColor;
+	}
+}
+
+void TinyGLActorRenderer::updateShadow(const Math::Vector3d &lightDirection, bool skinned) {
+	if (!skinned && _shadowValid && lightDirection == _shadowLightDirection)
+		return;
+
+	_shadowLightDirection = lightDirection;
+	_shadowValid = true;
+
+	for (uint32 index = 0; index < _vertexCount; index++) {
+		ActorVertex &vertex = _faceVBO[index];
+		Math::Vector3d modelPosition(vertex.x, vertex.y, vertex.z);
+		Math::Vector3d shadowPosition = modelPosition + lightDirection * (-modelPosition.y() / lightDirection.y());
+		vertex.sx = shadowPosition.x();
+		vertex.sy = 0.0f;
+		vertex.sz = shadowPosition.z();
+	}
+}
+
 void TinyGLActorRenderer::clearVertices() {
 	delete[] _faceVBO;
 	_faceVBO = nullptr;
+	_vertexCount = 0;
+	_vertexLight.clear();
+
+	_skinningValid = false;
+	_lightingValid = false;
+	_shadowValid = false;
 
 	for (FaceBufferMap::iterator it = _faceEBO.begin(); it != _faceEBO.end(); ++it) {
 		delete[] it->_value;
@@ -289,6 +375,8 @@ void TinyGLActorRenderer::clearVertices() {
 
 void TinyGLActorRenderer::uploadVertices() {
 	_faceVBO = createModelVBO(_model);
+	_vertexCount = _model->getVertices().size();
+	_vertexLight.resize(_vertexCount);
 
 	Common::Array<Face *> faces = _model->getFaces();
 	for (Common::Array<Face *>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
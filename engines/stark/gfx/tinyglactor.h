@@ -32,6 +32,9 @@
 #include "common/hash-ptr.h"
 
 namespace Stark {
+
+class BoneNode;
+
 namespace Gfx {
 
 class TinyGLDriver;
@@ -66,6 +69,12 @@ struct _ActorVertex {
 };
 typedef _ActorVertex ActorVertex;
 
+/** A bone transformation, as used by the skinning loop */
+struct SkinningBone {
+	float px, py, pz;
+	float qx, qy, qz, qw;
+};
+
 class TinyGLActorRenderer : public VisualActor {
 public:
 	TinyGLActorRenderer(TinyGLDriver *gfx);
@@ -79,10 +88,28 @@ protected:
 	TinyGLDriver *_gfx;
 
 	ActorVertex *_faceVBO;
+	uint32 _vertexCount;
 	FaceBufferMap _faceEBO;
 
+	// Inputs of the last computed skinning, lighting and shadow
+	Common::Array<SkinningBone> _skinningBones;
+	Common::Array<float> _lightingInputs;
+	Math::Vector3d _shadowLightDirection;
+	bool _skinningValid;
+	bool _lightingValid;
+	bool _shadowValid;
+
+	/** Per vertex light color, before being modulated by the material */
+	Common::Array<Math::Vector3d> _vertexLight;
+
 	void clearVertices();
 	void uploadVertices();
+
+	/** Skin the vertices for the current pose, returns false if the pose did not change */
+	bool updateSkinning(const Common::Array<BoneNode *> &bones);
+	void updateLighting(const LightEntryArray &lights, const Math::Matrix4 &modelViewMatrix,
+			const Math::Matrix4 &normalMatrix, bool skinned);
+	void updateShadow(const Math::Vector3d &lightDirection, bool skinned);
 	ActorVertex *createModelVBO(const Model *model);
 	uint32 *createFaceEBO(const Face *face);
 	void setLightArrayUniform(const LightEntryArray &lights);
@@ -586,20 +586,41 @@ bool XorStream::open(Common::SeekableReadStream *stream, int len, const XorKey &
 	_start = _s->pos();
 	_previous = (len & 0xFF);
 	_key = key;
+	_keyPhase = -1;
 	_size = len;
 	return true;
 }
 
+void XorStream::setupKeyStream(int phase) {
+	for (int i = 0; i < ARRAYSIZE(_keyStream); i++)
+		_keyStream[i] = (byte)(_key.magicBytes[(phase + i) & 0x0F] ^ ((uint32)i * (uint32)_key.multiplier));
+	_keyPhase = phase;
+}
+
 uint32 XorStream::read(void *dataPtr, uint32 dataSize) {
 	int p = (int)pos();
 	uint32 result = _s->read(dataPtr, dataSize);
-	char *buf = (char *)dataPtr;
-	for (size_t i = 0; i < dataSize; i++) {
-		int x = buf[i] ^ _key.magicBytes[p & 0x0F] ^ (i * _key.multiplier);
-		buf[i] = (char)(x ^ _previous);
-		_previous = x;
-		p++;
+	byte *buf = (byte *)dataPtr;
+
+	// Every byte is xored with the key and with the previous byte as it was
+	// before that. Only the low byte of _previous is ever used.
+	if ((p & 0x0F) != _keyPhase)
+		setupKeyStream(p & 0x0F);
+
+	uint64 previous = (byte)_previous;
+	uint32 i = 0;
+	for (; i + 8 <= dataSize; i += 8) {
+		uint64 x = READ_LE_UINT64(buf + i) ^ READ_LE_UINT64(_keyStream + (i & 0xFF));
+		WRITE_LE_UINT64(buf + i, x ^ ((x << 8) | previous));
+		previous = x >> 56;
 	}
+	for (; i < dataSize; i++) {
+		byte x = buf[i] ^ _keyStream[i & 0xFF];
+		buf[i] = x ^ (byte)previous;
+		previous = x;
+	}
+
+	_previous = (int)previous;
 	return result;
 }
 
@@ -678,17 +699,23 @@ bool GGPackEntryReader::open(GGPackDecoder &pack, const Common::String &entry) {
 	if (!xs.open(&rs, e.size, pack._key))
 		return false;
 
-	_buf.resize(e.size);
-	xs.read(_buf.data(), e.size);
+	_buf.reset(new Common::Array<byte>(e.size));
+	xs.read(_buf->data(), e.size);
 
-	return _ms.open(_buf.data(), e.size);
+	return _ms.open(_buf->data(), e.size);
 }
 
 bool GGPackEntryReader::open(GGPackSet &packs, const Common::String &entry) {
+	_buf = packs.getCachedEntry(entry);
+	if (_buf)
+		return _ms.open(_buf->data(), _buf->size());
+
 	for (auto it = packs._packs.begin(); it != packs._packs.end(); it++) {
 		GGPackDecoder *pack = &it->second;
-		if (open(*pack, entry))
+		if (open(*pack, entry)) {
+			packs.cacheEntry(entry, _buf);
 			return true;
+		}
 	}
 	return false;
 }
@@ -738,6 +765,8 @@ bool GGPackSet::containsDLC() const {
 }
 
 void GGPackSet::init(const XorKey &key) {
+	clearCache();
+
 	Common::ArchiveMemberList fileList;
 	SearchMan.listMatchingMembers(fileList, "*.ggpack*");
 
@@ -773,6 +802,55 @@ bool GGPackSet::assetExists(const char *asset) {
 	return false;
 }
 
+GGPackBuffer GGPackSet::getCachedEntry(const Common::String &entry) {
+	auto it = _cache.find(entry);
+	if (it == _cache.end())
+		return GGPackBuffer();
+
+	CachedEntry &cached = it->_value;
+	if (cached.lru != _lru.begin()) {
+		_lru.erase(cached.lru);
+		_lru.push_front(entry);
+		cached.lru = _lru.begin();
+	}
+	return cached.data;
+}
+
+void GGPackSet::cacheEntry(const Common::String &entry, GGPackBuffer data) {
+	uint32 size = data->size();
+	// Huge entries such as music would only push everything else out
+	if (size > _cacheBudget / 4 || _cache.contains(entry))
+		return;
+
+	trimCache(_cacheBudget - size);
+
+	_lru.push_front(entry);
+	CachedEntry &cached = _cache[entry];
+	cached.data = data;
+	cached.lru = _lru.begin();
+	_cacheSize += size;
+}
+
+void GGPackSet::trimCache(uint32 budget) {
+	while (_cacheSize > budget && !_lru.empty()) {
+		auto it = _cache.find(_lru.back());
+		_cacheSize -= it->_value.data->size();
+		_cache.erase(it);
+		_lru.pop_back();
+	}
+}
+
+void GGPackSet::setCacheBudget(uint32 bytes) {
+	_cacheBudget = bytes;
+	trimCache(bytes);
+}
+
+void GGPackSet::clearCache() {
+	_cache.clear();
+	_lru.clear();
+	_cacheSize = 0;
+}
+
 GGHashMapEncoder::GGHashMapEncoder() {
 }
 
@@ -26,6 +26,7 @@
 #include "common/stream.h"
 #include "common/list.h"
 #include "common/path.h"
+#include "common/ptr.h"
 #include "common/stablemap.h"
 #include "common/formats/json.h"
 
@@ -86,12 +87,19 @@ public:
 	int64 size() const;
 	bool seek(int64 offset, int whence = SEEK_SET);
 
+private:
+	void setupKeyStream(int phase);
+
 private:
 	Common::SeekableReadStream *_s = nullptr;
 	int _previous = 0;
 	int _start = 0;
 	int _size = 0;
 	XorKey _key;
+	// The key of the i-th byte of a read repeats every 256 bytes, this holds
+	// one period for reads starting at a stream position of phase _keyPhase
+	byte _keyStream[256];
+	int _keyPhase = -1;
 };
 
 class RangeStream : public Common::SeekableReadStream {
@@ -158,7 +166,7 @@ struct GGPackEntry {
 	int offset, size;
 };
 
-typedef Common::HashMap<Common::String, GGPackEntry, Common::IgnoreCase_Hash> GGPackEntries;
+typedef Common::HashMap<Common::String, GGPackEntry, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> GGPackEntries;
 
 class GGPackDecoder {
 public:
@@ -177,15 +185,43 @@ private:
 	Common::SeekableReadStream *_s = nullptr;
 };
 
+typedef Common::SharedPtr<Common::Array<byte> > GGPackBuffer;
+
 class GGPackSet {
 public:
+	// Default for the total size of the decoded entries kept in memory
+	static const uint32 kDefaultCacheBudget = 16 * 1024 * 1024;
+
 	void init(const XorKey &key);
 	bool assetExists(const char *asset);
 
 	bool containsDLC() const;
 
+	// Returns the decoded entry if it is cached, or a null pointer
+	GGPackBuffer getCachedEntry(const Common::String &entry);
+	// Keeps a decoded entry, dropping the least recently used ones when over budget
+	void cacheEntry(const Common::String &entry, GGPackBuffer data);
+	void setCacheBudget(uint32 bytes);
+	void clearCache();
+
+private:
+	void trimCache(uint32 budget);
+
 public:
 	Common::StableMap<long, GGPackDecoder, Common::Greater<long> > _packs;
+
+private:
+	typedef Common::List<Common::String> LruList;
+
+	struct CachedEntry {
+		GGPackBuffer data;
+		LruList::iterator lru;
+	};
+
+	Common::HashMap<Common::String, CachedEntry, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> _cache;
+	LruList _lru; // most recently used first
+	uint32 _cacheSize = 0;
+	uint32 _cacheBudget = kDefaultCacheBudget;
 };
 
 class GGBnutReader : public Common::ReadStream {
@@ -217,7 +253,7 @@ public:
 	bool seek(int64 offset, int whence = SEEK_SET) override;
 
 private:
-	Common::Array<byte> _buf;
+	GGPackBuffer _buf;
 	MemStream _ms;
 };
 
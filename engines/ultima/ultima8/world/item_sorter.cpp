@@ -48,7 +48,7 @@ static const uint32 HIGHLIGHT_COLOR = TEX32_PACK_RGBA(0xFF, 0xFF, 0x00, 0x1F);
 ItemSorter::ItemSorter(int capacity) :
 	_shapes(nullptr), _clipWindow(0, 0, 0, 0), _items(nullptr), _itemsTail(nullptr),
 	_itemsUnused(nullptr), _painted(nullptr), _camSx(0), _camSy(0),
-	_sortLimit(0), _sortLimitChanged(false) {
+	_sortLimit(0), _sortLimitChanged(false), _gridWidth(0), _gridHeight(0), _gridStamp(0) {
 	int i = capacity;
 	while (i--) {
 		SortItem *next = _itemsUnused;
@@ -74,7 +74,7 @@ ItemSorter::~ItemSorter() {
 
 void ItemSorter::BeginDisplayList(const Rect &clipWindow, const Point3 &cam) {
 	// Get the _shapes, if required
-	if (!_shapes) _shapes = GameData::get_instance()->getMainShapes();
+	if (!_shapes && GameData::get_instance()) _shapes = GameData::get_instance()->getMainShapes();
 
 	// Set the clip window, and reset the item list
 	_clipWindow = clipWindow;
@@ -88,6 +88,14 @@ void ItemSorter::BeginDisplayList(const Rect &clipWindow, const Point3 &cam) {
 	_itemsTail = nullptr;
 	_painted = nullptr;
 
+	// Reset the grid, keeping the cell arrays allocated
+	_gridWidth = MAX<int32>(1, (clipWindow.right - clipWindow.left + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE);
+	_gridHeight = MAX<int32>(1, (clipWindow.bottom - clipWindow.top + GRID_CELL_SIZE - 1) / GRID_CELL_SIZE);
+	if (_grid.size() < (uint)(_gridWidth * _gridHeight))
+		_grid.resize(_gridWidth * _gridHeight);
+	for (uint i = 0; i < _grid.size(); i++)
+		_grid[i].clear();
+
 	// Screenspace bounding box bottom x coord (RNB x coord)
 	int32 camSx = (cam.x - cam.y) / 4;
 	// Screenspace bounding box bottom extent  (RNB y coord)
@@ -105,9 +113,7 @@ void ItemSorter::BeginDisplayList(const Rect &clipWindow, const Point3 &cam) {
 void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, uint32 flags, uint32 ext_flags, uint16 itemNum) {
 
 	// First thing, get a SortItem to use (first of unused)
-	if (!_itemsUnused)
-		_itemsUnused = new SortItem();
-	SortItem *si = _itemsUnused;
+	SortItem *si = GetUnusedItem();
 
 	si->_itemNum = itemNum;
 	si->_shape = _shapes->getShape(shapeNum);
@@ -179,15 +185,60 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 		si->_invitem = info->is_invitem();
 	}
 
+	InsertItem(si);
+}
+
+SortItem *ItemSorter::GetUnusedItem() {
+	if (!_itemsUnused)
+		_itemsUnused = new SortItem();
+	return _itemsUnused;
+}
+
+void ItemSorter::GetGridCells(const Rect &r, int32 &x1, int32 &y1, int32 &x2, int32 &y2) const {
+	// Rects reaching outside the clip window are clamped to the edge cells
+	x1 = CLIP<int32>((r.left - _clipWindow.left) / GRID_CELL_SIZE, 0, _gridWidth - 1);
+	x2 = CLIP<int32>((r.right - _clipWindow.left) / GRID_CELL_SIZE, 0, _gridWidth - 1);
+	y1 = CLIP<int32>((r.top - _clipWindow.top) / GRID_CELL_SIZE, 0, _gridHeight - 1);
+	y2 = CLIP<int32>((r.bottom - _clipWindow.top) / GRID_CELL_SIZE, 0, _gridHeight - 1);
+}
+
+void ItemSorter::InsertItem(SortItem *si) {
 	si->_occluded = false;
 	si->_order = -1;
+	si->_gridStamp = 0;
 
 	// We will clear all the vector memory
 	// Stictly speaking the vector will sort of leak memory, since they
 	// are never deleted
 	si->_depends.clear();
 
-	// Iterate the list and compare _shapes
+	// Mark the items which can overlap us. Overlapping requires the
+	// screenspace rects to intersect, so only items sharing a grid cell
+	// need looking at.
+	if (++_gridStamp == 0) {
+		for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next)
+			si2->_gridStamp = 0;
+		_gridStamp = 1;
+	}
+
+	int32 cx1, cy1, cx2, cy2;
+	GetGridCells(si->_sr, cx1, cy1, cx2, cy2);
+
+	int candidates = 0;
+	for (int32 cy = cy1; cy <= cy2; cy++) {
+		for (int32 cx = cx1; cx <= cx2; cx++) {
+			for (auto *si2 : _grid[cy * _gridWidth + cx]) {
+				if (si2->_gridStamp != _gridStamp && !si2->_occluded && si->_sr.intersects(si2->_sr)) {
+					si2->_gridStamp = _gridStamp;
+					candidates++;
+				}
+			}
+		}
+	}
+
+	// Iterate the list and compare _shapes. The list order still matters,
+	// both for the insert point and for which items get compared before
+	// we find out we're occluded.
 
 	// Ok,
 	SortItem *addpoint = nullptr;
@@ -196,10 +247,17 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 		if (!addpoint && si->listLessThan(*si2))
 			addpoint = si2;
 
+		const bool candidate = si2->_gridStamp == _gridStamp;
+		if (candidate)
+			candidates--;
+#ifndef SORTITEM_OCCLUSION_EXPERIMENTAL
+		else if (addpoint && !candidates)
+			break; // Nothing left to compare against
+		else
+			continue;
+#else
 		if (si2->_occluded)
 			continue;
-
-#ifdef SORTITEM_OCCLUSION_EXPERIMENTAL
 		// Find adjoining rects for better occlusion
 		if (si->_occl && si2->_occl && si->_z == si2->_z) {
 			// Does this share an edge?
@@ -218,6 +276,9 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 				}
 			}
 		}
+
+		if (!candidate)
+			continue;
 #endif // SORTITEM_OCCLUSION_EXPERIMENTAL
 
 		// Attempt to find paint dependency order
@@ -267,8 +328,15 @@ void ItemSorter::AddItem(const Point3 &pt, uint32 shapeNum, uint32 frame_num, ui
 		si->_prev = _itemsTail;
 		_itemsTail = si;
 	}
+
+	// And to the grid
+	for (int32 cy = cy1; cy <= cy2; cy++) {
+		for (int32 cx = cx1; cx <= cx2; cx++)
+			_grid[cy * _gridWidth + cx].push_back(si);
+	}
 }
 
+
 void ItemSorter::AddItem(const Item *add) {
 	AddItem(add->getLerped(), add->getShape(), add->getFrame(),
 			add->getFlags(), add->getExtFlags(), add->getObjId());
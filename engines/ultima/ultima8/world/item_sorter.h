@@ -22,8 +22,11 @@
 #ifndef ULTIMA8_WORLD_ITEMSORTER_H
 #define ULTIMA8_WORLD_ITEMSORTER_H
 
+#include "common/array.h"
 #include "ultima/ultima8/misc/rect.h"
 
+class U8ItemSorterTestSuite;
+
 namespace Ultima {
 namespace Ultima8 {
 
@@ -34,6 +37,8 @@ struct SortItem;
 struct Point3;
 
 class ItemSorter {
+	friend class ::U8ItemSorterTestSuite;
+
 	MainShapeArchive    *_shapes;
 	Rect        _clipWindow;
 
@@ -46,6 +51,14 @@ class ItemSorter {
 	int32       _sortLimit;
 	bool        _sortLimitChanged;
 
+	// Screenspace grid over the clip window. Each cell lists the items whose
+	// screenspace rect touches it, so a new item is only compared against
+	// items it can actually overlap.
+	static const int32 GRID_CELL_SIZE = 64;
+	Common::Array<Common::Array<SortItem *> > _grid;
+	int32       _gridWidth, _gridHeight;
+	uint32      _gridStamp;
+
 public:
 	ItemSorter(int capacity);
 	~ItemSorter();
@@ -71,6 +84,15 @@ public:
 
 private:
 	bool PaintSortItem(RenderSurface *surf, SortItem *si, bool showFootpad, int gridlines);
+
+	// Get an unused SortItem to be filled in and passed to InsertItem()
+	SortItem *GetUnusedItem();
+
+	// Work out the dependencies of a filled in SortItem and link it into the display list
+	void InsertItem(SortItem *si);
+
+	// Get the range of grid cells covered by a screenspace rect
+	void GetGridCells(const Rect &r, int32 &x1, int32 &y1, int32 &x2, int32 &y2) const;
 };
 
 } // End of namespace Ultima8
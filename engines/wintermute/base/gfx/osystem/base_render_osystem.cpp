@@ -40,6 +40,10 @@
 #include "common/config-manager.h"
 
 #define DIRTY_RECT_LIMIT 800
+// Above this many dirty rects, a single redraw of their union is cheaper
+#define MAX_DIRTY_RECTS 16
+// Disjoint rects are merged if their union only adds this many pixels
+#define DIRTY_RECT_MERGE_SLACK (32 * 32)
 
 namespace Wintermute {
 
@@ -56,7 +60,6 @@ BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 
 	_borderLeft = _borderRight = _borderTop = _borderBottom = 0;
 	_ratioX = _ratioY = 1.0f;
-	_dirtyRect = nullptr;
 	_disableDirtyRects = false;
 	if (ConfMan.hasKey("dirty_rects")) {
 		_disableDirtyRects = !ConfMan.getBool("dirty_rects");
@@ -74,8 +77,6 @@ BaseRenderOSystem::~BaseRenderOSystem() {
 		delete ticket;
 	}
 
-	delete _dirtyRect;
-
 	_renderSurface->free();
 	delete _renderSurface;
 }
@@ -148,8 +149,7 @@ bool BaseRenderOSystem::forcedFlip() {
 bool BaseRenderOSystem::flip() {
 	if (_skipThisFrame) {
 		_skipThisFrame = false;
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		g_system->updateScreen();
 		_needsFlip = false;
 
@@ -159,6 +159,7 @@ bool BaseRenderOSystem::flip() {
 		for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
 			(*it)->_wantsDraw = false;
 		}
+		rebuildTicketIndex();
 
 		addDirtyRect(_renderRect);
 		return true;
@@ -188,8 +189,7 @@ bool BaseRenderOSystem::flip() {
 		if (_disableDirtyRects || screenChanged) {
 			g_system->copyRectToScreen(_renderSurface->getPixels(), _renderSurface->pitch, 0, 0, _renderSurface->w, _renderSurface->h);
 		}
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		_needsFlip = false;
 	}
 	_lastFrameIter = _renderQueue.end();
@@ -270,21 +270,17 @@ void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::S
 
 	if (owner) { // Fade-tickets are owner-less
 		RenderTicket compare(owner, nullptr, srcRect, dstRect, transform);
-		RenderQueueIterator it = _lastFrameIter;
-		++it;
-		// Avoid calling end() and operator* every time, when potentially going through
-		// LOTS of tickets.
-		RenderQueueIterator endIterator = _renderQueue.end();
-		RenderTicket *compareTicket = nullptr;
-		for (; it != endIterator; ++it) {
-			compareTicket = *it;
-			if (*(compareTicket) == compare && compareTicket->_isValid) {
-				if (_disableDirtyRects) {
-					drawFromSurface(compareTicket);
-				} else {
-					drawFromQueuedTicket(it);
+		Common::HashMap<uint32, int>::const_iterator found = _ticketIndex.find(compare.hash());
+		if (found != _ticketIndex.end()) {
+			// The tickets that weren't drawn yet this frame are exactly the ones after
+			// _lastFrameIter, still in the order they were indexed in. The ones that
+			// were drawn may have been moved since, so their pos can't be used.
+			for (int i = found->_value; i >= 0; i = _indexedTickets[i].next) {
+				RenderTicket *compareTicket = _indexedTickets[i].ticket;
+				if (!compareTicket->_wantsDraw && compareTicket->_isValid && *(compareTicket) == compare) {
+					drawFromQueuedTicket(_indexedTickets[i].pos);
+					return;
 				}
-				return;
 			}
 		}
 	}
@@ -350,12 +346,71 @@ void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket)
 }
 
 void BaseRenderOSystem::addDirtyRect(const Common::Rect &rect) {
-	if (!_dirtyRect) {
-		_dirtyRect = new Common::Rect(rect);
-	} else {
-		_dirtyRect->extend(rect);
+	Common::Rect dirty(rect);
+	dirty.clip(_renderRect);
+	if (dirty.isEmpty()) {
+		return;
+	}
+
+	// Keep the rects disjoint, so every pixel is cleared and redrawn only once.
+	// Rects that are close enough are merged too, as one bigger blit is cheaper
+	// than many small ones.
+	uint i = 0;
+	while (i < _dirtyRects.size()) {
+		const Common::Rect &other = _dirtyRects[i];
+		Common::Rect merged(dirty);
+		merged.extend(other);
+
+		uint32 mergedArea = (uint32)merged.width() * merged.height();
+		uint32 separateArea = (uint32)dirty.width() * dirty.height() + (uint32)other.width() * other.height();
+		if (dirty.intersects(other) || mergedArea <= separateArea + DIRTY_RECT_MERGE_SLACK) {
+			dirty = merged;
+			_dirtyRects.remove_at(i);
+			// The grown rect may reach rects that were already checked
+			i = 0;
+		} else {
+			++i;
+		}
+	}
+	_dirtyRects.push_back(dirty);
+
+	if (_dirtyRects.size() > MAX_DIRTY_RECTS) {
+		for (i = 1; i < _dirtyRects.size(); i++) {
+			_dirtyRects[0].extend(_dirtyRects[i]);
+		}
+		_dirtyRects.resize(1);
+	}
+}
+
+void BaseRenderOSystem::rebuildTicketIndex() {
+	_ticketIndex.clear();
+	_indexedTickets.resize(0);
+
+	// Walk backwards, so that every chain ends up in queue order
+	RenderQueueIterator it = _renderQueue.end();
+	while (it != _renderQueue.begin()) {
+		--it;
+		RenderTicket *ticket = *it;
+		// Fade-tickets are owner-less, and never reused
+		if (!ticket->_owner) {
+			continue;
+		}
+
+		IndexedTicket entry;
+		entry.ticket = ticket;
+		entry.pos = it;
+
+		uint32 hash = ticket->hash();
+		Common::HashMap<uint32, int>::iterator head = _ticketIndex.find(hash);
+		if (head != _ticketIndex.end()) {
+			entry.next = head->_value;
+			head->_value = _indexedTickets.size();
+		} else {
+			entry.next = -1;
+			_ticketIndex[hash] = _indexedTickets.size();
+		}
+		_indexedTickets.push_back(entry);
 	}
-	_dirtyRect->clip(_renderRect);
 }
 
 void BaseRenderOSystem::drawTickets() {
@@ -374,13 +429,14 @@ void BaseRenderOSystem::drawTickets() {
 			++it;
 		}
 	}
-	if (!_dirtyRect || _dirtyRect->width() == 0 || _dirtyRect->height() == 0) {
+	if (_dirtyRects.empty()) {
 		it = _renderQueue.begin();
 		while (it != _renderQueue.end()) {
 			RenderTicket *ticket = *it;
 			ticket->_wantsDraw = false;
 			++it;
 		}
+		rebuildTicketIndex();
 		return;
 	}
 
@@ -389,24 +445,30 @@ void BaseRenderOSystem::drawTickets() {
 	// A special case: If the screen has one giant OPAQUE rect to be drawn, then we skip filling
 	// the background color. Typical use-case: Fullscreen FMVs.
 	// Caveat: The FPS-counter will invalidate this.
+	const RenderTicket *opaqueTicket = nullptr;
 	if (it != _lastFrameIter && _renderQueue.front() == _renderQueue.back() && (*it)->_transform._alphaDisable == true) {
+		opaqueTicket = *it;
+	}
+	for (uint i = 0; i < _dirtyRects.size(); i++) {
 		// If our single opaque rect fills the dirty rect, we can skip filling.
-		if (*_dirtyRect != (*it)->_dstRect) {
-			// Apply the clear-color to the dirty rect.
-			_renderSurface->fillRect(*_dirtyRect, _clearColor);
+		if (opaqueTicket && opaqueTicket->_dstRect.contains(_dirtyRects[i])) {
+			continue;
 		}
-		// Otherwise Do NOT fill.
-	} else {
 		// Apply the clear-color to the dirty rect.
-		_renderSurface->fillRect(*_dirtyRect, _clearColor);
+		_renderSurface->fillRect(_dirtyRects[i], _clearColor);
 	}
 	for (; it != _renderQueue.end(); ++it) {
 		RenderTicket *ticket = *it;
-		if (ticket->_dstRect.intersects(*_dirtyRect)) {
+		// The dirty rects don't overlap, so each of them can be redrawn on its own.
+		for (uint i = 0; i < _dirtyRects.size(); i++) {
+			const Common::Rect &dirtyRect = _dirtyRects[i];
+			if (!ticket->_dstRect.intersects(dirtyRect)) {
+				continue;
+			}
 			// dstClip is the area we want redrawn.
 			Common::Rect dstClip(ticket->_dstRect);
 			// reduce it to the dirty rect
-			dstClip.clip(*_dirtyRect);
+			dstClip.clip(dirtyRect);
 			// we need to keep track of the position to redraw the dirty rect
 			Common::Rect pos(dstClip);
 			int16 offsetX = ticket->_dstRect.left;
@@ -420,7 +482,10 @@ void BaseRenderOSystem::drawTickets() {
 		// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldn't become clear-color)
 		ticket->_wantsDraw = false;
 	}
-	g_system->copyRectToScreen(_renderSurface->getBasePtr(_dirtyRect->left, _dirtyRect->top), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
+	for (uint i = 0; i < _dirtyRects.size(); i++) {
+		const Common::Rect &dirtyRect = _dirtyRects[i];
+		g_system->copyRectToScreen(_renderSurface->getBasePtr(dirtyRect.left, dirtyRect.top), _renderSurface->pitch, dirtyRect.left, dirtyRect.top, dirtyRect.width(), dirtyRect.height());
+	}
 
 	it = _renderQueue.begin();
 	// Clean out the old tickets
@@ -435,6 +500,7 @@ void BaseRenderOSystem::drawTickets() {
 		}
 	}
 
+	rebuildTicketIndex();
 }
 
 // Replacement for SDL2's SDL_RenderCopy
@@ -536,6 +602,7 @@ void BaseRenderOSystem::endSaveLoad() {
 	// so just skip this single frame.
 	_skipThisFrame = true;
 	_lastFrameIter = _renderQueue.end();
+	rebuildTicketIndex();
 
 	_renderSurface->fillRect(Common::Rect(0, 0, _renderSurface->w, _renderSurface->h), _renderSurface->format.ARGBToColor(255, 0, 0, 0));
 	g_system->fillScreen(Common::Rect(0, 0, _renderSurface->w, _renderSurface->h), _renderSurface->format.ARGBToColor(255, 0, 0, 0));
@@ -30,6 +30,8 @@
 
 #include "engines/wintermute/base/gfx/base_renderer.h"
 
+#include "common/array.h"
+#include "common/hashmap.h"
 #include "common/rect.h"
 #include "common/list.h"
 
@@ -54,6 +56,11 @@ class RenderTicket;
  * being equal, this information is then used to check whether the draw order changed,
  * which will then create a need for redrawing, as we draw with an alpha-channel here.
  *
+ * Changed regions are tracked as a short list of non-overlapping dirty rects,
+ * so that two small changes at opposite ends of the screen don't force a redraw
+ * of everything in between. The tickets from last frame are indexed by a hash
+ * of their arguments, so finding a reusable ticket doesn't need to walk the queue.
+ *
  * There is also a draw path that draws without tickets, for debugging purposes,
  * as well as to accommodate situations with large enough amounts of draw calls,
  * that there will be too much overhead involved with comparing the generated tickets.
@@ -123,13 +130,29 @@ private:
 	 * Traverse the tickets that are dirty, and draw them
 	 */
 	void drawTickets();
+	/**
+	 * Index the tickets in the queue by their hash, for lookup during the next frame.
+	 */
+	void rebuildTicketIndex();
 	// Non-dirty-rects:
 	void drawFromSurface(RenderTicket *ticket);
 	// Dirty-rects:
 	void drawFromSurface(RenderTicket *ticket, Common::Rect *dstRect, Common::Rect *clipRect);
-	Common::Rect *_dirtyRect;
+	Common::Array<Common::Rect> _dirtyRects;
 	Common::List<RenderTicket *> _renderQueue;
 
+	/**
+	 * A queued ticket, as found in the ticket index. Tickets with the same hash
+	 * are chained through next, in the order they have in the queue.
+	 */
+	struct IndexedTicket {
+		RenderTicket *ticket;
+		RenderQueueIterator pos;
+		int next;
+	};
+	Common::Array<IndexedTicket> _indexedTickets;
+	Common::HashMap<uint32, int> _ticketIndex;
+
 	bool _needsFlip;
 	RenderQueueIterator _lastFrameIter;
 	Common::Rect _renderRect;
@@ -91,6 +91,20 @@ bool RenderTicket::operator==(const RenderTicket &t) const {
 	return true;
 }
 
+uint32 RenderTicket::hash() const {
+	uint32 h = (uint32)(uintptr)_owner;
+	h = h * 31 + (uint16)_dstRect.left;
+	h = h * 31 + (uint16)_dstRect.top;
+	h = h * 31 + (uint16)_dstRect.right;
+	h = h * 31 + (uint16)_dstRect.bottom;
+	h = h * 31 + (uint16)_srcRect.left;
+	h = h * 31 + (uint16)_srcRect.top;
+	h = h * 31 + (uint16)_srcRect.right;
+	h = h * 31 + (uint16)_srcRect.bottom;
+	h = h * 31 + _transform._rgbaMod;
+	return h;
+}
+
 // Replacement for SDL2's SDL_RenderCopy
 void RenderTicket::drawToSurface(Graphics::ManagedSurface *_targetSurface) const {
 	if (!getSurface()) {
@@ -27,6 +27,7 @@
 
 #include "engines/wintermute/base/scriptables/script_value.h"
 #include "engines/wintermute/base/scriptables/script.h"
+#include "engines/wintermute/base/scriptables/script_atom_table.h"
 #include "engines/wintermute/base/base_game.h"
 #include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/scriptables/script_engine.h"
@@ -56,6 +57,7 @@ ScScript::ScScript(BaseGame *inGame, ScEngine *engine) : BaseClass(inGame) {
 	_currentLine = 0;
 
 	_symbols = nullptr;
+	_symbolAtoms = nullptr;
 	_numSymbols = 0;
 
 	_engine = engine;
@@ -183,9 +185,12 @@ bool ScScript::initTables() {
 
 	_numSymbols = getDWORD();
 	_symbols = new char*[_numSymbols];
+	_symbolAtoms = new uint32[_numSymbols];
+	ScAtomTable *atoms = BaseEngine::instance().getAtomTable();
 	for (uint32 i = 0; i < _numSymbols; i++) {
 		uint32 index = getDWORD();
 		_symbols[index] = getString();
+		_symbolAtoms[index] = atoms->intern(_symbols[index]);
 	}
 
 	// load functions table
@@ -395,6 +400,8 @@ void ScScript::cleanup() {
 		delete[] _symbols;
 	}
 	_symbols = nullptr;
+	delete[] _symbolAtoms;
+	_symbolAtoms = nullptr;
 	_numSymbols = 0;
 
 	if (_globals && !_thread) {
@@ -559,9 +566,9 @@ bool ScScript::executeInstruction() {
 		_operand->setNULL();
 		dw = getDWORD();
 		if (_scopeStack->_sP < 0) {
-			_globals->setProp(_symbols[dw], _operand);
+			_globals->setProp(_symbolAtoms[dw], _operand);
 		} else {
-			_scopeStack->getTop()->setProp(_symbols[dw], _operand);
+			_scopeStack->getTop()->setProp(_symbolAtoms[dw], _operand);
 		}
 
 		break;
@@ -571,9 +578,9 @@ bool ScScript::executeInstruction() {
 		dw = getDWORD();
 		/*      char *temp = _symbols[dw]; // TODO delete */
 		// only create global var if it doesn't exist
-		if (!_engine->_globals->propExists(_symbols[dw])) {
+		if (!_engine->_globals->propExists(_symbolAtoms[dw])) {
 			_operand->setNULL();
-			_engine->_globals->setProp(_symbols[dw], _operand, false, inst == II_DEF_CONST_VAR);
+			_engine->_globals->setProp(_symbolAtoms[dw], _operand, false, inst == II_DEF_CONST_VAR);
 		}
 		break;
 	}
@@ -745,7 +752,8 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_VAR: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		dw = getDWORD();
+		ScValue *var = getVar(_symbols[dw], _symbolAtoms[dw]);
 		// Disabled in original code
 		/*if (false && var->_type==VAL_OBJECT || var->_type == VAL_NATIVE) {
 			_operand->setReference(var);
@@ -757,15 +765,16 @@ bool ScScript::executeInstruction() {
 	}
 
 	case II_PUSH_VAR_REF: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		dw = getDWORD();
+		ScValue *var = getVar(_symbols[dw], _symbolAtoms[dw]);
 		_operand->setReference(var);
 		_stack->push(_operand);
 		break;
 	}
 
 	case II_POP_VAR: {
-		char *varName = _symbols[getDWORD()];
-		ScValue *var = getVar(varName);
+		dw = getDWORD();
+		ScValue *var = getVar(_symbols[dw], _symbolAtoms[dw]);
 		if (var) {
 			ScValue *val = _stack->pop();
 			if (!val) {
@@ -816,7 +825,8 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_THIS:
-		_operand->setReference(getVar(_symbols[getDWORD()]));
+		dw = getDWORD();
+		_operand->setReference(getVar(_symbols[dw], _symbolAtoms[dw]));
 		_thisStack->push(_operand);
 		break;
 
@@ -1176,26 +1186,32 @@ uint32 ScScript::getMethodPos(const Common::String &name) const {
 
 //////////////////////////////////////////////////////////////////////////
 ScValue *ScScript::getVar(char *name) {
+	return getVar(name, BaseEngine::instance().getAtomTable()->intern(name));
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+ScValue *ScScript::getVar(char *name, uint32 atom) {
 	ScValue *ret = nullptr;
 
 	// scope locals
 	if (_scopeStack->_sP >= 0) {
-		if (_scopeStack->getTop()->propExists(name)) {
-			ret = _scopeStack->getTop()->getProp(name);
+		if (_scopeStack->getTop()->propExists(atom)) {
+			ret = _scopeStack->getTop()->getProp(atom);
 		}
 	}
 
 	// script globals
 	if (ret == nullptr) {
-		if (_globals->propExists(name)) {
-			ret = _globals->getProp(name);
+		if (_globals->propExists(atom)) {
+			ret = _globals->getProp(atom);
 		}
 	}
 
 	// engine globals
 	if (ret == nullptr) {
-		if (_engine->_globals->propExists(name)) {
-			ret = _engine->_globals->getProp(name);
+		if (_engine->_globals->propExists(atom)) {
+			ret = _engine->_globals->getProp(atom);
 		}
 	}
 
@@ -1205,11 +1221,11 @@ ScValue *ScScript::getVar(char *name) {
 		ScValue *val = new ScValue(_gameRef);
 		ScValue *scope = _scopeStack->getTop();
 		if (scope) {
-			scope->setProp(name, val);
-			ret = _scopeStack->getTop()->getProp(name);
+			scope->setProp(atom, val);
+			ret = _scopeStack->getTop()->getProp(atom);
 		} else {
-			_globals->setProp(name, val);
-			ret = _globals->getProp(name);
+			_globals->setProp(atom, val);
+			ret = _globals->getProp(atom);
 		}
 		delete val;
 	}
@@ -79,6 +79,7 @@ public:
 	TScriptState _state;
 	TScriptState _origState;
 	ScValue *getVar(char *name);
+	ScValue *getVar(char *name, uint32 atom);
 	uint32 getFuncPos(const Common::String &name);
 	uint32 getEventPos(const Common::String &name) const;
 	uint32 getMethodPos(const Common::String &name) const;
@@ -151,6 +152,8 @@ public:
 	bool externalCall(ScStack *stack, ScStack *thisStack, ScScript::TExternalFunction *function);
 private:
 	char **_symbols;
+	// The atoms of the symbols, interned when the script is loaded
+	uint32 *_symbolAtoms;
 	uint32 _numSymbols;
 	TFunctionPos *_functions;
 	TMethodPos *_methods;
@@ -0,0 +1,61 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "engines/wintermute/base/scriptables/script_atom_table.h"
+
+#include "common/str.h"
+
+namespace Wintermute {
+
+const uint32 ScAtomTable::kNoAtom;
+
+ScAtomTable::ScAtomTable() {
+}
+
+ScAtomTable::~ScAtomTable() {
+	for (uint32 i = 0; i < _names.size(); i++) {
+		free(_names[i]);
+	}
+}
+
+uint32 ScAtomTable::intern(const char *name) {
+	AtomMap::const_iterator it = _atoms.find(name);
+	if (it != _atoms.end()) {
+		return it->_value;
+	}
+
+	// The table keeps its own copy, as the keys point to it
+	char *copy = scumm_strdup(name);
+	uint32 atom = _names.size();
+	_names.push_back(copy);
+	_atoms[copy] = atom;
+	return atom;
+}
+
+uint32 ScAtomTable::find(const char *name) const {
+	AtomMap::const_iterator it = _atoms.find(name);
+	if (it != _atoms.end()) {
+		return it->_value;
+	}
+	return kNoAtom;
+}
+
+} // End of namespace Wintermute
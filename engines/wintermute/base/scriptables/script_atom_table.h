@@ -0,0 +1,69 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef WINTERMUTE_SCATOMTABLE_H
+#define WINTERMUTE_SCATOMTABLE_H
+
+#include "common/array.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+
+namespace Wintermute {
+
+/**
+ * The names of script variables and object properties.
+ * Every distinct name is assigned a small integer, its atom, the first time it
+ * is interned. ScValue keys its properties by atom, and scripts intern their
+ * symbol tables when they are loaded, so that a property access compares
+ * integers instead of hashing and comparing strings.
+ *
+ * Atoms are never released, since any saved or cached atom has to keep
+ * meaning the same name. The table grows with every distinct name, including
+ * names that scripts build at runtime, e.g. obj["slot" + i]. It is bounded by
+ * the number of distinct names a game uses during a session, and is freed
+ * with the engine.
+ */
+class ScAtomTable {
+public:
+	ScAtomTable();
+	~ScAtomTable();
+
+	static const uint32 kNoAtom = 0xFFFFFFFF;
+
+	/** Get the atom of a name, assigning a new one if the name is new */
+	uint32 intern(const char *name);
+	/** Get the atom of a name, or kNoAtom if it wasn't interned yet */
+	uint32 find(const char *name) const;
+	const char *getName(uint32 atom) const { return _names[atom]; }
+
+private:
+	struct NameEqualTo {
+		bool operator()(const char *x, const char *y) const { return strcmp(x, y) == 0; }
+	};
+
+	typedef Common::HashMap<const char *, uint32, Common::Hash<const char *>, NameEqualTo> AtomMap;
+	AtomMap _atoms;
+	Common::Array<char *> _names;
+};
+
+} // End of namespace Wintermute
+
+#endif
@@ -0,0 +1,127 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef WINTERMUTE_SCPROPERTYARRAY_H
+#define WINTERMUTE_SCPROPERTYARRAY_H
+
+#include "common/array.h"
+#include "engines/wintermute/base/scriptables/script_atom_table.h"
+
+namespace Wintermute {
+
+class ScValue;
+
+/**
+ * The properties of a script object, keyed by the atom of their name (see
+ * ScAtomTable). They are kept sorted by atom and found with a binary search.
+ * The values belong to the ScValue holding the array, which creates and
+ * deletes them.
+ */
+class ScPropertyArray {
+public:
+	struct Property {
+		uint32 atom;
+		ScValue *value;
+	};
+
+	uint size() const { return _props.size(); }
+	bool empty() const { return _props.empty(); }
+	Property &operator[](uint index) { return _props[index]; }
+	const Property &operator[](uint index) const { return _props[index]; }
+	void clear() { _props.clear(); }
+
+	/** Get the index of a property, or -1 if there is none for this atom */
+	int find(uint32 atom) const {
+		int lo = 0;
+		int hi = (int)_props.size() - 1;
+		while (lo <= hi) {
+			int mid = (lo + hi) / 2;
+			if (_props[mid].atom < atom) {
+				lo = mid + 1;
+			} else if (_props[mid].atom > atom) {
+				hi = mid - 1;
+			} else {
+				return mid;
+			}
+		}
+		return -1;
+	}
+
+	/** Get the value of a property, inserting it with a null value if it is new */
+	ScValue *&slot(uint32 atom) {
+		uint lo = 0;
+		uint hi = _props.size();
+		while (lo < hi) {
+			uint mid = (lo + hi) / 2;
+			if (_props[mid].atom < atom) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+
+		if (lo == _props.size() || _props[lo].atom != atom) {
+			Property prop;
+			prop.atom = atom;
+			prop.value = nullptr;
+			_props.insert_at(lo, prop);
+		}
+		return _props[lo].value;
+	}
+
+	/**
+	 * Save or restore the properties through a BasePersistenceManager.
+	 * Atoms are only valid for this session, so properties are saved by
+	 * name, and interned again when they are restored.
+	 */
+	template<class PersistenceManager>
+	bool persist(PersistenceManager *persistMgr, ScAtomTable *atoms) {
+		int32 size;
+		const char *str;
+		if (persistMgr->getIsSaving()) {
+			size = _props.size();
+			persistMgr->transferSint32("", &size);
+			for (uint i = 0; i < _props.size(); i++) {
+				str = atoms->getName(_props[i].atom);
+				persistMgr->transferConstChar("", &str);
+				persistMgr->transferPtr("", &_props[i].value);
+			}
+		} else {
+			ScValue *val = nullptr;
+			persistMgr->transferSint32("", &size);
+			for (int i = 0; i < size; i++) {
+				persistMgr->transferConstChar("", &str);
+				persistMgr->transferPtr("", &val);
+
+				slot(atoms->intern(str)) = val;
+				delete[] str;
+			}
+		}
+		return true;
+	}
+
+private:
+	Common::Array<Property> _props;
+};
+
+} // End of namespace Wintermute
+
+#endif
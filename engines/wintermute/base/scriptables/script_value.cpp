@@ -27,8 +27,10 @@
 
 #include "engines/wintermute/platform_osystem.h"
 #include "engines/wintermute/base/base_dynamic_buffer.h"
+#include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/base_game.h"
 #include "engines/wintermute/base/scriptables/script_value.h"
+#include "engines/wintermute/base/scriptables/script_atom_table.h"
 #include "engines/wintermute/base/scriptables/script.h"
 #include "engines/wintermute/utils/string_util.h"
 #include "engines/wintermute/base/base_scriptable.h"
@@ -182,24 +184,40 @@ ScValue *ScValue::getProp(const char *name) {
 	}
 
 	if (ret == nullptr) {
-		_valIter = _valObject.find(name);
-		if (_valIter != _valObject.end()) {
-			ret = _valIter->_value;
+		// A name that was never interned can't be the name of a property
+		int index = _valObject.find(BaseEngine::instance().getAtomTable()->find(name));
+		if (index >= 0) {
+			ret = _valObject[index].value;
 		}
 	}
 	return ret;
 }
 
+//////////////////////////////////////////////////////////////////////////
+ScValue *ScValue::getProp(uint32 atom) {
+	if (_type == VAL_VARIABLE_REF) {
+		return _valRef->getProp(atom);
+	}
+
+	// Strings and natives have properties of their own, which are looked up by name
+	if (_type == VAL_STRING || _type == VAL_NATIVE) {
+		return getProp(BaseEngine::instance().getAtomTable()->getName(atom));
+	}
+
+	int index = _valObject.find(atom);
+	return index >= 0 ? _valObject[index].value : nullptr;
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool ScValue::deleteProp(const char *name) {
 	if (_type == VAL_VARIABLE_REF) {
 		return _valRef->deleteProp(name);
 	}
 
-	_valIter = _valObject.find(name);
-	if (_valIter != _valObject.end()) {
-		delete _valIter->_value;
-		_valIter->_value = nullptr;
+	int index = _valObject.find(BaseEngine::instance().getAtomTable()->find(name));
+	if (index >= 0) {
+		delete _valObject[index].value;
+		_valObject[index].value = nullptr;
 	}
 
 	return STATUS_OK;
@@ -219,25 +237,7 @@ bool ScValue::setProp(const char *name, ScValue *val, bool copyWhole, bool setAs
 	}
 
 	if (DID_FAIL(ret)) {
-		ScValue *newVal = nullptr;
-
-		_valIter = _valObject.find(name);
-		if (_valIter != _valObject.end()) {
-			newVal = _valIter->_value;
-		}
-		if (!newVal) {
-			newVal = new ScValue(_gameRef);
-		} else {
-			newVal->cleanup();
-		}
-
-		newVal->copy(val, copyWhole);
-		newVal->_isConstVar = setAsConst;
-		_valObject[name] = newVal;
-
-		if (_type != VAL_NATIVE) {
-			_type = VAL_OBJECT;
-		}
+		storeProp(BaseEngine::instance().getAtomTable()->intern(name), val, copyWhole, setAsConst);
 
 		/*
 		_valIter = _valObject.find(Name);
@@ -258,23 +258,67 @@ bool ScValue::setProp(const char *name, ScValue *val, bool copyWhole, bool setAs
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+bool ScValue::setProp(uint32 atom, ScValue *val, bool copyWhole, bool setAsConst) {
+	if (_type == VAL_VARIABLE_REF) {
+		return _valRef->setProp(atom, val);
+	}
+
+	bool ret = STATUS_FAILED;
+	if (_type == VAL_NATIVE && _valNative) {
+		ret = _valNative->scSetProperty(BaseEngine::instance().getAtomTable()->getName(atom), val);
+	}
+
+	if (DID_FAIL(ret)) {
+		storeProp(atom, val, copyWhole, setAsConst);
+	}
+
+	return STATUS_OK;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void ScValue::storeProp(uint32 atom, ScValue *val, bool copyWhole, bool setAsConst) {
+	ScValue *&newVal = _valObject.slot(atom);
+	if (!newVal) {
+		newVal = new ScValue(_gameRef);
+	} else {
+		newVal->cleanup();
+	}
+
+	newVal->copy(val, copyWhole);
+	newVal->_isConstVar = setAsConst;
+
+	if (_type != VAL_NATIVE) {
+		_type = VAL_OBJECT;
+	}
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 bool ScValue::propExists(const char *name) {
 	if (_type == VAL_VARIABLE_REF) {
 		return _valRef->propExists(name);
 	}
-	_valIter = _valObject.find(name);
 
-	return (_valIter != _valObject.end());
+	return _valObject.find(BaseEngine::instance().getAtomTable()->find(name)) >= 0;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+bool ScValue::propExists(uint32 atom) {
+	if (_type == VAL_VARIABLE_REF) {
+		return _valRef->propExists(atom);
+	}
+
+	return _valObject.find(atom) >= 0;
 }
 
 
 //////////////////////////////////////////////////////////////////////////
 void ScValue::deleteProps() {
-	_valIter = _valObject.begin();
-	while (_valIter != _valObject.end()) {
-		delete(ScValue *)_valIter->_value;
-		_valIter++;
+	for (uint i = 0; i < _valObject.size(); i++) {
+		delete _valObject[i].value;
 	}
 	_valObject.clear();
 }
@@ -282,12 +326,11 @@ void ScValue::deleteProps() {
 
 //////////////////////////////////////////////////////////////////////////
 void ScValue::CleanProps(bool includingNatives) {
-	_valIter = _valObject.begin();
-	while (_valIter != _valObject.end()) {
-		if (!_valIter->_value->_isConstVar && (!_valIter->_value->isNative() || includingNatives)) {
-			_valIter->_value->setNULL();
+	for (uint i = 0; i < _valObject.size(); i++) {
+		ScValue *value = _valObject[i].value;
+		if (!value->_isConstVar && (!value->isNative() || includingNatives)) {
+			value->setNULL();
 		}
-		_valIter++;
 	}
 }
 
@@ -736,11 +779,12 @@ void ScValue::copy(ScValue *orig, bool copyWhole) {
 
 	// copy properties
 	if (orig->_type == VAL_OBJECT && orig->_valObject.size() > 0) {
-		orig->_valIter = orig->_valObject.begin();
-		while (orig->_valIter != orig->_valObject.end()) {
-			_valObject[orig->_valIter->_key] = new ScValue(_gameRef);
-			_valObject[orig->_valIter->_key]->copy(orig->_valIter->_value);
-			orig->_valIter++;
+		// Both are sorted by atom, so the layout can be copied as is
+		_valObject = orig->_valObject;
+		for (uint i = 0; i < _valObject.size(); i++) {
+			ScValue *value = new ScValue(_gameRef);
+			value->copy(orig->_valObject[i].value);
+			_valObject[i].value = value;
 		}
 	} else {
 		_valObject.clear();
@@ -794,30 +838,7 @@ bool ScValue::persist(BasePersistenceManager *persistMgr) {
 	persistMgr->transferSint32(TMEMBER(_valInt));
 	persistMgr->transferPtr(TMEMBER_PTR(_valNative));
 
-	int32 size;
-	const char *str;
-	if (persistMgr->getIsSaving()) {
-		size = _valObject.size();
-		persistMgr->transferSint32("", &size);
-		_valIter = _valObject.begin();
-		while (_valIter != _valObject.end()) {
-			str = _valIter->_key.c_str();
-			persistMgr->transferConstChar("", &str);
-			persistMgr->transferPtr("", &_valIter->_value);
-
-			_valIter++;
-		}
-	} else {
-		ScValue *val = nullptr;
-		persistMgr->transferSint32("", &size);
-		for (int i = 0; i < size; i++) {
-			persistMgr->transferConstChar("", &str);
-			persistMgr->transferPtr("", &val);
-
-			_valObject[str] = val;
-			delete[] str;
-		}
-	}
+	_valObject.persist(persistMgr, BaseEngine::instance().getAtomTable());
 
 	persistMgr->transferPtr(TMEMBER_PTR(_valRef));
 	persistMgr->transferCharPtr(TMEMBER(_valString));
@@ -879,14 +900,12 @@ bool ScValue::persist(BasePersistenceManager *persistMgr) {
 
 //////////////////////////////////////////////////////////////////////////
 bool ScValue::saveAsText(BaseDynamicBuffer *buffer, int indent) {
-	_valIter = _valObject.begin();
-	while (_valIter != _valObject.end()) {
+	ScAtomTable *atoms = BaseEngine::instance().getAtomTable();
+	for (uint i = 0; i < _valObject.size(); i++) {
 		buffer->putTextIndent(indent, "PROPERTY {\n");
-		buffer->putTextIndent(indent + 2, "NAME=\"%s\"\n", _valIter->_key.c_str());
-		buffer->putTextIndent(indent + 2, "VALUE=\"%s\"\n", _valIter->_value->getString());
+		buffer->putTextIndent(indent + 2, "NAME=\"%s\"\n", atoms->getName(_valObject[i].atom));
+		buffer->putTextIndent(indent + 2, "VALUE=\"%s\"\n", _valObject[i].value->getString());
 		buffer->putTextIndent(indent, "}\n\n");
-
-		_valIter++;
 	}
 	return STATUS_OK;
 }
@@ -32,6 +32,8 @@
 #include "engines/wintermute/base/base.h"
 #include "engines/wintermute/persistent.h"
 #include "engines/wintermute/base/scriptables/dcscript.h"   // Added by ClassView
+#include "engines/wintermute/base/scriptables/script_property_array.h"
+#include "common/array.h"
 #include "common/str.h"
 
 namespace Wintermute {
@@ -52,6 +54,7 @@ public:
 	void setValue(ScValue *val);
 	bool _persistent;
 	bool propExists(const char *name);
+	bool propExists(uint32 atom);
 	void copy(ScValue *orig, bool copyWhole = false);
 	void setStringVal(const char *val);
 	TValType getType();
@@ -81,7 +84,9 @@ public:
 	bool isInt();
 	bool isObject();
 	bool setProp(const char *name, ScValue *val, bool copyWhole = false, bool setAsConst = false);
+	bool setProp(uint32 atom, ScValue *val, bool copyWhole = false, bool setAsConst = false);
 	ScValue *getProp(const char *name);
+	ScValue *getProp(uint32 atom);
 	BaseScriptable *_valNative;
 	ScValue *_valRef;
 private:
@@ -97,14 +102,15 @@ public:
 	ScValue(BaseGame *inGame, double Val);
 	ScValue(BaseGame *inGame, const char *Val);
 	~ScValue() override;
-	Common::HashMap<Common::String, ScValue *> _valObject;
-	Common::HashMap<Common::String, ScValue *>::iterator _valIter;
+	ScPropertyArray _valObject;
 
 	bool setProperty(const char *propName, int32 value);
 	bool setProperty(const char *propName, const char *value);
 	bool setProperty(const char *propName, double value);
 	bool setProperty(const char *propName, bool value);
 	bool setProperty(const char *propName);
+private:
+	void storeProp(uint32 atom, ScValue *val, bool copyWhole, bool setAsConst);
 };
 
 } // End of namespace Wintermute
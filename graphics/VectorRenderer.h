@@ -494,6 +494,15 @@ public:
 	 */
 	virtual void drawStep(const Common::Rect &area, const Common::Rect &clip, const DrawStep &step, uint32 extra = 0);
 
+	/**
+	 * Applies the colors and settings of the specified draw step, without
+	 * drawing anything. This leaves the renderer in the same state as
+	 * drawStep() would.
+	 *
+	 * @see drawStep
+	 */
+	void setStepState(const Common::Rect &area, const Common::Rect &clip, const DrawStep &step, uint32 extra = 0);
+
 	/**
 	 * Copies the part of the current frame to the system overlay.
 	 *
@@ -0,0 +1,172 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+#include "common/system.h"
+
+#include "graphics/VectorRendererSpec.h"
+#include "graphics/pixelformat.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Graphics {
+
+// All kernels below compute d + (((s - d) * alpha) >> 8) per channel, the
+// same as VectorRendererSpec::blendPixelPtr does. Written as
+// (d * (256 - alpha) + s * alpha) >> 8 both terms are unsigned and the sum
+// never exceeds 255 * 256, so the whole computation fits into 16 bit lanes
+// and the result is bit-identical to the scalar code.
+
+int VectorRendererSSE2::_cpuSupport = -1;
+
+bool VectorRendererSSE2::isSupported(const PixelFormat &format) {
+	if (_cpuSupport < 0)
+		_cpuSupport = g_system->hasFeature(OSystem::kFeatureCpuSSE2) ? 1 : 0;
+
+	if (!_cpuSupport)
+		return false;
+
+	if (format.bytesPerPixel == 2)
+		return true;
+
+	if (format.bytesPerPixel != 4)
+		return false;
+
+	// The 32 bit kernel treats the pixel as four independent bytes.
+	if (format.rLoss || format.gLoss || format.bLoss)
+		return false;
+	if ((format.rShift | format.gShift | format.bShift) & 7)
+		return false;
+	if (format.aLoss != 8 && (format.aLoss != 0 || (format.aShift & 7)))
+		return false;
+
+	return true;
+}
+
+void VectorRendererSSE2::blendFill(uint32 *first, uint32 *last, uint32 color, uint8 alpha, const PixelFormat &format) {
+	const uint32 rgbMask = format.ARGBToColor(0, 0xff, 0xff, 0xff);
+	const uint32 alphaMask = format.aLoss == 8 ? 0 : ((0xffu >> format.aLoss) << format.aShift);
+	const uint32 outMask = rgbMask | alphaMask;
+
+	// The alpha channel is always blended towards fully opaque
+	const uint32 src = (color & rgbMask) | alphaMask;
+
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i mask = _mm_set1_epi32((int)outMask);
+	const __m128i inv = _mm_set1_epi16((short)(256 - alpha));
+	const __m128i srcAlpha = _mm_mullo_epi16(_mm_unpacklo_epi8(_mm_set1_epi32((int)src), zero), _mm_set1_epi16(alpha));
+
+	while (last - first >= 4) {
+		__m128i dst = _mm_loadu_si128((const __m128i *)first);
+		__m128i lo = _mm_unpacklo_epi8(dst, zero);
+		__m128i hi = _mm_unpackhi_epi8(dst, zero);
+
+		lo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(lo, inv), srcAlpha), 8);
+		hi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(hi, inv), srcAlpha), 8);
+
+		_mm_storeu_si128((__m128i *)first, _mm_and_si128(_mm_packus_epi16(lo, hi), mask));
+		first += 4;
+	}
+
+	while (first < last) {
+		uint32 d = *first, out = 0;
+		for (int shift = 0; shift < 32; shift += 8) {
+			uint32 dc = (d >> shift) & 0xff;
+			uint32 sc = (src >> shift) & 0xff;
+			out |= ((dc * (256 - alpha) + sc * alpha) >> 8) << shift;
+		}
+		*first++ = out & outMask;
+	}
+}
+
+void VectorRendererSSE2::blendFill(uint16 *first, uint16 *last, uint16 color, uint8 alpha, const PixelFormat &format) {
+	const uint8 losses[4] = { format.rLoss, format.gLoss, format.bLoss, format.aLoss };
+	const uint8 shifts[4] = { format.rShift, format.gShift, format.bShift, format.aShift };
+
+	int numChannels = 0;
+	uint16 channelMask[4], channelSrc[4];
+	uint8 channelShift[4];
+	__m128i vMask[4], vSrcAlpha[4], vShift[4];
+
+	for (int i = 0; i < 4; i++) {
+		if (losses[i] >= 8)
+			continue;
+
+		const uint16 mask = 0xff >> losses[i];
+		channelMask[numChannels] = mask;
+		channelShift[numChannels] = shifts[i];
+		// The alpha channel is always blended towards fully opaque
+		channelSrc[numChannels] = (i == 3) ? mask : ((color >> shifts[i]) & mask);
+
+		vMask[numChannels] = _mm_set1_epi16((short)mask);
+		vSrcAlpha[numChannels] = _mm_set1_epi16((short)(channelSrc[numChannels] * alpha));
+		vShift[numChannels] = _mm_cvtsi32_si128(shifts[i]);
+		numChannels++;
+	}
+
+	const __m128i inv = _mm_set1_epi16((short)(256 - alpha));
+
+	while (last - first >= 8) {
+		__m128i dst = _mm_loadu_si128((const __m128i *)first);
+		__m128i out = _mm_setzero_si128();
+
+		for (int i = 0; i < numChannels; i++) {
+			__m128i c = _mm_and_si128(_mm_srl_epi16(dst, vShift[i]), vMask[i]);
+			c = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(c, inv), vSrcAlpha[i]), 8);
+			out = _mm_or_si128(out, _mm_sll_epi16(c, vShift[i]));
+		}
+
+		_mm_storeu_si128((__m128i *)first, out);
+		first += 8;
+	}
+
+	while (first < last) {
+		uint16 d = *first, out = 0;
+		for (int i = 0; i < numChannels; i++) {
+			uint16 dc = (d >> channelShift[i]) & channelMask[i];
+			out |= ((dc * (256 - alpha) + channelSrc[i] * alpha) >> 8) << channelShift[i];
+		}
+		*first++ = out;
+	}
+}
+
+} // End of namespace Graphics
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
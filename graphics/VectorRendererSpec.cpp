@@ -570,6 +570,12 @@ VectorRendererSpec(PixelFormat format) :
 
 	_fgColor = _bgColor = _bevelColor = 0;
 	_gradientStart = _gradientEnd = 0;
+
+#ifdef SCUMMVM_SSE2
+	_useSSE2 = VectorRendererSSE2::isSupported(_format);
+#else
+	_useSSE2 = false;
+#endif
 }
 
 /****************************
@@ -659,16 +665,7 @@ gradientFill(PixelType *ptr, int width, int x, int y) {
 	} else if (grad == 3 && ox) {
 		colorFill<PixelType>(ptr, ptr + width, _gradCache[curGrad + 1]);
 	} else {
-		for (int j = x; j < x + width; j++, ptr++) {
-			bool oy = ((j & 1) == 1);
-
-			if ((ox && oy) ||
-				((grad == 2 || grad == 3) && ox && !oy) ||
-				(grad == 3 && oy))
-				*ptr = _gradCache[curGrad + 1];
-			else
-				*ptr = _gradCache[curGrad];
-		}
+		ditherFill(ptr, width, x, ditherColor(curGrad, grad, ox, false), ditherColor(curGrad, grad, ox, true));
 	}
 }
 
@@ -701,18 +698,34 @@ gradientFillClip(PixelType *ptr, int width, int x, int y, int realX, int realY)
 	} else if (grad == 3 && ox) {
 		colorFillClip<PixelType>(ptr, ptr + width, _gradCache[curGrad + 1], realX, realY, _clippingArea);
 	} else {
-		for (int j = x; j < x + width; j++, ptr++) {
-			if (realX + j - x < _clippingArea.left || realX + j - x >= _clippingArea.right) continue;
-			bool oy = ((j & 1) == 1);
-
-			if ((ox && oy) ||
-				((grad == 2 || grad == 3) && ox && !oy) ||
-				(grad == 3 && oy))
-				*ptr = _gradCache[curGrad + 1];
-			else
-				*ptr = _gradCache[curGrad];
-		}
+		int start = MAX<int>(_clippingArea.left - realX, 0);
+		int end = MIN<int>(_clippingArea.right - realX, width);
+		if (start < end)
+			ditherFill(ptr + start, end - start, x + start, ditherColor(curGrad, grad, ox, false), ditherColor(curGrad, grad, ox, true));
+	}
+}
+
+template<typename PixelType>
+void VectorRendererSpec<PixelType>::
+ditherFill(PixelType *ptr, int width, int x, PixelType evenColor, PixelType oddColor) {
+	if (width <= 0)
+		return;
+
+	PixelType *last = ptr + width;
+
+	if (x & 1)
+		*ptr++ = oddColor;
+
+	// Write the pattern in pairs so the loop has no per-pixel branches and
+	// can be vectorized by the compiler
+	while (last - ptr >= 2) {
+		ptr[0] = evenColor;
+		ptr[1] = oddColor;
+		ptr += 2;
 	}
+
+	if (ptr < last)
+		*ptr = evenColor;
 }
 
 template<typename PixelType>
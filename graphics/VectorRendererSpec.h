@@ -24,8 +24,31 @@
 
 #include "graphics/VectorRenderer.h"
 
+class VectorRendererTestSuite;
+
 namespace Graphics {
 
+#ifdef SCUMMVM_SSE2
+/**
+ * SSE2 versions of the VectorRendererSpec span fillers for the 16 and 32 bit
+ * renderers. They give the same results as the generic per-pixel loops.
+ */
+class VectorRendererSSE2 {
+public:
+	/** Whether the CPU supports SSE2 and the kernels can handle the format */
+	static bool isSupported(const PixelFormat &format);
+
+	/** blendFill for alpha values other than 0xff */
+	static void blendFill(uint16 *first, uint16 *last, uint16 color, uint8 alpha, const PixelFormat &format);
+	static void blendFill(uint32 *first, uint32 *last, uint32 color, uint8 alpha, const PixelFormat &format);
+
+private:
+	static int _cpuSupport; /**< -1 until the CPU features have been checked */
+
+	friend class ::VectorRendererTestSuite;
+};
+#endif
+
 /**
  * @defgroup graphics_vector_renderer_spec Specialized vector renderer
  * @ingroup graphics
@@ -276,6 +299,18 @@ protected:
 	void gradientFill(PixelType *first, int width, int x, int y);
 	void gradientFillClip(PixelType *first, int width, int x, int y, int realX, int realY);
 
+	/**
+	 * Returns the color of a dithered gradient pixel, depending on the
+	 * parity of its row (ox) and column (oy).
+	 */
+	inline PixelType ditherColor(int curGrad, int grad, bool ox, bool oy) const {
+		if ((ox && oy) ||
+			((grad == 2 || grad == 3) && ox && !oy) ||
+			(grad == 3 && oy))
+			return _gradCache[curGrad + 1];
+		return _gradCache[curGrad];
+	}
+
 	/**
 	 * Fills several pixels in a row with a given color and the specified alpha blending.
 	 *
@@ -287,28 +322,49 @@ protected:
 	 * @param alpha Alpha intensity of the pixel (0-255)
 	 */
 	inline void blendFill(PixelType *first, PixelType *last, PixelType color, uint8 alpha) {
+#ifdef SCUMMVM_SSE2
+		if (_useSSE2 && alpha != 0xff && last - first >= 8) {
+			if (sizeof(PixelType) == 4)
+				VectorRendererSSE2::blendFill((uint32 *)first, (uint32 *)last, (uint32)color, alpha, _format);
+			else
+				VectorRendererSSE2::blendFill((uint16 *)first, (uint16 *)last, (uint16)color, alpha, _format);
+			return;
+		}
+#endif
 		while (first < last)
 			blendPixelPtr(first++, color, alpha);
 	}
 
 	inline void blendFillClip(PixelType *first, PixelType *last, PixelType color, uint8 alpha, int realX, int realY) {
 		if (_clippingArea.top <= realY && realY < _clippingArea.bottom) {
-			while (first < last) {
-				if (_clippingArea.left <= realX && realX < _clippingArea.right)
-					blendPixelPtr(first++, color, alpha);
-				else
-					++first;
-				++realX;
-			}
+			int width = last - first;
+			int start = MAX<int>(_clippingArea.left - realX, 0);
+			int end = MIN<int>(_clippingArea.right - realX, width);
+			if (start < end)
+				blendFill(first + start, first + end, color, alpha);
 		}
 	}
 
 	void darkenFill(PixelType *first, PixelType *last);
 	void darkenFillClip(PixelType *first, PixelType *last, int x, int y);
 
+	/**
+	 * Fills a row of pixels with a two color pattern, as used by the dithered
+	 * gradient rows. Pixels at an even horizontal position get evenColor,
+	 * the others get oddColor.
+	 *
+	 * @param ptr Pointer to the first pixel to fill.
+	 * @param width Number of pixels to fill.
+	 * @param x Horizontal position of the first pixel, used for the parity.
+	 */
+	void ditherFill(PixelType *ptr, int width, int x, PixelType evenColor, PixelType oddColor);
+
 	const PixelFormat _format;
 	const PixelType _redMask, _greenMask, _blueMask, _alphaMask;
 
+	/** Whether blendFill can use the SSE2 span kernels for _format */
+	bool _useSSE2;
+
 	PixelType _fgColor; /**< Foreground color currently being used to draw on the renderer */
 	PixelType _bgColor; /**< Background color currently being used to draw on the renderer */
 
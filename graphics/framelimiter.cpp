@@ -64,6 +64,11 @@ bool FrameLimiter::delayBeforeSwap() {
 	return (_delay < 0); // Check if frame is late
 }
 
+uint FrameLimiter::getRemainingFrameTime() const {
+	uint elapsed = _system->getMillis() - _drawStart;
+	return (elapsed < _frameLimit) ? _frameLimit - elapsed : 0;
+}
+
 void FrameLimiter::pause(bool pause) {
 	if (!pause)
 		_frameStart = 0; // Ensure that the frame duration value is consistent when resuming
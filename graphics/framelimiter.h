@@ -82,6 +82,12 @@ public:
 	uint getLastLoopDuration() const {
 		return _loopDuration;
 	}
+	/**
+	 * Return the time left before the frame reaches its target duration, counting from the last screen update.
+	 * This is the time game logic can still use before delayBeforeSwap() without making the frame late,
+	 * whether or not the limiter itself delays. Returns 0 when the frame is already late or no framerate is set.
+	 */
+	uint getRemainingFrameTime() const;
 	/**
 	 * If true, framelimiter is active and applying _system->delayMillis(delay) to maintain the specified FPS, if valid.
 	 * If false, framelimiter is inactive, either because supplied FPS was invalid or because Vsync is active.
@@ -97,7 +97,8 @@ MODULE_OBJS += \
 	tinygl/zmath.o \
 	tinygl/ztriangle.o \
 	tinygl/zblit.o \
-	tinygl/zdirtyrect.o
+	tinygl/zdirtyrect.o \
+	tinygl/zcapture.o
 endif
 
 ifdef USE_ASPECT
@@ -151,7 +152,8 @@ MODULE_OBJS += \
 endif
 ifdef SCUMMVM_SSE2
 MODULE_OBJS += \
-	blit/blit-sse2.o
+	blit/blit-sse2.o \
+	VectorRendererSpec-sse2.o
 endif
 ifdef SCUMMVM_AVX2
 MODULE_OBJS += \
@@ -715,6 +715,16 @@ void tglTexImage2D(TGLenum target, TGLint level, TGLint internalformat, TGLsizei
 	c->gl_add_op(p);
 }
 
+void tglGenerateMipmap(TGLenum target) {
+	TinyGL::GLContext *c = TinyGL::gl_get_context();
+	TinyGL::GLParam p[2];
+
+	p[0].op = TinyGL::OP_GenerateMipmap;
+	p[1].i = target;
+
+	c->gl_add_op(p);
+}
+
 void tglBindTexture(TGLenum target, TGLuint texture) {
 	TinyGL::GLContext *c = TinyGL::gl_get_context();
 	TinyGL::GLParam p[3];
@@ -1168,6 +1168,12 @@ void tglCopyTexSubImage3D(TGLenum target, TGLint level, TGLint xoffset, TGLint y
                           TGLint zoffset, TGLint x, TGLint y, TGLsizei width, TGLsizei height);
 
 
+// --- GL 3.0 --- selected
+
+// textures
+void tglGenerateMipmap(TGLenum target);
+
+
 // --- GL ES 1.0 / GL_OES_single_precision ---
 
 // matrix
@@ -27,6 +27,7 @@
 
 #include "common/singleton.h"
 #include "common/array.h"
+#include "common/stream.h"
 
 #include "graphics/tinygl/tinygl.h"
 #include "graphics/tinygl/zgl.h"
@@ -358,9 +359,13 @@ void GLContext::init(int screenW, int screenH, Graphics::PixelFormat pixelFormat
 	_drawCallAllocator[1].initialize(drawCallMemorySize);
 	_debugRectsEnabled = false;
 	_profilingEnabled = false;
+	_captureStream = nullptr;
+	_disposeCaptureStream = DisposeAfterUse::NO;
 }
 
 void GLContext::deinit() {
+	if (_disposeCaptureStream == DisposeAfterUse::YES)
+		delete _captureStream;
 	disposeDrawCallLists();
 	disposeResources();
 
@@ -71,6 +71,7 @@ ADD_OP(TexImage2D, 9, "%d %d %d %d %d %d %d %d %d")
 ADD_OP(BindTexture, 2, "%C %d")
 ADD_OP(TexEnv, 7, "%C %C %C %f %f %f %f")
 ADD_OP(TexParameter, 7, "%C %C %C %f %f %f %f")
+ADD_OP(GenerateMipmap, 1, "%C")
 
 ADD_OP(ShadeModel, 1, "%C")
 ADD_OP(CullFace, 1, "%C")
@@ -38,10 +38,25 @@ TexelBuffer::TexelBuffer(uint width, uint height, uint textureSize) {
 
 	_width = width;
 	_height = height;
+	_textureSize = textureSize;
+	_tiledStride = tiledStride(width);
 	_fracTextureUnit = textureSize << ZB_POINT_ST_FRAC_BITS;
 	_fracTextureMask = _fracTextureUnit - 1;
 	_widthRatio = (float) width / textureSize;
 	_heightRatio = (float) height / textureSize;
+	_nextLevel = nullptr;
+	_nextLevelFootprint = 0;
+}
+
+TexelBuffer::~TexelBuffer() {
+	delete _nextLevel;
+}
+
+void TexelBuffer::setNextLevel(TexelBuffer *nextLevel) {
+	delete _nextLevel;
+	_nextLevel = nextLevel;
+	// Switch to the next level once a pixel covers two texels of this one
+	_nextLevelFootprint = (2 * _textureSize << ZB_POINT_ST_FRAC_BITS) / MAX(_width, _height);
 }
 
 static inline uint wrap(uint wrap_mode, int coord, uint _fracTextureUnit, uint _fracTextureMask) {
@@ -72,109 +87,105 @@ void TexelBuffer::getARGBAt(
 	x = wrap(wrap_s, s, _fracTextureUnit, _fracTextureMask) * _widthRatio;
 	y = wrap(wrap_t, t, _fracTextureUnit, _fracTextureMask) * _heightRatio;
 	getARGBAt(
-		(x >> ZB_POINT_ST_FRAC_BITS) + (y >> ZB_POINT_ST_FRAC_BITS) * _width,
+		x >> ZB_POINT_ST_FRAC_BITS, y >> ZB_POINT_ST_FRAC_BITS,
 		x & ZB_POINT_ST_FRAC_MASK, y & ZB_POINT_ST_FRAC_MASK,
 		a, r, g, b
 	);
 }
 
-// Nearest: store texture in original size.
-class BaseNearestTexelBuffer : public TexelBuffer {
-public:
-	BaseNearestTexelBuffer(const byte *buf, const Graphics::PixelFormat &format, uint width, uint height, uint textureSize);
-	~BaseNearestTexelBuffer();
-
-protected:
-	byte *_buf;
-	Graphics::PixelFormat _format;
-};
-
-BaseNearestTexelBuffer::BaseNearestTexelBuffer(const byte *buf, const Graphics::PixelFormat &format, uint width, uint height, uint textureSize) : TexelBuffer(width, height, textureSize), _format(format) {
-	uint count = _width * _height * _format.bytesPerPixel;
-	_buf = (byte *)gl_malloc(count);
-	memcpy(_buf, buf, count);
+// Textures are converted to 32 bit ARGB when they are uploaded, so that
+// sampling them only has to unpack bytes.
+static inline uint32 packARGB(uint8 a, uint8 r, uint8 g, uint8 b) {
+	return (a << 24) | (r << 16) | (g << 8) | b;
 }
 
-BaseNearestTexelBuffer::~BaseNearestTexelBuffer() {
-	gl_free(_buf);
+static inline void unpackARGB(uint32 col, uint8 &a, uint8 &r, uint8 &g, uint8 &b) {
+	a = col >> 24;
+	r = col >> 16;
+	g = col >> 8;
+	b = col;
 }
 
 template<uint Format, uint Type>
-class NearestTexelBuffer final : public BaseNearestTexelBuffer {
-public:
-	NearestTexelBuffer(const byte *buf, const Graphics::PixelFormat &format, uint width, uint height, uint textureSize)
-	  : BaseNearestTexelBuffer(buf, format, width, height, textureSize) {}
-
-protected:
-	void getARGBAt(
-		uint pixel,
-		uint, uint,
-		uint8 &a, uint8 &r, uint8 &g, uint8 &b
-	) const override {
-		Pixel col = *(((const Pixel *)_buf) + pixel);
-		_format.colorToARGBT<ColorMask>(col, a, r, g, b);
-	}
-
+static void convertToARGB(const byte *buf, const Graphics::PixelFormat &format, uint count, uint32 *dst) {
 	typedef ColorMasks<Format, Type> ColorMask;
 	typedef typename ColorMask::PixelType Pixel;
-};
+
+	const Pixel *src = (const Pixel *)buf;
+	uint8 a, r, g, b;
+	for (uint i = 0; i < count; i++) {
+		format.colorToARGBT<ColorMask>(src[i], a, r, g, b);
+		dst[i] = packARGB(a, r, g, b);
+	}
+}
 
 template<>
-class NearestTexelBuffer<TGL_RGB, TGL_UNSIGNED_BYTE> final : public BaseNearestTexelBuffer {
+void convertToARGB<TGL_RGB, TGL_UNSIGNED_BYTE>(const byte *buf, const Graphics::PixelFormat &format, uint count, uint32 *dst) {
+	for (uint i = 0; i < count; i++, buf += 3)
+		dst[i] = packARGB(0xff, buf[0], buf[1], buf[2]);
+}
+
+// Averages each 2x2 block of src into dst, which is half as wide and high, but at least 1x1.
+// On odd sizes the last column and row of dst also average the leftover texels of src.
+static void downsample(const uint32 *src, uint width, uint height, uint32 *dst) {
+	uint dstWidth = MAX<uint>(width / 2, 1);
+	uint dstHeight = MAX<uint>(height / 2, 1);
+
+	for (uint y = 0; y < dstHeight; y++) {
+		uint y0 = y * 2;
+		uint y1 = y == dstHeight - 1 ? height : y0 + 2;
+		for (uint x = 0; x < dstWidth; x++) {
+			uint x0 = x * 2;
+			uint x1 = x == dstWidth - 1 ? width : x0 + 2;
+			uint count = (x1 - x0) * (y1 - y0);
+			uint32 col = 0;
+			for (int shift = 0; shift < 32; shift += 8) {
+				uint sum = 0;
+				for (uint sy = y0; sy < y1; sy++) {
+					const uint32 *row = src + sy * width;
+					for (uint sx = x0; sx < x1; sx++)
+						sum += (row[sx] >> shift) & 0xff;
+				}
+				col |= ((sum + count / 2) / count) << shift;
+			}
+			*dst++ = col;
+		}
+	}
+}
+
+// Nearest: store texture in original size.
+class NearestTexelBuffer final : public TexelBuffer {
 public:
-	NearestTexelBuffer(const byte *buf, const Graphics::PixelFormat &format, uint width, uint height, uint textureSize)
-	  : BaseNearestTexelBuffer(buf, format, width, height, textureSize) {}
+	NearestTexelBuffer(const uint32 *argb, uint width, uint height, uint textureSize);
+	~NearestTexelBuffer();
+
+	bool isBilinear() const override { return false; }
 
 protected:
 	void getARGBAt(
-		uint pixel,
+		uint x, uint y,
 		uint, uint,
 		uint8 &a, uint8 &r, uint8 &g, uint8 &b
 	) const override {
-		byte *col = _buf + (pixel * 3);
-		a = 0xff;
-		r = col[0];
-		g = col[1];
-		b = col[2];
+		unpackARGB(_texels[tiledOffset(x, y)], a, r, g, b);
 	}
+
+private:
+	uint32 *_texels;
 };
 
-TexelBuffer *createNearestTexelBuffer(const byte *buf, const Graphics::PixelFormat &pf, uint format, uint type, uint width, uint height, uint textureSize) {
-	if (format == TGL_RGBA && type == TGL_UNSIGNED_BYTE) {
-		return new NearestTexelBuffer<TGL_RGBA, TGL_UNSIGNED_BYTE>(
-			buf, pf,
-			width, height,
-			textureSize
-		);
-	} else if (format == TGL_RGB && type == TGL_UNSIGNED_BYTE) {
-		return new NearestTexelBuffer<TGL_RGB,  TGL_UNSIGNED_BYTE>(
-			buf, pf,
-			width, height,
-			textureSize
-		);
-	} else if (format == TGL_RGB && type == TGL_UNSIGNED_SHORT_5_6_5) {
-		return new NearestTexelBuffer<TGL_RGB,  TGL_UNSIGNED_SHORT_5_6_5>(
-			buf, pf,
-			width, height,
-			textureSize
-		);
-	} else if (format == TGL_RGBA && type == TGL_UNSIGNED_SHORT_5_5_5_1) {
-		return new NearestTexelBuffer<TGL_RGBA, TGL_UNSIGNED_SHORT_5_5_5_1>(
-			buf, pf,
-			width, height,
-			textureSize
-		);
-	} else if (format == TGL_RGBA && type == TGL_UNSIGNED_SHORT_4_4_4_4) {
-		return new NearestTexelBuffer<TGL_RGBA, TGL_UNSIGNED_SHORT_4_4_4_4>(
-			buf, pf,
-			width, height,
-			textureSize
-		);
-	} else {
-		error("TinyGL texture: format 0x%04x and type 0x%04x combination not supported", format, type);
+NearestTexelBuffer::NearestTexelBuffer(const uint32 *argb, uint width, uint height, uint textureSize) : TexelBuffer(width, height, textureSize) {
+	_texels = (uint32 *)gl_zalloc(tiledSize(_width, _height) * sizeof(uint32));
+	for (uint y = 0; y < _height; y++) {
+		for (uint x = 0; x < _width; x++)
+			_texels[tiledOffset(x, y)] = *argb++;
 	}
 }
 
+NearestTexelBuffer::~NearestTexelBuffer() {
+	gl_free(_texels);
+}
+
 // Bilinear: each texture coordinates corresponds to the 4 original image
 // pixels linear interpolation has to work on, so that they are near each
 // other in CPU data cache, and a single actual memory fetch happens. This
@@ -183,12 +194,14 @@ TexelBuffer *createNearestTexelBuffer(const byte *buf, const Graphics::PixelForm
 // usage increase should be negligible.
 class BilinearTexelBuffer : public TexelBuffer {
 public:
-	BilinearTexelBuffer(byte *buf, const Graphics::PixelFormat &format, uint width, uint height, uint textureSize);
+	BilinearTexelBuffer(const uint32 *argb, uint width, uint height, uint textureSize);
 	~BilinearTexelBuffer();
 
+	bool isBilinear() const override { return true; }
+
 protected:
 	void getARGBAt(
-		uint pixel,
+		uint x, uint y,
 		uint ds, uint dt,
 		uint8 &a, uint8 &r, uint8 &g, uint8 &b
 	) const override;
@@ -207,57 +220,39 @@ private:
 #define P11_OFFSET 3
 #define PIXEL_PER_TEXEL_SHIFT 2
 
-BilinearTexelBuffer::BilinearTexelBuffer(byte *buf, const Graphics::PixelFormat &format, uint width, uint height, uint textureSize) : TexelBuffer(width, height, textureSize) {
-	const Graphics::PixelBuffer src(format, buf);
+static inline void storeTexelPixel(uint8 *texel8, int offset, uint32 col) {
+	unpackARGB(
+		col,
+		*(texel8 + offset + A_OFFSET),
+		*(texel8 + offset + R_OFFSET),
+		*(texel8 + offset + G_OFFSET),
+		*(texel8 + offset + B_OFFSET)
+	);
+}
 
+BilinearTexelBuffer::BilinearTexelBuffer(const uint32 *argb, uint width, uint height, uint textureSize) : TexelBuffer(width, height, textureSize) {
 	uint pixel00_offset = 0, pixel11_offset, pixel01_offset, pixel10_offset;
 	uint8 *texel8;
-	uint32 *texel32;
 
-	texel32 = _texels = (uint32 *)gl_malloc((_width * _height << PIXEL_PER_TEXEL_SHIFT) * sizeof(uint32));
+	_texels = (uint32 *)gl_zalloc((tiledSize(_width, _height) << PIXEL_PER_TEXEL_SHIFT) * sizeof(uint32));
 	for (uint y = 0; y < _height; y++) {
 		for (uint x = 0; x < _width; x++) {
-			texel8 = (uint8 *)texel32;
+			texel8 = (uint8 *)(_texels + (tiledOffset(x, y) << PIXEL_PER_TEXEL_SHIFT));
 			pixel11_offset = pixel00_offset + _width + 1;
-			src.getARGBAt(
-				pixel00_offset,
-				*(texel8 + P00_OFFSET + A_OFFSET),
-				*(texel8 + P00_OFFSET + R_OFFSET),
-				*(texel8 + P00_OFFSET + G_OFFSET),
-				*(texel8 + P00_OFFSET + B_OFFSET)
-			);
+			storeTexelPixel(texel8, P00_OFFSET, argb[pixel00_offset]);
 			if ((x + 1) == _width) {
 				pixel11_offset -= 1;
 				pixel01_offset = pixel00_offset;
 			} else
 				pixel01_offset = pixel00_offset + 1;
-			src.getARGBAt(
-				pixel01_offset,
-				*(texel8 + P01_OFFSET + A_OFFSET),
-				*(texel8 + P01_OFFSET + R_OFFSET),
-				*(texel8 + P01_OFFSET + G_OFFSET),
-				*(texel8 + P01_OFFSET + B_OFFSET)
-			);
+			storeTexelPixel(texel8, P01_OFFSET, argb[pixel01_offset]);
 			if ((y + 1) == _height) {
 				pixel11_offset -= _width;
 				pixel10_offset = pixel00_offset;
 			} else
 				pixel10_offset = pixel00_offset + _width;
-			src.getARGBAt(
-				pixel10_offset,
-				*(texel8 + P10_OFFSET + A_OFFSET),
-				*(texel8 + P10_OFFSET + R_OFFSET),
-				*(texel8 + P10_OFFSET + G_OFFSET),
-				*(texel8 + P10_OFFSET + B_OFFSET)
-			);
-			src.getARGBAt(
-				pixel11_offset,
-				*(texel8 + P11_OFFSET + A_OFFSET),
-				*(texel8 + P11_OFFSET + R_OFFSET),
-				*(texel8 + P11_OFFSET + G_OFFSET),
-				*(texel8 + P11_OFFSET + B_OFFSET)
-			);
-			texel32 += 1 << PIXEL_PER_TEXEL_SHIFT;
+			storeTexelPixel(texel8, P10_OFFSET, argb[pixel10_offset]);
+			storeTexelPixel(texel8, P11_OFFSET, argb[pixel11_offset]);
 			pixel00_offset++;
 		}
 	}
@@ -272,12 +267,12 @@ static inline int interpolate(int v00, int v01, int v10, int xf, int yf) {
 }
 
 void BilinearTexelBuffer::getARGBAt(
-	uint pixel,
+	uint x, uint y,
 	uint ds, uint dt,
 	uint8 &a, uint8 &r, uint8 &g, uint8 &b
 ) const {
 	uint p00_offset, p01_offset, p10_offset;
-	uint8 *texel = (uint8 *)(_texels + (pixel << PIXEL_PER_TEXEL_SHIFT));
+	uint8 *texel = (uint8 *)(_texels + (tiledOffset(x, y) << PIXEL_PER_TEXEL_SHIFT));
 	if ((ds + dt) > ZB_POINT_ST_UNIT) {
 		p00_offset = P11_OFFSET;
 		p10_offset = P01_OFFSET;
@@ -319,12 +314,82 @@ void BilinearTexelBuffer::getARGBAt(
 	);
 }
 
-TexelBuffer *createBilinearTexelBuffer(byte *buf, const Graphics::PixelFormat &pf, uint format, uint type, uint width, uint height, uint textureSize) {
-	return new BilinearTexelBuffer(
-		buf, pf,
-		width, height,
-		textureSize
-	);
+// Builds the buffer for the level 0 image in argb, followed by the
+// smaller mip levels if requested
+template<class T>
+static TexelBuffer *createLevels(uint32 *argb, uint width, uint height, uint textureSize, bool mipmaps) {
+	TexelBuffer *first = new T(argb, width, height, textureSize);
+	if (!mipmaps || (width == 1 && height == 1))
+		return first;
+
+	uint32 *level = (uint32 *)gl_malloc(MAX<uint>(width / 2, 1) * MAX<uint>(height / 2, 1) * sizeof(uint32));
+	TexelBuffer *previous = first;
+	while (width > 1 || height > 1) {
+		downsample(argb, width, height, level);
+		width = MAX<uint>(width / 2, 1);
+		height = MAX<uint>(height / 2, 1);
+		// The levels are downsampled in place, as each one is smaller than the previous
+		memcpy(argb, level, width * height * sizeof(uint32));
+
+		TexelBuffer *next = new T(argb, width, height, textureSize);
+		previous->setNextLevel(next);
+		previous = next;
+	}
+	gl_free(level);
+	return first;
+}
+
+TexelBuffer *createNearestTexelBuffer(const byte *buf, const Graphics::PixelFormat &pf, uint format, uint type, uint width, uint height, uint textureSize, bool mipmaps) {
+	uint count = width * height;
+	uint32 *argb = (uint32 *)gl_malloc(count * sizeof(uint32));
+
+	if (format == TGL_RGBA && type == TGL_UNSIGNED_BYTE) {
+		convertToARGB<TGL_RGBA, TGL_UNSIGNED_BYTE>(buf, pf, count, argb);
+	} else if (format == TGL_RGB && type == TGL_UNSIGNED_BYTE) {
+		convertToARGB<TGL_RGB,  TGL_UNSIGNED_BYTE>(buf, pf, count, argb);
+	} else if (format == TGL_RGB && type == TGL_UNSIGNED_SHORT_5_6_5) {
+		convertToARGB<TGL_RGB,  TGL_UNSIGNED_SHORT_5_6_5>(buf, pf, count, argb);
+	} else if (format == TGL_RGBA && type == TGL_UNSIGNED_SHORT_5_5_5_1) {
+		convertToARGB<TGL_RGBA, TGL_UNSIGNED_SHORT_5_5_5_1>(buf, pf, count, argb);
+	} else if (format == TGL_RGBA && type == TGL_UNSIGNED_SHORT_4_4_4_4) {
+		convertToARGB<TGL_RGBA, TGL_UNSIGNED_SHORT_4_4_4_4>(buf, pf, count, argb);
+	} else {
+		error("TinyGL texture: format 0x%04x and type 0x%04x combination not supported", format, type);
+	}
+
+	TexelBuffer *texelBuffer = createLevels<NearestTexelBuffer>(argb, width, height, textureSize, mipmaps);
+	gl_free(argb);
+	return texelBuffer;
+}
+
+TexelBuffer *createBilinearTexelBuffer(byte *buf, const Graphics::PixelFormat &pf, uint format, uint type, uint width, uint height, uint textureSize, bool mipmaps) {
+	const Graphics::PixelBuffer src(pf, buf);
+	uint count = width * height;
+	uint32 *argb = (uint32 *)gl_malloc(count * sizeof(uint32));
+
+	uint8 a, r, g, b;
+	for (uint i = 0; i < count; i++) {
+		src.getARGBAt(i, a, r, g, b);
+		argb[i] = packARGB(a, r, g, b);
+	}
+
+	TexelBuffer *texelBuffer = createLevels<BilinearTexelBuffer>(argb, width, height, textureSize, mipmaps);
+	gl_free(argb);
+	return texelBuffer;
+}
+
+TexelBuffer *createTexelBuffer(const uint32 *argb, uint width, uint height, uint textureSize, bool bilinear, bool mipmaps) {
+	// The mip levels are built in the level 0 buffer
+	uint32 *levels = (uint32 *)gl_malloc(width * height * sizeof(uint32));
+	memcpy(levels, argb, width * height * sizeof(uint32));
+
+	TexelBuffer *texelBuffer;
+	if (bilinear)
+		texelBuffer = createLevels<BilinearTexelBuffer>(levels, width, height, textureSize, mipmaps);
+	else
+		texelBuffer = createLevels<NearestTexelBuffer>(levels, width, height, textureSize, mipmaps);
+	gl_free(levels);
+	return texelBuffer;
 }
 
 } // end of namespace TinyGL
@@ -29,7 +29,7 @@ namespace TinyGL {
 class TexelBuffer {
 public:
 	TexelBuffer(uint width, uint height, uint textureSize);
-	virtual ~TexelBuffer() {};
+	virtual ~TexelBuffer();
 
 	void getARGBAt(
 		uint wrap_s, uint wrap_t,
@@ -37,18 +37,58 @@ public:
 		uint8 &a, uint8 &r, uint8 &g, uint8 &b
 	) const;
 
+	uint getWidth() const { return _width; }
+	uint getHeight() const { return _height; }
+	bool hasMipmaps() const { return _nextLevel != nullptr; }
+	virtual bool isBilinear() const = 0;
+
+	// Reads a texel back as it was uploaded
+	void getTexel(uint x, uint y, uint8 &a, uint8 &r, uint8 &g, uint8 &b) const {
+		// The unsigned offsets pick the overload taking texel coordinates,
+		// not the one taking wrap modes and texture coordinates
+		getARGBAt(x, y, 0u, 0u, a, r, g, b);
+	}
+
+	/**
+	 * Returns the mip level to sample when a pixel covers the given distance
+	 * in texture coordinates, or this buffer if it has no mip levels.
+	 * All the levels use the same texture coordinates.
+	 */
+	const TexelBuffer *getLevel(uint footprint) const {
+		const TexelBuffer *level = this;
+		while (level->_nextLevel && footprint >= level->_nextLevelFootprint)
+			level = level->_nextLevel;
+		return level;
+	}
+
+	void setNextLevel(TexelBuffer *nextLevel);
+
 protected:
 	virtual void getARGBAt(
-		uint pixel,
+		uint x, uint y,
 		uint ds, uint dt,
 		uint8 &a, uint8 &r, uint8 &g, uint8 &b
 	) const = 0;
-	uint _width, _height, _fracTextureUnit, _fracTextureMask;
+
+	// Texels are stored in tiles of 4x4, so that samples next to each
+	// other vertically are also close in memory
+	static uint tiledStride(uint width) { return (width + 3) & ~3; }
+	static uint tiledSize(uint width, uint height) { return tiledStride(width) * ((height + 3) & ~3); }
+	uint tiledOffset(uint x, uint y) const {
+		return (((y & ~3) * _tiledStride + ((x & ~3) << 2)) | ((y & 3) << 2) | (x & 3));
+	}
+
+	uint _width, _height, _fracTextureUnit, _fracTextureMask, _textureSize, _tiledStride;
 	float _widthRatio, _heightRatio;
+
+	TexelBuffer *_nextLevel;
+	uint _nextLevelFootprint;
 };
 
-TexelBuffer *createNearestTexelBuffer(const byte *buf, const Graphics::PixelFormat &pf, uint format, uint type, uint width, uint height, uint textureSize);
-TexelBuffer *createBilinearTexelBuffer(byte *buf, const Graphics::PixelFormat &pf, uint format, uint type, uint width, uint height, uint textureSize);
+TexelBuffer *createNearestTexelBuffer(const byte *buf, const Graphics::PixelFormat &pf, uint format, uint type, uint width, uint height, uint textureSize, bool mipmaps = false);
+TexelBuffer *createBilinearTexelBuffer(byte *buf, const Graphics::PixelFormat &pf, uint format, uint type, uint width, uint height, uint textureSize, bool mipmaps = false);
+// Creates a texture from texels read back with getTexel(), packed as 32 bit ARGB
+TexelBuffer *createTexelBuffer(const uint32 *argb, uint width, uint height, uint textureSize, bool bilinear, bool mipmaps);
 
 } // end of namespace TinyGL
 
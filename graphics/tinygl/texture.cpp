@@ -165,7 +165,8 @@ void GLContext::glopTexImage2D(GLParam *p) {
 				pixels, pf,
 				format, type,
 				width, height,
-				_textureSize
+				_textureSize,
+				false
 			);
 			break;
 		default:
@@ -173,13 +174,46 @@ void GLContext::glopTexImage2D(GLParam *p) {
 				pixels, pf,
 				format, type,
 				width, height,
-				_textureSize
+				_textureSize,
+				false
 			);
 			break;
 		}
 	}
 }
 
+// The smaller levels are built from level 0, as the rasterizer only samples
+// the textures uploaded there. Textures get no mip levels unless asked for.
+void GLContext::glopGenerateMipmap(GLParam *p) {
+	int target = p[1].i;
+
+	if (target != TGL_TEXTURE_2D)
+		error("tglGenerateMipmap: target not handled");
+
+	assert(current_texture);
+
+	GLImage *im = &current_texture->images[0];
+	TexelBuffer *pixmap = im->pixmap;
+	if (!pixmap || pixmap->hasMipmaps())
+		return;
+
+	uint width = pixmap->getWidth();
+	uint height = pixmap->getHeight();
+	uint32 *argb = (uint32 *)gl_malloc(width * height * sizeof(uint32));
+	for (uint y = 0; y < height; y++) {
+		for (uint x = 0; x < width; x++) {
+			uint8 a, r, g, b;
+			pixmap->getTexel(x, y, a, r, g, b);
+			argb[y * width + x] = (a << 24) | (r << 16) | (g << 8) | b;
+		}
+	}
+
+	im->pixmap = createTexelBuffer(argb, width, height, _textureSize, pixmap->isBilinear(), true);
+	gl_free(argb);
+	delete pixmap;
+	current_texture->versionNumber++;
+}
+
 // TODO: not all tests are done
 void GLContext::glopTexEnv(GLParam *p) {
 	int target = p[1].i;
@@ -22,11 +22,18 @@
 #ifndef GRAPHICS_TINYGL_H
 #define GRAPHICS_TINYGL_H
 
+#include "common/types.h"
+
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 #include "graphics/tinygl/gl.h"
 #include "graphics/tinygl/zblit_public.h"
 
+namespace Common {
+class SeekableReadStream;
+class WriteStream;
+}
+
 namespace TinyGL {
 
 typedef void *ContextHandle;
@@ -42,6 +49,29 @@ void presentBuffer(Common::List<Common::Rect> &dirtyAreas);
 void getSurfaceRef(Graphics::Surface &surface);
 Graphics::Surface *copyFromFrameBuffer(const Graphics::PixelFormat &dstFormat);
 
+// Draw call statistics of the last presented frame
+struct FrameStats {
+	uint32 drawCalls;       // draw calls queued for the frame
+	uint32 changedCalls;    // draw calls that differed from the previous frame, with dirty rects
+	uint32 allocations;     // allocations from the frame allocator
+	uint32 allocatedBytes;  // bytes taken from the frame allocator
+	uint32 peakBytes;       // most bytes taken by one frame so far
+	uint32 capacityBytes;   // size of each of the two frame allocators
+};
+
+void getFrameStats(FrameStats &stats);
+
+// Frame capture, to replay the draw calls of a frame outside of the engines.
+// The draw calls of the next frame presented by the current context are
+// written to the stream, with the textures and images they use.
+void captureFrame(Common::WriteStream *stream, DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES);
+// Creates a context holding the frame read from the stream, and makes it
+// current. Returns nullptr if the stream does not hold a frame capture.
+ContextHandle *loadFrameCapture(Common::SeekableReadStream *stream);
+// Executes the draw calls of the loaded frame again. The buffer of such a
+// context must not be presented, as that releases the draw calls.
+void replayFrame();
+
 } // end of namespace TinyGL
 
 #endif
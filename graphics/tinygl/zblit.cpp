@@ -25,6 +25,7 @@
 #include "graphics/tinygl/zgl.h"
 #include "graphics/tinygl/pixelbuffer.h"
 #include "graphics/tinygl/zdirtyrect.h"
+#include "graphics/tinygl/zcapture.h"
 #include "graphics/tinygl/gl.h"
 
 #include "graphics/blit.h"
@@ -300,6 +301,31 @@ public:
 	void dispose() { if (--_refcount == 0) _isDisposed = true; }
 	bool isDisposed() const { return _isDisposed; }
 	bool isOpaque() const { return _opaque; }
+
+	// The surface holds the pixels as they are blitted, so uploading it
+	// again gives the same image
+	void syncData(FrameCaptureSerializer &s) {
+		Graphics::Surface surface;
+		bool zBuffer = _zBuffer;
+		int16 width = _surface.w, height = _surface.h;
+		Graphics::PixelFormat format = _surface.format;
+
+		s.syncAsByte(zBuffer);
+		s.syncAsSint16LE(width);
+		s.syncAsSint16LE(height);
+		s.syncPixelFormat(format);
+		if (s.isLoading())
+			surface.create(width, height, format);
+		else
+			surface = _surface;
+		for (int y = 0; y < surface.h; y++)
+			s.syncBytes((byte *)surface.getBasePtr(0, y), surface.w * surface.format.bytesPerPixel);
+
+		if (s.isLoading()) {
+			loadData(surface, 0, false, zBuffer);
+			surface.free();
+		}
+	}
 private:
 	bool _isDisposed;
 	bool _binaryTransparent;
@@ -795,6 +821,12 @@ void tglBlitZBuffer(BlitImage *blitImage, int x, int y) {
 	blitImage->tglBlitZBuffer(x, y);
 }
 
+void tglSyncBlitImage(FrameCaptureSerializer &s, BlitImage *&blitImage) {
+	if (s.isLoading())
+		blitImage = tglGenBlitImage();
+	blitImage->syncData(s);
+}
+
 void tglCleanupImages() {
 	GLContext *c = gl_get_context();
 	Common::List<BlitImage *>::iterator it = c->_blitImages.begin();
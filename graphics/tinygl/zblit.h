@@ -30,6 +30,7 @@
 namespace TinyGL {
 
 struct BlitImage;
+class FrameCaptureSerializer;
 
 namespace Internal {
 	/**
@@ -45,6 +46,9 @@ namespace Internal {
 
 	void tglBlitZBuffer(BlitImage *blitImage, int x, int y);
 
+	// Saves the pixels of a blit image to a frame capture, or creates one from them when loading.
+	void tglSyncBlitImage(FrameCaptureSerializer &s, BlitImage *&blitImage);
+
 } // end of namespace Internal
 
 } // end of namespace TinyGL
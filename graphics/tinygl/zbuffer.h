@@ -370,6 +370,9 @@ private:
 	                     int &dzdx, int &dsdx, int &dtdx, int &drdx, int &dgdx, int &dbdx, uint dadx,
 	                     uint &fog, int fog_r, int fog_g, int fog_b, int &dfdx);
 
+	const TexelBuffer *selectMipLevel(float ss, float tt, float zinv, int dsdx, int dtdx,
+	                                  float dszdy, float dtzdy, float fdzdy) const;
+
 	template <bool kDepthWrite, bool kEnableScissor, bool kStencilEnabled, bool StippleEnabled, bool kDepthTestEnabled>
 	void putPixelDepth(uint *pz, byte *ps, int _a, int x, int y, uint &z, int &dzdx);
 
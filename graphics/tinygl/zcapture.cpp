@@ -0,0 +1,269 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/memstream.h"
+
+#include "graphics/tinygl/zcapture.h"
+#include "graphics/tinygl/zgl.h"
+
+namespace TinyGL {
+
+// A capture starts with this header, followed by the textures, the blit
+// images and the draw calls of the frame.
+struct FrameCaptureHeader {
+	static const uint32 kTag = MKTAG('T', 'G', 'L', 'F');
+	static const uint32 kVersion = 1;
+
+	uint32 tag, version;
+	int width, height;
+	Graphics::PixelFormat pixelFormat;
+	int textureSize;
+	bool stencilBuffer;
+	uint32 frameBytes;
+
+	void sync(FrameCaptureSerializer &s) {
+		s.syncAsUint32BE(tag);
+		s.syncAsUint32LE(version);
+		s.syncAsSint32LE(width);
+		s.syncAsSint32LE(height);
+		s.syncPixelFormat(pixelFormat);
+		s.syncAsSint32LE(textureSize);
+		s.syncAsByte(stencilBuffer);
+		s.syncAsUint32LE(frameBytes);
+	}
+};
+
+void FrameCaptureSerializer::syncPixelFormat(Graphics::PixelFormat &format) {
+	syncAsByte(format.bytesPerPixel);
+	syncAsByte(format.rLoss);
+	syncAsByte(format.gLoss);
+	syncAsByte(format.bLoss);
+	syncAsByte(format.aLoss);
+	syncAsByte(format.rShift);
+	syncAsByte(format.gShift);
+	syncAsByte(format.bShift);
+	syncAsByte(format.aShift);
+}
+
+void FrameCaptureSerializer::syncVertex(GLVertex &vertex) {
+	syncAsSint32LE(vertex.edge_flag);
+	for (int i = 0; i < 3; i++)
+		syncAsFloatLE(vertex.normal._v[i]);
+	for (int i = 0; i < 4; i++) {
+		syncAsFloatLE(vertex.coord._v[i]);
+		syncAsFloatLE(vertex.tex_coord._v[i]);
+		syncAsFloatLE(vertex.color._v[i]);
+		syncAsFloatLE(vertex.ec._v[i]);
+		syncAsFloatLE(vertex.pc._v[i]);
+	}
+	syncAsFloatLE(vertex.fog_factor);
+	syncAsSint32LE(vertex.clip_code);
+
+	ZBufferPoint &zp = vertex.zp;
+	syncAsSint32LE(zp.x);
+	syncAsSint32LE(zp.y);
+	syncAsSint32LE(zp.z);
+	syncAsSint32LE(zp.s);
+	syncAsSint32LE(zp.t);
+	syncAsSint32LE(zp.r);
+	syncAsSint32LE(zp.g);
+	syncAsSint32LE(zp.b);
+	syncAsSint32LE(zp.a);
+	syncAsFloatLE(zp.sz);
+	syncAsFloatLE(zp.tz);
+	syncAsSint32LE(zp.f);
+}
+
+void FrameCaptureSerializer::syncTexture(GLTexture *&texture) {
+	uint32 index = 0;
+	if (isSaving()) {
+		while (index < _textures.size() && _textures[index] != texture)
+			index++;
+		if (index == _textures.size())
+			_textures.push_back(texture);
+	}
+	syncAsUint32LE(index);
+	if (isLoading()) {
+		if (index >= _textures.size())
+			error("TinyGL: Invalid texture in frame capture");
+		texture = _textures[index];
+	}
+}
+
+void FrameCaptureSerializer::syncBlitImage(BlitImage *&blitImage) {
+	uint32 index = 0;
+	if (isSaving()) {
+		while (index < _blitImages.size() && _blitImages[index] != blitImage)
+			index++;
+		if (index == _blitImages.size())
+			_blitImages.push_back(blitImage);
+	}
+	syncAsUint32LE(index);
+	if (isLoading()) {
+		if (index >= _blitImages.size())
+			error("TinyGL: Invalid blit image in frame capture");
+		blitImage = _blitImages[index];
+	}
+}
+
+// Only the level 0 texels are kept, the mip levels are built again when loading
+static void syncTextureData(FrameCaptureSerializer &s, GLTexture *texture, int textureSize) {
+	const TexelBuffer *pixmap = texture->images[0].pixmap;
+	uint32 width = 0, height = 0;
+	bool bilinear = false, mipmaps = false;
+	if (pixmap) {
+		width = pixmap->getWidth();
+		height = pixmap->getHeight();
+		bilinear = pixmap->isBilinear();
+		mipmaps = pixmap->hasMipmaps();
+	}
+
+	s.syncAsUint32LE(width);
+	s.syncAsUint32LE(height);
+	s.syncAsByte(bilinear);
+	s.syncAsByte(mipmaps);
+	if (width == 0 || height == 0)
+		return;
+
+	Common::Array<uint32> texels(width * height);
+	if (s.isSaving()) {
+		for (uint y = 0; y < height; y++) {
+			for (uint x = 0; x < width; x++) {
+				uint8 a, r, g, b;
+				pixmap->getTexel(x, y, a, r, g, b);
+				texels[y * width + x] = (a << 24) | (r << 16) | (g << 8) | b;
+			}
+		}
+	}
+	for (uint i = 0; i < texels.size(); i++)
+		s.syncAsUint32LE(texels[i]);
+
+	if (s.isLoading())
+		texture->images[0].pixmap = createTexelBuffer(texels.data(), width, height, textureSize, bilinear, mipmaps);
+}
+
+void GLContext::saveFrameCapture() {
+	// The draw calls are serialized first, to gather the textures and
+	// images they use
+	Common::MemoryWriteStreamDynamic drawCalls(DisposeAfterUse::YES);
+	FrameCaptureSerializer drawCallSerializer(nullptr, &drawCalls);
+	for (auto &drawCall : _drawCallsQueue)
+		DrawCall::syncDrawCall(drawCallSerializer, drawCall);
+
+	FrameCaptureSerializer s(nullptr, _captureStream);
+	FrameCaptureHeader header;
+	header.tag = FrameCaptureHeader::kTag;
+	header.version = FrameCaptureHeader::kVersion;
+	header.width = fb->getPixelBufferWidth();
+	header.height = fb->getPixelBufferHeight();
+	header.pixelFormat = fb->getPixelFormat();
+	header.textureSize = _textureSize;
+	header.stencilBuffer = stencil_buffer_supported;
+	header.frameBytes = _drawCallAllocator[_currentAllocatorIndex].getAllocatedSize();
+	header.sync(s);
+
+	uint32 count = drawCallSerializer._textures.size();
+	s.syncAsUint32LE(count);
+	for (auto &texture : drawCallSerializer._textures)
+		syncTextureData(s, texture, _textureSize);
+
+	count = drawCallSerializer._blitImages.size();
+	s.syncAsUint32LE(count);
+	for (auto &blitImage : drawCallSerializer._blitImages)
+		Internal::tglSyncBlitImage(s, blitImage);
+
+	count = _drawCallsQueue.size();
+	s.syncAsUint32LE(count);
+	_captureStream->write(drawCalls.getData(), drawCalls.size());
+
+	_captureStream->finalize();
+	if (_captureStream->err())
+		warning("TinyGL: Failed to write the frame capture");
+
+	if (_disposeCaptureStream == DisposeAfterUse::YES)
+		delete _captureStream;
+	_captureStream = nullptr;
+}
+
+bool GLContext::loadFrameCapture(FrameCaptureSerializer &s) {
+	uint32 count = 0;
+	s.syncAsUint32LE(count);
+	for (uint32 i = 0; i < count && !s.err(); i++) {
+		// Handle 0 is taken by the default texture
+		GLTexture *texture = alloc_texture(i + 1);
+		syncTextureData(s, texture, _textureSize);
+		s._textures.push_back(texture);
+	}
+
+	s.syncAsUint32LE(count);
+	for (uint32 i = 0; i < count && !s.err(); i++) {
+		BlitImage *blitImage = nullptr;
+		Internal::tglSyncBlitImage(s, blitImage);
+		s._blitImages.push_back(blitImage);
+	}
+
+	s.syncAsUint32LE(count);
+	for (uint32 i = 0; i < count && !s.err(); i++) {
+		DrawCall *drawCall = nullptr;
+		DrawCall::syncDrawCall(s, drawCall);
+		_replayDrawCalls.push_back(drawCall);
+	}
+
+	// The draw calls hold their own references to the images
+	for (auto &blitImage : s._blitImages)
+		tglDeleteBlitImage(blitImage);
+
+	return !s.err();
+}
+
+void captureFrame(Common::WriteStream *stream, DisposeAfterUse::Flag disposeAfterUse) {
+	GLContext *c = gl_get_context();
+	if (c->_disposeCaptureStream == DisposeAfterUse::YES)
+		delete c->_captureStream;
+	c->_captureStream = stream;
+	c->_disposeCaptureStream = disposeAfterUse;
+}
+
+ContextHandle *loadFrameCapture(Common::SeekableReadStream *stream) {
+	FrameCaptureSerializer s(stream, nullptr);
+	FrameCaptureHeader header;
+	header.sync(s);
+	if (s.err() || header.tag != FrameCaptureHeader::kTag || header.version != FrameCaptureHeader::kVersion)
+		return nullptr;
+
+	// Replaying allocates the same draw calls as the captured frame
+	ContextHandle *context = createContext(header.width, header.height, header.pixelFormat, header.textureSize,
+	                                       header.stencilBuffer, false, header.frameBytes + 64 * 1024);
+	if (!gl_get_context()->loadFrameCapture(s)) {
+		destroyContext(context);
+		return nullptr;
+	}
+	return context;
+}
+
+void replayFrame() {
+	GLContext *c = gl_get_context();
+	for (const auto &drawCall : c->_replayDrawCalls)
+		drawCall->execute(true);
+}
+
+} // end of namespace TinyGL
@@ -0,0 +1,58 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef GRAPHICS_TINYGL_ZCAPTURE_H
+#define GRAPHICS_TINYGL_ZCAPTURE_H
+
+#include "common/array.h"
+#include "common/serializer.h"
+
+#include "graphics/pixelformat.h"
+
+namespace TinyGL {
+
+struct GLVertex;
+struct GLTexture;
+struct BlitImage;
+
+/**
+ * Serializer for frame captures. When saving, the textures and blit images
+ * the draw calls use are gathered in tables, and only their index in the
+ * tables is written with each draw call. When loading, the tables are read
+ * first, so that the indices can be resolved.
+ */
+class FrameCaptureSerializer : public Common::Serializer {
+public:
+	FrameCaptureSerializer(Common::SeekableReadStream *in, Common::WriteStream *out) : Common::Serializer(in, out) { }
+
+	void syncPixelFormat(Graphics::PixelFormat &format);
+	void syncVertex(GLVertex &vertex);
+	void syncTexture(GLTexture *&texture);
+	void syncBlitImage(BlitImage *&blitImage);
+
+	Common::Array<GLTexture *> _textures;
+	Common::Array<BlitImage *> _blitImages;
+};
+
+} // end of namespace TinyGL
+
+#endif
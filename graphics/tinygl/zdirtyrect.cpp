@@ -20,6 +20,7 @@
  */
 
 #include "graphics/tinygl/zdirtyrect.h"
+#include "graphics/tinygl/zcapture.h"
 #include "graphics/tinygl/zgl.h"
 #include "graphics/tinygl/gl.h"
 
@@ -27,6 +28,82 @@
 
 namespace TinyGL {
 
+namespace {
+
+// Hash used for the draw call signatures. The data is fed as 32 bit
+// words, and each step mixes the high bits back into the low ones.
+class SignatureHash {
+public:
+	SignatureHash() : _hash(0xcbf29ce484222325ULL) { }
+
+	void add(uint32 value) {
+		_hash = (_hash ^ value) * 0x9e3779b97f4a7c15ULL;
+		_hash ^= _hash >> 32;
+	}
+
+	void add(int value) { add((uint32)value); }
+	void add(bool value) { add((uint32)value); }
+
+	void add(float value) {
+		uint32 bits;
+		memcpy(&bits, &value, sizeof(bits));
+		add(bits);
+	}
+
+	void add(const float *values, int count) {
+		for (int i = 0; i < count; i++)
+			add(values[i]);
+	}
+
+	void add(const void *pointer) {
+		uint64 value = (uint64)(uintptr)pointer;
+		add((uint32)value);
+		add((uint32)(value >> 32));
+	}
+
+	uint64 get() const { return _hash; }
+
+private:
+	uint64 _hash;
+};
+
+void syncScissor(FrameCaptureSerializer &s, bool &enableScissor, int *scissor) {
+	s.syncAsByte(enableScissor);
+	for (int i = 0; i < 4; i++)
+		s.syncAsSint32LE(scissor[i]);
+}
+
+void syncRect(FrameCaptureSerializer &s, Common::Rect &rect) {
+	s.syncAsSint16LE(rect.left);
+	s.syncAsSint16LE(rect.top);
+	s.syncAsSint16LE(rect.right);
+	s.syncAsSint16LE(rect.bottom);
+}
+
+// The triangle functions are saved as their index in this table
+const gl_draw_triangle_func drawTriangleFuncs[] = {
+	GLContext::gl_draw_triangle_fill,
+	GLContext::gl_draw_triangle_line,
+	GLContext::gl_draw_triangle_point,
+	GLContext::gl_draw_triangle_select
+};
+
+void syncDrawTriangleFunc(FrameCaptureSerializer &s, gl_draw_triangle_func &func) {
+	byte index = 0;
+	if (s.isSaving()) {
+		while (index < ARRAYSIZE(drawTriangleFuncs) - 1 && drawTriangleFuncs[index] != func)
+			index++;
+	}
+	s.syncAsByte(index);
+	if (s.isLoading()) {
+		if (index >= ARRAYSIZE(drawTriangleFuncs))
+			error("TinyGL: Invalid triangle function in frame capture");
+		func = drawTriangleFuncs[index];
+	}
+}
+
+} // end of anonymous namespace
+
 void GLContext::issueDrawCall(DrawCall *drawCall) {
 	if (_enableDirtyRectangles && drawCall->getDirtyRegion().isEmpty())
 		return;
@@ -103,6 +180,20 @@ void GLContext::disposeDrawCallLists() {
 		delete drawCall;
 	}
 	_drawCallsQueue.clear();
+	for (auto &drawCall : _replayDrawCalls) {
+		delete drawCall;
+	}
+	_replayDrawCalls.clear();
+}
+
+void GLContext::updateFrameStats(uint changedCalls) {
+	const LinearAllocator &allocator = _drawCallAllocator[_currentAllocatorIndex];
+	_frameStats.drawCalls = _drawCallsQueue.size();
+	_frameStats.changedCalls = changedCalls;
+	_frameStats.allocations = allocator.getAllocationCount();
+	_frameStats.allocatedBytes = allocator.getAllocatedSize();
+	_frameStats.peakBytes = MAX(_drawCallAllocator[0].getPeakSize(), _drawCallAllocator[1].getPeakSize());
+	_frameStats.capacityBytes = allocator.getCapacity();
 }
 
 static inline void _appendDirtyRectangle(const DrawCall &call, Common::List<DirtyRectangle> &rectangles, int r, int g, int b) {
@@ -112,7 +203,7 @@ static inline void _appendDirtyRectangle(const DrawCall &call, Common::List<Dirt
 }
 
 void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas) {
-	typedef Common::List<DrawCall *>::const_iterator DrawCallIterator;
+	typedef Common::Array<DrawCall *>::const_iterator DrawCallIterator;
 	typedef Common::List<DirtyRectangle>::iterator RectangleIterator;
 
 	Common::List<DirtyRectangle> rectangles;
@@ -122,15 +213,18 @@ void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas)
 	DrawCallIterator itPrevFrame = _previousFrameDrawCallsQueue.begin();
 	DrawCallIterator endPrevFrame = _previousFrameDrawCallsQueue.end();
 
+	uint changedCalls = 0;
+
 	// Compare draw calls.
 	for ( ; itPrevFrame != endPrevFrame && itFrame != endFrame;
 		++itPrevFrame, ++itFrame) {
 			const DrawCall &currentCall = **itFrame;
 			const DrawCall &previousCall = **itPrevFrame;
 
-			if (previousCall != currentCall) {
+			if (!currentCall.matchesPrevious(previousCall)) {
 				_appendDirtyRectangle(previousCall, rectangles, 255, 255, 255);
 				_appendDirtyRectangle(currentCall, rectangles, 255, 0, 0);
+				changedCalls++;
 			}
 	}
 
@@ -140,6 +234,7 @@ void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas)
 
 	for ( ; itFrame != endFrame; ++itFrame) {
 		_appendDirtyRectangle(**itFrame, rectangles, 255, 0, 0);
+		changedCalls++;
 	}
 
 	// This loop increases outer rectangle coordinates to favor merging of adjacent rectangles.
@@ -219,13 +314,16 @@ void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas)
 		}
 	}
 
+	updateFrameStats(changedCalls);
+
 	// Dispose not necessary draw calls.
 	for (auto &p : _previousFrameDrawCallsQueue) {
 		delete p;
 	}
 
-	_previousFrameDrawCallsQueue = _drawCallsQueue;
-	_drawCallsQueue.clear();
+	// Swap the queues rather than copying them, so both keep their storage
+	_previousFrameDrawCallsQueue.swap(_drawCallsQueue);
+	_drawCallsQueue.resize(0);
 
 	disposeResources();
 
@@ -236,12 +334,14 @@ void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas)
 void GLContext::presentBufferSimple(Common::List<Common::Rect> &dirtyAreas) {
 	dirtyAreas.push_back(Common::Rect(fb->getPixelBufferWidth(), fb->getPixelBufferHeight()));
 
+	updateFrameStats(_drawCallsQueue.size());
+
 	for (const auto &drawCall : _drawCallsQueue) {
 		drawCall->execute(true);
 		delete drawCall;
 	}
 
-	_drawCallsQueue.clear();
+	_drawCallsQueue.resize(0);
 
 	disposeResources();
 
@@ -250,6 +350,8 @@ void GLContext::presentBufferSimple(Common::List<Common::Rect> &dirtyAreas) {
 
 void presentBuffer(Common::List<Common::Rect> &dirtyAreas) {
 	GLContext *c = gl_get_context();
+	if (c->_captureStream)
+		c->saveFrameCapture();
 	if (c->_enableDirtyRectangles) {
 		c->presentBufferDirtyRects(dirtyAreas);
 	} else {
@@ -262,6 +364,10 @@ void presentBuffer() {
 	presentBuffer(dirtyAreas);
 }
 
+void getFrameStats(FrameStats &stats) {
+	stats = gl_get_context()->_frameStats;
+}
+
 bool DrawCall::operator==(const DrawCall &other) const {
 	if (_type == other._type) {
 		switch (_type) {
@@ -282,6 +388,32 @@ bool DrawCall::operator==(const DrawCall &other) const {
 	}
 }
 
+void DrawCall::syncDrawCall(FrameCaptureSerializer &s, DrawCall *&drawCall) {
+	byte type = 0;
+	if (s.isSaving())
+		type = drawCall->_type;
+	s.syncAsByte(type);
+
+	if (s.isSaving()) {
+		drawCall->sync(s);
+		return;
+	}
+
+	switch (type) {
+	case DrawCall_Rasterization:
+		drawCall = new RasterizationDrawCall(s);
+		break;
+	case DrawCall_Blitting:
+		drawCall = new BlittingDrawCall(s);
+		break;
+	case DrawCall_Clear:
+		drawCall = new ClearBufferDrawCall(s);
+		break;
+	default:
+		error("TinyGL: Invalid draw call type %d in frame capture", type);
+	}
+}
+
 
 RasterizationDrawCall::RasterizationDrawCall() : DrawCall(DrawCall_Rasterization) {
 	GLContext *c = gl_get_context();
@@ -293,9 +425,162 @@ RasterizationDrawCall::RasterizationDrawCall() : DrawCall(DrawCall_Rasterization
 	_state = captureState();
 	if (c->_enableDirtyRectangles) {
 		computeDirtyRegion();
+		computeSignature();
 	}
 }
 
+void RasterizationDrawCall::computeSignature() {
+	SignatureHash hash;
+	hash.add(_vertexCount);
+	hash.add((const void *)_drawTriangleFront);
+	hash.add((const void *)_drawTriangleBack);
+
+	// The same vertex fields as GLVertex::operator==
+	for (int i = 0; i < _vertexCount; i++) {
+		const GLVertex &v = _vertex[i];
+		hash.add(v.edge_flag);
+		hash.add(v.normal._v, 3);
+		hash.add(v.coord._v, 4);
+		hash.add(v.tex_coord._v, 4);
+		hash.add(v.color._v, 4);
+		hash.add(v.ec._v, 4);
+		hash.add(v.pc._v, 4);
+		hash.add(v.clip_code);
+		hash.add(v.zp.x);
+		hash.add(v.zp.y);
+		hash.add(v.zp.z);
+		hash.add(v.zp.s);
+		hash.add(v.zp.t);
+		hash.add(v.zp.r);
+		hash.add(v.zp.g);
+		hash.add(v.zp.b);
+		hash.add(v.zp.a);
+	}
+
+	const RasterizationState &state = _state;
+	hash.add(state.enableScissor);
+	hash.add(state.scissor[0]);
+	hash.add(state.scissor[1]);
+	hash.add(state.scissor[2]);
+	hash.add(state.scissor[3]);
+	hash.add(state.beginType);
+	hash.add(state.currentFrontFace);
+	hash.add(state.cullFaceEnabled);
+	hash.add(state.colorMaskRed);
+	hash.add(state.colorMaskGreen);
+	hash.add(state.colorMaskBlue);
+	hash.add(state.colorMaskAlpha);
+	hash.add(state.depthTestEnabled);
+	hash.add(state.depthFunction);
+	hash.add(state.depthWriteMask);
+	hash.add(state.texture2DEnabled);
+	hash.add(state.currentShadeModel);
+	hash.add(state.polygonModeBack);
+	hash.add(state.polygonModeFront);
+	hash.add(state.lightingEnabled);
+	hash.add(state.enableBlending);
+	hash.add(state.sfactor);
+	hash.add(state.dfactor);
+	hash.add(state.offsetStates);
+	hash.add(state.offsetFactor);
+	hash.add(state.offsetUnits);
+	hash.add(state.viewportTranslation, 3);
+	hash.add(state.viewportScaling, 3);
+	hash.add(state.alphaTestEnabled);
+	hash.add(state.alphaFunc);
+	hash.add(state.alphaRefValue);
+	hash.add(state.stencilTestEnabled);
+	hash.add(state.stencilTestFunc);
+	hash.add(state.stencilValue);
+	hash.add(state.stencilMask);
+	hash.add(state.stencilWriteMask);
+	hash.add(state.stencilSfail);
+	hash.add(state.stencilDpfail);
+	hash.add(state.stencilDppass);
+	hash.add(state.polygonStippleEnabled);
+	if (state.polygonStippleEnabled) {
+		for (int i = 0; i < ARRAYSIZE(state.polygonStipplePattern); i += 4)
+			hash.add(READ_UINT32(state.polygonStipplePattern + i));
+	}
+	hash.add((const void *)state.texture);
+	hash.add(state.wrapS);
+	hash.add(state.wrapT);
+	hash.add(state.fogEnabled);
+	hash.add(state.fogColorR);
+	hash.add(state.fogColorG);
+	hash.add(state.fogColorB);
+	_signature = hash.get();
+}
+
+RasterizationDrawCall::RasterizationDrawCall(FrameCaptureSerializer &s) : DrawCall(DrawCall_Rasterization), _vertexCount(0), _vertex(nullptr) {
+	sync(s);
+}
+
+void RasterizationDrawCall::sync(FrameCaptureSerializer &s) {
+	s.syncAsSint32LE(_vertexCount);
+	if (s.isLoading())
+		_vertex = (GLVertex *)Internal::allocateFrame(_vertexCount * sizeof(GLVertex));
+	for (int i = 0; i < _vertexCount; i++)
+		s.syncVertex(_vertex[i]);
+	syncDrawTriangleFunc(s, _drawTriangleFront);
+	syncDrawTriangleFunc(s, _drawTriangleBack);
+
+	RasterizationState &state = _state;
+	syncScissor(s, state.enableScissor, state.scissor);
+	s.syncAsSint32LE(state.beginType);
+	s.syncAsSint32LE(state.currentFrontFace);
+	s.syncAsSint32LE(state.cullFaceEnabled);
+	s.syncAsByte(state.colorMaskRed);
+	s.syncAsByte(state.colorMaskGreen);
+	s.syncAsByte(state.colorMaskBlue);
+	s.syncAsByte(state.colorMaskAlpha);
+	s.syncAsByte(state.depthTestEnabled);
+	s.syncAsSint32LE(state.depthFunction);
+	s.syncAsSint32LE(state.depthWriteMask);
+	s.syncAsByte(state.texture2DEnabled);
+	s.syncAsSint32LE(state.currentShadeModel);
+	s.syncAsSint32LE(state.polygonModeBack);
+	s.syncAsSint32LE(state.polygonModeFront);
+	s.syncAsSint32LE(state.lightingEnabled);
+	s.syncAsByte(state.enableBlending);
+	s.syncAsSint32LE(state.sfactor);
+	s.syncAsSint32LE(state.dfactor);
+	s.syncAsSint32LE(state.offsetStates);
+	s.syncAsFloatLE(state.offsetFactor);
+	s.syncAsFloatLE(state.offsetUnits);
+	for (int i = 0; i < 3; i++) {
+		s.syncAsFloatLE(state.viewportTranslation[i]);
+		s.syncAsFloatLE(state.viewportScaling[i]);
+	}
+	s.syncAsByte(state.alphaTestEnabled);
+	s.syncAsSint32LE(state.alphaFunc);
+	s.syncAsSint32LE(state.alphaRefValue);
+	s.syncAsByte(state.stencilTestEnabled);
+	s.syncAsSint32LE(state.stencilTestFunc);
+	s.syncAsSint32LE(state.stencilValue);
+	s.syncAsUint32LE(state.stencilMask);
+	s.syncAsUint32LE(state.stencilWriteMask);
+	s.syncAsSint32LE(state.stencilSfail);
+	s.syncAsSint32LE(state.stencilDpfail);
+	s.syncAsSint32LE(state.stencilDppass);
+	s.syncAsByte(state.polygonStippleEnabled);
+	s.syncBytes(state.polygonStipplePattern, sizeof(state.polygonStipplePattern));
+	s.syncTexture(state.texture);
+	s.syncAsUint32LE(state.wrapS);
+	s.syncAsUint32LE(state.wrapT);
+	s.syncAsByte(state.fogEnabled);
+	s.syncAsFloatLE(state.fogColorR);
+	s.syncAsFloatLE(state.fogColorG);
+	s.syncAsFloatLE(state.fogColorB);
+
+	if (s.isLoading())
+		state.textureVersion = state.texture->versionNumber;
+}
+
+bool RasterizationDrawCall::isOutdated() const {
+	return _state.textureVersion != _state.texture->versionNumber;
+}
+
 void RasterizationDrawCall::computeDirtyRegion() {
 	int clip_code = 0xf;
 
@@ -573,9 +858,89 @@ BlittingDrawCall::BlittingDrawCall(BlitImage *image, const BlitTransform &transf
 	_imageVersion = tglGetBlitImageVersion(image);
 	if (gl_get_context()->_enableDirtyRectangles) {
 		computeDirtyRegion();
+		computeSignature();
 	}
 }
 
+void BlittingDrawCall::computeSignature() {
+	SignatureHash hash;
+	hash.add((int)_mode);
+	hash.add((const void *)_image);
+
+	const BlitTransform &t = _transform;
+	hash.add(t._sourceRectangle.left);
+	hash.add(t._sourceRectangle.top);
+	hash.add(t._sourceRectangle.right);
+	hash.add(t._sourceRectangle.bottom);
+	hash.add(t._destinationRectangle.left);
+	hash.add(t._destinationRectangle.top);
+	hash.add(t._destinationRectangle.right);
+	hash.add(t._destinationRectangle.bottom);
+	hash.add(t._rotation);
+	hash.add(t._originX);
+	hash.add(t._originY);
+	hash.add(t._aTint);
+	hash.add(t._rTint);
+	hash.add(t._gTint);
+	hash.add(t._bTint);
+	hash.add(t._flipHorizontally);
+	hash.add(t._flipVertically);
+
+	hash.add(_blitState.enableScissor);
+	hash.add(_blitState.scissor[0]);
+	hash.add(_blitState.scissor[1]);
+	hash.add(_blitState.scissor[2]);
+	hash.add(_blitState.scissor[3]);
+	hash.add(_blitState.enableBlending);
+	hash.add(_blitState.sfactor);
+	hash.add(_blitState.dfactor);
+	hash.add(_blitState.alphaTest);
+	hash.add(_blitState.alphaFunc);
+	hash.add(_blitState.alphaRefValue);
+	hash.add(_blitState.depthTestEnabled);
+	_signature = hash.get();
+}
+
+BlittingDrawCall::BlittingDrawCall(FrameCaptureSerializer &s) : DrawCall(DrawCall_Blitting), _image(nullptr), _transform(0, 0), _mode(BlitMode_Regular) {
+	sync(s);
+	tglIncBlitImageRef(_image);
+	_imageVersion = tglGetBlitImageVersion(_image);
+}
+
+void BlittingDrawCall::sync(FrameCaptureSerializer &s) {
+	s.syncBlitImage(_image);
+
+	int mode = _mode;
+	s.syncAsByte(mode);
+	_mode = (BlittingMode)mode;
+
+	BlitTransform &t = _transform;
+	syncRect(s, t._sourceRectangle);
+	syncRect(s, t._destinationRectangle);
+	s.syncAsSint32LE(t._rotation);
+	s.syncAsSint32LE(t._originX);
+	s.syncAsSint32LE(t._originY);
+	s.syncAsFloatLE(t._aTint);
+	s.syncAsFloatLE(t._rTint);
+	s.syncAsFloatLE(t._gTint);
+	s.syncAsFloatLE(t._bTint);
+	s.syncAsByte(t._flipHorizontally);
+	s.syncAsByte(t._flipVertically);
+
+	syncScissor(s, _blitState.enableScissor, _blitState.scissor);
+	s.syncAsByte(_blitState.enableBlending);
+	s.syncAsSint32LE(_blitState.sfactor);
+	s.syncAsSint32LE(_blitState.dfactor);
+	s.syncAsByte(_blitState.alphaTest);
+	s.syncAsSint32LE(_blitState.alphaFunc);
+	s.syncAsSint32LE(_blitState.alphaRefValue);
+	s.syncAsSint32LE(_blitState.depthTestEnabled);
+}
+
+bool BlittingDrawCall::isOutdated() const {
+	return _imageVersion != tglGetBlitImageVersion(_image);
+}
+
 BlittingDrawCall::~BlittingDrawCall() {
 	tglDeleteBlitImage(_image);
 }
@@ -692,9 +1057,44 @@ ClearBufferDrawCall::ClearBufferDrawCall(bool clearZBuffer, int zValue,
 	TinyGL::GLContext *c = gl_get_context();
 	if (c->_enableDirtyRectangles) {
 		_dirtyRegion = c->renderRect;
+		computeSignature();
 	}
 }
 
+void ClearBufferDrawCall::computeSignature() {
+	SignatureHash hash;
+	hash.add(_clearZBuffer);
+	hash.add(_clearColorBuffer);
+	hash.add(_clearStencilBuffer);
+	hash.add(_rValue);
+	hash.add(_gValue);
+	hash.add(_bValue);
+	hash.add(_zValue);
+	hash.add(_stencilValue);
+	hash.add(_clearState.enableScissor);
+	hash.add(_clearState.scissor[0]);
+	hash.add(_clearState.scissor[1]);
+	hash.add(_clearState.scissor[2]);
+	hash.add(_clearState.scissor[3]);
+	_signature = hash.get();
+}
+
+ClearBufferDrawCall::ClearBufferDrawCall(FrameCaptureSerializer &s) : DrawCall(DrawCall_Clear) {
+	sync(s);
+}
+
+void ClearBufferDrawCall::sync(FrameCaptureSerializer &s) {
+	s.syncAsByte(_clearZBuffer);
+	s.syncAsByte(_clearColorBuffer);
+	s.syncAsByte(_clearStencilBuffer);
+	s.syncAsSint32LE(_rValue);
+	s.syncAsSint32LE(_gValue);
+	s.syncAsSint32LE(_bValue);
+	s.syncAsSint32LE(_zValue);
+	s.syncAsSint32LE(_stencilValue);
+	syncScissor(s, _clearState.enableScissor, _clearState.scissor);
+}
+
 void ClearBufferDrawCall::execute(bool restoreState, const Common::Rect *clippingRectangle) const {
 	ClearBufferState backupState;
 	if (restoreState) {
@@ -37,6 +37,7 @@ void *allocateFrame(int size);
 struct GLContext;
 struct GLVertex;
 struct GLTexture;
+class FrameCaptureSerializer;
 
 class DrawCall {
 public:
@@ -47,7 +48,7 @@ public:
 		DrawCall_Clear
 	};
 
-	DrawCall(DrawCallType type) : _type(type) { }
+	DrawCall(DrawCallType type) : _type(type), _signature(0) { }
 	virtual ~DrawCall() { }
 	bool operator==(const DrawCall &other) const;
 	bool operator!=(const DrawCall &other) const {
@@ -56,8 +57,26 @@ public:
 	virtual void execute(bool restoreState, const Common::Rect *clippingRectangle = nullptr) const = 0;
 	DrawCallType getType() const { return _type; }
 	virtual const Common::Rect getDirtyRegion() const { return _dirtyRegion; }
+
+	/**
+	 * Cheaper replacement for operator== when comparing frames: the draw calls
+	 * are compared through a hash of their vertices and state, which is only
+	 * computed when dirty rects are enabled.
+	 */
+	bool matchesPrevious(const DrawCall &previous) const {
+		return _type == previous._type && _signature == previous._signature && !previous.isOutdated();
+	}
+
+	// Saves a draw call to a frame capture, or creates it when loading
+	static void syncDrawCall(FrameCaptureSerializer &s, DrawCall *&drawCall);
 protected:
+	virtual void sync(FrameCaptureSerializer &s) = 0;
+
+	// Whether an image this call reads has been changed since it was recorded
+	virtual bool isOutdated() const { return false; }
+
 	Common::Rect _dirtyRegion;
+	uint64 _signature;
 private:
 	DrawCallType _type;
 };
@@ -65,6 +84,7 @@ private:
 class ClearBufferDrawCall : public DrawCall {
 public:
 	ClearBufferDrawCall(bool clearZBuffer, int zValue, bool clearColorBuffer, int rValue, int gValue, int bValue, bool clearStencilBuffer, int stencilValue);
+	explicit ClearBufferDrawCall(FrameCaptureSerializer &s);
 	virtual ~ClearBufferDrawCall() { }
 	bool operator==(const ClearBufferDrawCall &other) const;
 	virtual void execute(bool restoreState, const Common::Rect *clippingRectangle = nullptr) const;
@@ -74,7 +94,10 @@ public:
 	}
 
 	void operator delete(void *p) { }
+protected:
+	virtual void sync(FrameCaptureSerializer &s);
 private:
+	void computeSignature();
 	bool _clearZBuffer, _clearColorBuffer, _clearStencilBuffer;
 	int _rValue, _gValue, _bValue, _zValue, _stencilValue;
 	struct ClearBufferState {
@@ -101,6 +124,7 @@ private:
 class RasterizationDrawCall : public DrawCall {
 public:
 	RasterizationDrawCall();
+	explicit RasterizationDrawCall(FrameCaptureSerializer &s);
 	virtual ~RasterizationDrawCall() { }
 	bool operator==(const RasterizationDrawCall &other) const;
 	virtual void execute(bool restoreState, const Common::Rect *clippingRectangle = nullptr) const;
@@ -110,8 +134,12 @@ public:
 	}
 
 	void operator delete(void *p) { }
+protected:
+	virtual bool isOutdated() const;
+	virtual void sync(FrameCaptureSerializer &s);
 private:
 	void computeDirtyRegion();
+	void computeSignature();
 	typedef void (*gl_draw_triangle_func_ptr)(GLContext *c, TinyGL::GLVertex *p0, TinyGL::GLVertex *p1, TinyGL::GLVertex *p2);
 	int _vertexCount;
 	GLVertex *_vertex;
@@ -183,6 +211,7 @@ public:
 	};
 
 	BlittingDrawCall(BlitImage *image, const BlitTransform &transform, BlittingMode blittingMode);
+	explicit BlittingDrawCall(FrameCaptureSerializer &s);
 	virtual ~BlittingDrawCall();
 	bool operator==(const BlittingDrawCall &other) const;
 	virtual void execute(bool restoreState, const Common::Rect *clippingRectangle = nullptr) const;
@@ -194,8 +223,12 @@ public:
 	}
 
 	void operator delete(void *p) { }
+protected:
+	virtual bool isOutdated() const;
+	virtual void sync(FrameCaptureSerializer &s);
 private:
 	void computeDirtyRegion();
+	void computeSignature();
 	BlitImage *_image;
 	BlitTransform _transform;
 	BlittingMode _mode;
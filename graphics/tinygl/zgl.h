@@ -37,6 +37,7 @@
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 #include "graphics/tinygl/gl.h"
+#include "graphics/tinygl/tinygl.h"
 #include "graphics/tinygl/zbuffer.h"
 #include "graphics/tinygl/zmath.h"
 #include "graphics/tinygl/zblit.h"
@@ -238,6 +239,8 @@ public:
 		_memoryBuffer = nullptr;
 		_memorySize = 0;
 		_memoryPosition = 0;
+		_allocationCount = 0;
+		_peakPosition = 0;
 	}
 
 	void initialize(size_t newSize) {
@@ -257,21 +260,35 @@ public:
 	}
 
 	void *allocate(size_t size) {
+		// Keep every allocation aligned for the pointers and floats stored in draw calls
+		size = (size + kAlignment - 1) & ~(kAlignment - 1);
 		if (_memoryPosition + size >= _memorySize) {
 			error("Allocator out of memory: couldn't allocate more memory from linear allocator.");
 		}
 		size_t returnPos = _memoryPosition;
 		_memoryPosition += size;
+		_allocationCount++;
 		return ((byte *)_memoryBuffer) + returnPos;
 	}
 
 	void reset() {
+		_peakPosition = MAX(_peakPosition, _memoryPosition);
 		_memoryPosition = 0;
+		_allocationCount = 0;
 	}
+
+	size_t getAllocatedSize() const { return _memoryPosition; }
+	uint getAllocationCount() const { return _allocationCount; }
+	size_t getPeakSize() const { return MAX(_peakPosition, _memoryPosition); }
+	size_t getCapacity() const { return _memorySize; }
 private:
+	static const size_t kAlignment = 8;
+
 	void *_memoryBuffer;
 	size_t _memorySize;
 	size_t _memoryPosition;
+	uint _allocationCount;
+	size_t _peakPosition;
 };
 
 struct GLContext;
@@ -462,11 +479,19 @@ struct GLContext {
 	Common::List<BlitImage *> _blitImages;
 
 	// Draw call queue
-	Common::List<DrawCall *> _drawCallsQueue;
-	Common::List<DrawCall *> _previousFrameDrawCallsQueue;
+	// The queues keep their storage from frame to frame, and each one
+	// allocates its draw calls from its own half of the frame allocator.
+	Common::Array<DrawCall *> _drawCallsQueue;
+	Common::Array<DrawCall *> _previousFrameDrawCallsQueue;
 	int _currentAllocatorIndex;
 	LinearAllocator _drawCallAllocator[2];
+	FrameStats _frameStats;
 	bool _debugRectsEnabled;
+
+	// Frame capture
+	Common::WriteStream *_captureStream;
+	DisposeAfterUse::Flag _disposeCaptureStream;
+	Common::Array<DrawCall *> _replayDrawCalls;
 	bool _profilingEnabled;
 
 	void gl_vertex_transform(GLVertex *v);
@@ -522,10 +547,14 @@ public:
 	void issueDrawCall(DrawCall *drawCall);
 	void disposeResources();
 	void disposeDrawCallLists();
+	void updateFrameStats(uint changedCalls);
 
 	void presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas);
 	void presentBufferSimple(Common::List<Common::Rect> &dirtyAreas);
 
+	void saveFrameCapture();
+	bool loadFrameCapture(FrameCaptureSerializer &s);
+
 	void debugDrawRectangle(Common::Rect rect, int r, int g, int b);
 
 	GLSpecBuf *specbuf_get_buffer(const int shininess_i, const float shininess);
@@ -149,6 +149,16 @@ end:
 	}
 }
 
+// Picks the mip level from the larger of the texture coordinate steps
+// between horizontally and vertically neighbouring pixels
+const TexelBuffer *FrameBuffer::selectMipLevel(float ss, float tt, float zinv, int dsdx, int dtdx,
+                                               float dszdy, float dtzdy, float fdzdy) const {
+	int dsdy = (int)((dszdy - ss * fdzdy) * zinv);
+	int dtdy = (int)((dtzdy - tt * fdzdy) * zinv);
+	uint footprint = MAX(MAX(ABS(dsdx), ABS(dtdx)), MAX(ABS(dsdy), ABS(dtdy)));
+	return _currentTexture->getLevel(footprint);
+}
+
 template <bool kDepthWrite, bool kEnableScissor, bool kStencilEnabled, bool kStippleEnabled, bool kDepthTestEnabled>
 void FrameBuffer::putPixelDepth(uint *pz, byte *ps, int _a, int x, int y, uint &z, int &dzdx) {
 	if (kEnableScissor && scissorPixel(x + _a, y)) {
@@ -187,7 +197,8 @@ template <bool kInterpRGB, bool kInterpZ, bool kInterpST, bool kInterpSTZ, bool
           bool kBlendingEnabled, bool kStencilEnabled, bool kStippleEnabled, bool kDepthTestEnabled>
 void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint *p2) {
 	const TexelBuffer *texture;
-	float fdzdx = 0, fndzdx = 0, ndszdx = 0, ndtzdx = 0;
+	bool mipmapped = false;
+	float fdzdx = 0, fdzdy = 0, fndzdx = 0, ndszdx = 0, ndtzdx = 0;
 
 	ZBufferPoint *tp, *pr1 = 0, *pr2 = 0, *l1 = 0, *l2 = 0;
 	float fdx1, fdx2, fdy1, fdy2, fz0, d1, d2;
@@ -344,7 +355,9 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 
 	if (kInterpRGB && (kInterpST || kInterpSTZ)) {
 		texture = _currentTexture;
+		mipmapped = texture->hasMipmaps();
 		fdzdx = (float)dzdx;
+		fdzdy = (float)dzdy;
 		fndzdx = NB_INTERP * fdzdx;
 		ndszdx = NB_INTERP * dszdx;
 		ndtzdx = NB_INTERP * dtzdx;
@@ -579,6 +592,8 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 						t = (int)tt;
 						dsdx = (int)((dszdx - ss * fdzdx) * zinv);
 						dtdx = (int)((dtzdx - tt * fdzdx) * zinv);
+						if (mipmapped)
+							texture = selectMipLevel(ss, tt, zinv, dsdx, dtdx, dszdy, dtzdy, fdzdy);
 						fz += fndzdx;
 						zinv = (float)(1.0 / fz);
 					}
@@ -607,6 +622,8 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 					t = (int)tt;
 					dsdx = (int)((dszdx - ss * fdzdx) * zinv);
 					dtdx = (int)((dtzdx - tt * fdzdx) * zinv);
+					if (mipmapped)
+						texture = selectMipLevel(ss, tt, zinv, dsdx, dtdx, dszdy, dtzdy, fdzdy);
 				}
 
 				while (n >= 0) {
@@ -0,0 +1,155 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "gui/ThemeDrawCache.h"
+
+#include "graphics/managed_surface.h"
+
+namespace GUI {
+
+ThemeDrawCache::ThemeDrawCache(uint32 maxSize) :
+	_usedMemory(0), _maxSize(maxSize), _hits(0), _misses(0),
+	_width(0), _height(0), _graphicsMode(0), _scale(1.0f) {
+}
+
+ThemeDrawCache::~ThemeDrawCache() {
+	clear();
+}
+
+void ThemeDrawCache::setTheme(const Common::String &themeId) {
+	if (themeId == _themeId)
+		return;
+
+	clear();
+	_themeId = themeId;
+}
+
+void ThemeDrawCache::setScreen(const Graphics::PixelFormat &format, int width, int height, int graphicsMode) {
+	if (format == _format && width == _width && height == _height && graphicsMode == _graphicsMode)
+		return;
+
+	clear();
+	_format = format;
+	_width = width;
+	_height = height;
+	_graphicsMode = graphicsMode;
+}
+
+void ThemeDrawCache::setScale(float scale) {
+	if (scale == _scale)
+		return;
+
+	clear();
+	_scale = scale;
+}
+
+bool ThemeDrawCache::copy(const DrawDataCacheKey &key, Graphics::ManagedSurface *surface, const Common::Rect &rect) {
+	EntriesMap::iterator entry = _cache.find(key);
+	if (entry == _cache.end()) {
+		_misses++;
+		return false;
+	}
+
+	const uint32 rowSize = rect.width() * surface->format.bytesPerPixel;
+
+	// The cached result is only valid when drawn over the same background
+	const byte *before = entry->_value.pixels;
+	for (int y = rect.top; y < rect.bottom; ++y, before += rowSize) {
+		if (memcmp(surface->getBasePtr(rect.left, y), before, rowSize) != 0) {
+			_misses++;
+			return false;
+		}
+	}
+
+	const byte *after = entry->_value.pixels + entry->_value.size;
+	for (int y = rect.top; y < rect.bottom; ++y, after += rowSize)
+		memcpy(surface->getBasePtr(rect.left, y), after, rowSize);
+
+	_lru.erase(entry->_value.lru);
+	entry->_value.lru = _lru.insert(_lru.end(), key);
+	_hits++;
+	return true;
+}
+
+byte *ThemeDrawCache::begin(const Graphics::ManagedSurface *surface, const Common::Rect &rect) {
+	const uint32 rowSize = rect.width() * surface->format.bytesPerPixel;
+	const uint32 size = rowSize * rect.height();
+
+	// Do not let a single large item, such as a dialog background, flush the whole cache
+	if (size == 0 || size * 2 > _maxSize / 4)
+		return nullptr;
+
+	byte *pixels = (byte *)malloc(size * 2);
+	if (!pixels)
+		return nullptr;
+
+	byte *before = pixels;
+	for (int y = rect.top; y < rect.bottom; ++y, before += rowSize)
+		memcpy(before, surface->getBasePtr(rect.left, y), rowSize);
+
+	return pixels;
+}
+
+void ThemeDrawCache::end(const DrawDataCacheKey &key, const Graphics::ManagedSurface *surface, const Common::Rect &rect, byte *pixels) {
+	const uint32 rowSize = rect.width() * surface->format.bytesPerPixel;
+	const uint32 size = rowSize * rect.height();
+
+	byte *after = pixels + size;
+	for (int y = rect.top; y < rect.bottom; ++y, after += rowSize)
+		memcpy(after, surface->getBasePtr(rect.left, y), rowSize);
+
+	// Replace any entry drawn over a different background
+	remove(key);
+
+	while (_usedMemory + size * 2 > _maxSize && !_lru.empty()) {
+		const DrawDataCacheKey oldest = _lru.front();
+		remove(oldest);
+	}
+
+	Entry entry;
+	entry.pixels = pixels;
+	entry.size = size;
+	entry.lru = _lru.insert(_lru.end(), key);
+	_cache[key] = entry;
+	_usedMemory += size * 2;
+}
+
+void ThemeDrawCache::remove(const DrawDataCacheKey &key) {
+	EntriesMap::iterator entry = _cache.find(key);
+	if (entry == _cache.end())
+		return;
+
+	_usedMemory -= entry->_value.size * 2;
+	free(entry->_value.pixels);
+	_lru.erase(entry->_value.lru);
+	_cache.erase(entry);
+}
+
+void ThemeDrawCache::clear() {
+	for (auto &entry : _cache)
+		free(entry._value.pixels);
+
+	_cache.clear();
+	_lru.clear();
+	_usedMemory = 0;
+}
+
+} // End of namespace GUI
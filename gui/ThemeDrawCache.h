@@ -0,0 +1,172 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GUI_THEME_DRAW_CACHE_H
+#define GUI_THEME_DRAW_CACHE_H
+
+#include "common/scummsys.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/rect.h"
+#include "common/str.h"
+#include "common/ustr.h"
+
+#include "graphics/pixelformat.h"
+
+namespace Graphics {
+class Font;
+class ManagedSurface;
+}
+
+namespace GUI {
+
+/**
+ * Identifies a DrawData item or a text rendered by the ThemeEngine's draw
+ * cache. All rectangles are relative to the top-left corner of the drawing
+ * area, so identical widgets at different positions share the same entry.
+ * The text fields are only used for widget texts, which leave type set to -1.
+ */
+struct DrawDataCacheKey {
+	int type; ///< The DrawData item, or -1 (kDDNone) for texts
+	uint32 dynamic;
+	Common::Rect area;
+	Common::Rect extendedRect;
+	Common::Rect clip;
+
+	const Graphics::Font *font;
+	uint32 textColor;
+	Common::U32String text;
+	int alignH;
+	int alignV;
+	int deltax;
+	bool ellipsis;
+
+	DrawDataCacheKey() : type(-1), dynamic(0), font(nullptr), textColor(0),
+		alignH(0), alignV(0), deltax(0), ellipsis(false) {}
+
+	bool operator==(const DrawDataCacheKey &other) const {
+		return type == other.type && dynamic == other.dynamic && area == other.area &&
+		       extendedRect == other.extendedRect && clip == other.clip &&
+		       font == other.font && textColor == other.textColor && alignH == other.alignH &&
+		       alignV == other.alignV && deltax == other.deltax && ellipsis == other.ellipsis &&
+		       text == other.text;
+	}
+};
+
+struct DrawDataCacheKey_Hash {
+	uint operator()(const DrawDataCacheKey &key) const {
+		uint hash = (uint)key.type * 31 + key.dynamic;
+		hash = hash * 31 + (((uint)key.area.width() << 16) ^ (uint)key.area.height());
+		hash = hash * 31 + hashRect(key.extendedRect);
+		hash = hash * 31 + hashRect(key.clip);
+		if (key.font) {
+			hash = hash * 31 + key.textColor;
+			hash = hash * 31 + Common::Hash<Common::U32String>()(key.text);
+			hash = hash * 31 + (((uint)key.alignH << 24) ^ ((uint)key.alignV << 16) ^ (uint)key.deltax);
+		}
+		return hash;
+	}
+
+	static uint hashRect(const Common::Rect &r) {
+		return ((uint)r.left << 24) ^ ((uint)r.top << 16) ^ ((uint)r.right << 8) ^ (uint)r.bottom;
+	}
+};
+
+/**
+ * Rendered DrawData items and widget texts of the ThemeEngine.
+ *
+ * When the same item is drawn again with the same size over the same
+ * background, the result is copied instead of running the DrawSteps or
+ * rasterizing the glyphs again. The pixels of the extended rectangle
+ * before drawing are kept next to the rendered result, since antialiased
+ * edges, shadows and glyphs are blended with whatever was there before.
+ *
+ * Entries are dropped when the theme, the screen or the scale they were
+ * rendered for changes, and the least recently used ones are dropped
+ * when the cache grows past its maximum size.
+ */
+class ThemeDrawCache {
+public:
+	explicit ThemeDrawCache(uint32 maxSize);
+	~ThemeDrawCache();
+
+	/** Sets the theme the entries are rendered with, clearing the cache if it changed. */
+	void setTheme(const Common::String &themeId);
+
+	/** Sets the screen the entries are rendered on, clearing the cache if it changed. */
+	void setScreen(const Graphics::PixelFormat &format, int width, int height, int graphicsMode);
+
+	/** Sets the GUI scale the entries are rendered at, clearing the cache if it changed. */
+	void setScale(float scale);
+
+	/**
+	 * Copies the cached result of key into rect of surface, if there is one
+	 * and it was drawn over the pixels currently in rect.
+	 *
+	 * @return true if the cached result was copied.
+	 */
+	bool copy(const DrawDataCacheKey &key, Graphics::ManagedSurface *surface, const Common::Rect &rect);
+
+	/**
+	 * Keeps the pixels of rect before drawing into it.
+	 *
+	 * @return the pixels to pass to end(), or nullptr if rect is too large to be cached.
+	 */
+	byte *begin(const Graphics::ManagedSurface *surface, const Common::Rect &rect);
+
+	/** Stores the result of drawing key into rect, which begin() was called for. */
+	void end(const DrawDataCacheKey &key, const Graphics::ManagedSurface *surface, const Common::Rect &rect, byte *pixels);
+
+	void remove(const DrawDataCacheKey &key);
+	void clear();
+
+	uint size() const { return _cache.size(); }
+	uint32 getUsedMemory() const { return _usedMemory; }
+	uint32 getHits() const { return _hits; }
+	uint32 getMisses() const { return _misses; }
+
+private:
+	struct Entry {
+		byte *pixels; ///< Contents before drawing, followed by the contents after drawing
+		uint32 size;  ///< Size in bytes of each of the two snapshots
+		Common::List<DrawDataCacheKey>::iterator lru;
+	};
+
+	typedef Common::HashMap<DrawDataCacheKey, Entry, DrawDataCacheKey_Hash> EntriesMap;
+
+	EntriesMap _cache;
+	/** The keys of the entries, from least to most recently used */
+	Common::List<DrawDataCacheKey> _lru;
+	uint32 _usedMemory;
+	uint32 _maxSize;
+	uint32 _hits;
+	uint32 _misses;
+
+	Common::String _themeId;
+	Graphics::PixelFormat _format;
+	int _width, _height, _graphicsMode;
+	float _scale;
+};
+
+} // End of namespace GUI
+
+#endif
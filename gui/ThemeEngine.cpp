@@ -21,13 +21,18 @@
 
 #include "common/system.h"
 #include "common/config-manager.h"
+#include "common/crc.h"
 #include "common/file.h"
 #include "common/fs.h"
+#include "common/memstream.h"
+#include "common/substream.h"
 #include "common/compression/unzip.h"
 #include "common/tokenizer.h"
 #include "common/translation.h"
 #include "common/unicode-bidi.h"
 
+#include "base/version.h"
+
 #include "graphics/blit.h"
 #include "graphics/cursorman.h"
 #include "graphics/fontman.h"
@@ -47,6 +52,9 @@
 
 namespace GUI {
 
+static const uint32 kCompiledThemeTag = MKTAG('S', 'T', 'X', 'C');
+static const uint32 kCompiledThemeVersion = 1;
+
 const char *const ThemeEngine::kImageLogo = "logo.bmp";
 const char *const ThemeEngine::kImageLogoSmall = "logo_small.bmp";
 const char *const ThemeEngine::kImageSearch = "search.bmp";
@@ -85,6 +93,10 @@ struct WidgetDrawData {
 
 	DrawLayer _layer;
 
+	/** Whether the result of drawing this item only depends on its DrawSteps,
+	    and can thus be kept in the rendered DrawData cache */
+	bool _cacheable;
+
 
 	/**
 	 * Calculates the background threshold offset of a given DrawData item.
@@ -94,6 +106,12 @@ struct WidgetDrawData {
 	 * value will be added when restoring the background of the widget.
 	 */
 	void calcBackgroundOffset();
+
+	/**
+	 * Checks whether every color used by the DrawSteps is set by the DrawSteps
+	 * themselves, rather than left over in the renderer by previous drawing.
+	 */
+	void calcCacheable();
 };
 
 /**********************************************************
@@ -189,7 +207,7 @@ ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 	_system(nullptr), _vectorRenderer(nullptr),
 	_layerToDraw(kDrawLayerBackground), _bytesPerPixel(0),  _graphicsMode(kGfxDisabled),
 	_font(nullptr), _initOk(false), _themeOk(false), _enabled(false), _themeFiles(),
-	_cursor(nullptr), _scaleFactor(1.0f) {
+	_cursor(nullptr), _scaleFactor(1.0f), _drawDataCache(kDrawDataCacheMaxSize) {
 
 	_baseWidth = 640;	// Default sane values
 	_baseHeight = 480;
@@ -247,14 +265,7 @@ ThemeEngine::~ThemeEngine() {
 	unloadExtraFont();
 
 	// Release all graphics surfaces
-	for (auto &bitmap : _bitmaps) {
-		Graphics::ManagedSurface *surf = bitmap._value;
-		if (surf) {
-			surf->free();
-			delete surf;
-		}
-	}
-	_bitmaps.clear();
+	clearBitmaps();
 
 	delete _parser;
 	delete _themeEval;
@@ -310,6 +321,7 @@ void ThemeEngine::setBaseResolution(int w, int h, float s) {
 		_needScaleRefresh = true;
 
 	_scaleFactor = s;
+	_drawDataCache.setScale(s);
 
 	_parser->setBaseResolution(w, h, s);
 	_themeEval->setScaleFactor(s);
@@ -382,14 +394,7 @@ void ThemeEngine::refresh() {
 
 	// Flush all bitmaps if the overlay pixel format changed.
 	if (_overlayFormat != _system->getOverlayFormat() || _needScaleRefresh) {
-		for (auto &bitmap : _bitmaps) {
-			Graphics::ManagedSurface *surf = bitmap._value;
-			if (surf) {
-				surf->free();
-				delete surf;
-			}
-		}
-		_bitmaps.clear();
+		clearBitmaps();
 
 		_needScaleRefresh = false;
 	}
@@ -460,6 +465,8 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	_screen.free();
 	_screen.create(width, height, _overlayFormat);
 
+	_drawDataCache.setScreen(_overlayFormat, width, height, mode);
+
 	delete _vectorRenderer;
 	_vectorRenderer = Graphics::createRenderer(mode);
 	_vectorRenderer->setSurface(&_screen);
@@ -486,6 +493,33 @@ void WidgetDrawData::calcBackgroundOffset() {
 	_shadowOffset = maxShadow;
 }
 
+void WidgetDrawData::calcCacheable() {
+	bool fgSet = false, bgSet = false, gradientSet = false, bevelSet = false;
+
+	_cacheable = true;
+	for (Common::List<Graphics::DrawStep>::const_iterator step = _steps.begin();
+	        step != _steps.end(); ++step) {
+		fgSet |= step->fgColor.set;
+		bgSet |= step->bgColor.set;
+		gradientSet |= (step->gradColor1.set && step->gradColor2.set);
+		bevelSet |= step->bevelColor.set;
+
+		if (step->drawingCall == &Graphics::VectorRenderer::drawCallback_VOID ||
+		        step->drawingCall == &Graphics::VectorRenderer::drawCallback_BITMAP)
+			continue;
+
+		if (!fgSet)
+			_cacheable = false;
+		if (!bgSet && (step->fillMode == Graphics::VectorRenderer::kFillBackground ||
+		               step->drawingCall == &Graphics::VectorRenderer::drawCallback_BEVELSQ))
+			_cacheable = false;
+		if (!gradientSet && step->fillMode == Graphics::VectorRenderer::kFillGradient)
+			_cacheable = false;
+		if (!bevelSet && step->bevel > 0)
+			_cacheable = false;
+	}
+}
+
 void ThemeEngine::restoreBackground(Common::Rect r) {
 	if (_vectorRenderer->getActiveSurface() == &_backBuffer) {
 		// Only restore the background when drawing to the screen surface
@@ -544,6 +578,9 @@ bool ThemeEngine::addFont(TextData textId, const Common::String &language, const
 	if (_texts[textId] != nullptr)
 		delete _texts[textId];
 
+	// Cached texts are keyed on the font they were rendered with
+	_drawDataCache.clear();
+
 	_texts[textId] = new TextDrawData;
 
 	if (file == "default") {
@@ -647,24 +684,61 @@ bool ThemeEngine::addTextColor(TextColor colorId, int r, int g, int b) {
 
 bool ThemeEngine::addBitmap(const Common::String &filename, const Common::String &scalablefile, int width, int height) {
 	// Nothing has to be done if the bitmap already has been loaded.
-	Graphics::ManagedSurface *surf = _bitmaps[filename];
-	if (surf) {
-		return true;
+	ImagesMap::iterator bitmap = _bitmaps.find(filename);
+	if (bitmap != _bitmaps.end()) {
+		if (bitmap->_value)
+			return true;
+
+		// Try again if it failed to load before
+		_bitmaps.erase(bitmap);
 	}
 
-	if (!scalablefile.empty()) {
+	// The bitmap is decoded on first use, only check that it exists for now.
+	Common::ArchiveMemberList members;
+	_themeFiles.listMatchingMembers(members, Common::Path(scalablefile.empty() ? filename : scalablefile, '/'));
+	if (members.empty())
+		return false;
+
+	BitmapSource &source = _bitmapSources[filename];
+	source.scalableFile = scalablefile;
+	source.width = width;
+	source.height = height;
+
+	return true;
+}
+
+Graphics::ManagedSurface *ThemeEngine::getImageSurface(const Common::String &name) {
+	ImagesMap::const_iterator bitmap = _bitmaps.find(name);
+	if (bitmap != _bitmaps.end())
+		return bitmap->_value;
+
+	BitmapSourcesMap::const_iterator source = _bitmapSources.find(name);
+	if (source == _bitmapSources.end())
+		return nullptr;
+
+	// Store the surface into our hashmap (attention, may store NULL entries!)
+	Graphics::ManagedSurface *surf = loadBitmap(name, source->_value);
+	_bitmaps[name] = surf;
+
+	return surf;
+}
+
+Graphics::ManagedSurface *ThemeEngine::loadBitmap(const Common::String &filename, const BitmapSource &source) {
+	Graphics::ManagedSurface *surf = nullptr;
+
+	if (!source.scalableFile.empty()) {
 		Common::ArchiveMemberList members;
-		_themeFiles.listMatchingMembers(members, Common::Path(scalablefile, '/'));
+		_themeFiles.listMatchingMembers(members, Common::Path(source.scalableFile, '/'));
 		for (Common::ArchiveMemberList::const_iterator i = members.begin(), end = members.end(); i != end; ++i) {
 			Common::SeekableReadStream *stream = (*i)->createReadStream();
 			if (stream) {
-				_bitmaps[filename] = new Graphics::SVGBitmap(stream, width * _scaleFactor, height * _scaleFactor);
+				surf = new Graphics::SVGBitmap(stream, source.width * _scaleFactor, source.height * _scaleFactor);
 				delete stream;
-				return true;
+				return surf;
 			}
 		}
 
-		return false;
+		return nullptr;
 	}
 
 	const Graphics::Surface *srcSurface = nullptr;
@@ -731,10 +805,20 @@ bool ThemeEngine::addBitmap(const Common::String &filename, const Common::String
 
 		surf = surf2;
 	}
-	// Store the surface into our hashmap (attention, may store NULL entries!)
-	_bitmaps[filename] = surf;
 
-	return surf != nullptr;
+	return surf;
+}
+
+void ThemeEngine::clearBitmaps() {
+	for (auto &bitmap : _bitmaps) {
+		Graphics::ManagedSurface *surf = bitmap._value;
+		if (surf) {
+			surf->free();
+			delete surf;
+		}
+	}
+	_bitmaps.clear();
+	_bitmapSources.clear();
 }
 
 bool ThemeEngine::addDrawData(const Common::String &data, bool cached) {
@@ -749,6 +833,7 @@ bool ThemeEngine::addDrawData(const Common::String &data, bool cached) {
 	_widgets[id] = new WidgetDrawData;
 	_widgets[id]->_layer = kDrawDataDefaults[id].layer;
 	_widgets[id]->_textDataId = kTextDataNone;
+	_widgets[id]->_cacheable = false;
 
 	return true;
 }
@@ -779,9 +864,12 @@ void ThemeEngine::loadTheme(const Common::String &themeId) {
 			warning("Missing data asset: '%s' in theme '%s", kDrawDataDefaults[i].name, themeId.c_str());
 		} else {
 			_widgets[i]->calcBackgroundOffset();
+			_widgets[i]->calcCacheable();
 		}
 	}
 
+	_drawDataCache.setTheme(_themeId);
+
 	debug(6, "Finished loading theme %s", themeId.c_str());
 }
 
@@ -789,6 +877,12 @@ void ThemeEngine::unloadTheme() {
 	if (!_themeOk)
 		return;
 
+	clearThemeData();
+}
+
+void ThemeEngine::clearThemeData() {
+	_drawDataCache.clear();
+
 	for (int i = 0; i < kDrawDataMAX; ++i) {
 		delete _widgets[i];
 		_widgets[i] = nullptr;
@@ -829,11 +923,25 @@ bool ThemeEngine::loadDefaultXML() {
 	for (int i = 0; i < ARRAYSIZE(defaultXML); i++)
 		xmllen += strlen(defaultXML[i]);
 
+	_themeName = "ScummVM Classic Theme (Builtin Version)";
+	_themeId = "builtin";
+	_themeFile.clear();
+
 	byte *tmpXML = (byte *)malloc(xmllen + 1);
-	tmpXML[0] = '\0';
+	byte *dst = tmpXML;
 
-	for (int i = 0; i < ARRAYSIZE(defaultXML); i++)
-		strncat((char *)tmpXML, defaultXML[i], xmllen);
+	for (int i = 0; i < ARRAYSIZE(defaultXML); i++) {
+		int len = strlen(defaultXML[i]);
+		memcpy(dst, defaultXML[i], len);
+		dst += len;
+	}
+	*dst = '\0';
+
+	const Common::String compiledKey = Common::String::format("builtin\n%s\n%d:%08x", gScummVMFullVersion, xmllen, Common::CRC32().crcFast(tmpXML, xmllen));
+	if (loadCompiledTheme(compiledKey)) {
+		free(tmpXML);
+		return true;
+	}
 
 	if (!_parser->loadBuffer(tmpXML, xmllen)) {
 		free(tmpXML);
@@ -841,15 +949,23 @@ bool ThemeEngine::loadDefaultXML() {
 		return false;
 	}
 
-	_themeName = "ScummVM Classic Theme (Builtin Version)";
-	_themeId = "builtin";
-	_themeFile.clear();
+	Common::MemoryWriteStreamDynamic compiled(DisposeAfterUse::YES);
+	Common::MemoryWriteStreamDynamic document(DisposeAfterUse::YES);
 
+	_parser->setCompiledOutput(&document);
 	bool result = _parser->parse();
+	_parser->setCompiledOutput(nullptr);
 	_parser->close();
 
 	free(tmpXML);
 
+	if (result) {
+		compiled.writeUint32LE(1);
+		compiled.writeUint32LE(document.size());
+		compiled.write(document.getData(), document.size());
+		storeCompiledTheme(compiledKey, compiled);
+	}
+
 	return result;
 #else
 	warning("The built-in theme is not enabled in the current build. Please load an external theme");
@@ -886,6 +1002,15 @@ bool ThemeEngine::loadThemeXML(const Common::String &themeId) {
 		return false;
 	}
 
+	// Without a stamp, the compiled theme could be out of date
+	const Common::String stamp = getThemeFilesStamp(members);
+	const Common::String compiledKey = stamp.empty() ? Common::String() : themeId + '\n' + stxHeader + '\n' + stamp;
+	if (!compiledKey.empty() && loadCompiledTheme(compiledKey))
+		return true;
+
+	Common::MemoryWriteStreamDynamic compiled(DisposeAfterUse::YES);
+	compiled.writeUint32LE(members.size());
+
 	//
 	// Loop over all STX files, load and parse them
 	//
@@ -898,19 +1023,171 @@ bool ThemeEngine::loadThemeXML(const Common::String &themeId) {
 			return false;
 		}
 
+		Common::MemoryWriteStreamDynamic document(DisposeAfterUse::YES);
+		_parser->setCompiledOutput(&document);
+
 		if (_parser->parse() == false) {
 			warning("Failed to parse STX file '%s'", member->getName().c_str());
+			_parser->setCompiledOutput(nullptr);
 			_parser->close();
 			return false;
 		}
 
+		_parser->setCompiledOutput(nullptr);
 		_parser->close();
+
+		compiled.writeUint32LE(document.size());
+		compiled.write(document.getData(), document.size());
 	}
 
 	assert(!_themeName.empty());
+
+	if (!compiledKey.empty())
+		storeCompiledTheme(compiledKey, compiled);
 	return true;
 }
 
+static Common::String getFileStamp(const Common::FSNode &node) {
+	int64 time;
+	if (!node.exists() || !node.getModificationTime(time))
+		return Common::String();
+
+	Common::ScopedPtr<Common::SeekableReadStream> stream(node.createReadStream());
+	if (!stream)
+		return Common::String();
+
+	return Common::String::format("%s:%u:%08x%08x\n", node.getName().c_str(), (uint)stream->size(),
+	                              (uint32)((uint64)time >> 32), (uint32)time);
+}
+
+Common::String ThemeEngine::getThemeFilesStamp(const Common::ArchiveMemberList &members) const {
+	if (_themeFile.empty())
+		return Common::String();
+
+	// A zipped theme is stamped as a whole
+	Common::FSNode node(_themeFile);
+	if (!node.isDirectory())
+		return getFileStamp(node);
+
+	Common::String stamp;
+	for (const auto &member : members) {
+		Common::String fileStamp = getFileStamp(node.getChild(member->getName()));
+		if (fileStamp.empty())
+			return Common::String();
+
+		stamp += fileStamp;
+	}
+
+	return stamp;
+}
+
+Common::String ThemeEngine::getCompiledThemeFilename() const {
+	Common::String filename = "theme_";
+	for (uint i = 0; i < _themeId.size(); i++)
+		filename += Common::isAlnum(_themeId[i]) ? _themeId[i] : '_';
+	filename += ".stxc";
+	return filename;
+}
+
+Common::FSNode ThemeEngine::getCompiledThemeNode() const {
+	Common::Path configFile = ConfMan.getCustomConfigFileName();
+	if (configFile.empty())
+		configFile = _system->getDefaultConfigFileName();
+	if (configFile.empty())
+		return Common::FSNode();
+
+	return Common::FSNode(configFile).getParent().getChild(getCompiledThemeFilename());
+}
+
+bool ThemeEngine::loadCompiledTheme(const Common::String &key) {
+	if (_compiledThemeKey != key) {
+		_compiledThemeKey.clear();
+		_compiledTheme.clear();
+
+		Common::FSNode node = getCompiledThemeNode();
+		if (!node.exists())
+			return false;
+
+		Common::ScopedPtr<Common::SeekableReadStream> file(node.createReadStream());
+		if (!file)
+			return false;
+
+		if (file->readUint32BE() != kCompiledThemeTag || file->readUint32BE() != kCompiledThemeVersion)
+			return false;
+
+		uint32 keySize = file->readUint32LE();
+		if (keySize != key.size() || file->readString(0, keySize) != key)
+			return false;
+
+		uint32 size = file->readUint32LE();
+		uint32 crc = file->readUint32LE();
+		if (file->err() || size != file->size() - file->pos())
+			return false;
+
+		_compiledTheme.resize(size);
+		if (file->read(_compiledTheme.data(), size) != size || Common::CRC32().crcFast(_compiledTheme.data(), size) != crc) {
+			_compiledTheme.clear();
+			return false;
+		}
+
+		_compiledThemeKey = key;
+	}
+
+	Common::MemoryReadStream stream(_compiledTheme.data(), _compiledTheme.size());
+	uint32 count = stream.readUint32LE();
+	bool result = true;
+
+	while (count-- && result) {
+		uint32 size = stream.readUint32LE();
+		int32 start = stream.pos();
+		if (size > (uint32)(stream.size() - start)) {
+			result = false;
+			break;
+		}
+
+		Common::SeekableSubReadStream document(&stream, start, start + size);
+		result = _parser->parseCompiled(&document, getCompiledThemeFilename());
+		stream.seek(start + size);
+	}
+
+	if (!result) {
+		warning("Failed to load compiled theme '%s', parsing it again", _themeId.c_str());
+		_compiledThemeKey.clear();
+		_compiledTheme.clear();
+
+		// Drop whatever was loaded before the failure
+		clearThemeData();
+	}
+
+	return result;
+}
+
+void ThemeEngine::storeCompiledTheme(const Common::String &key, Common::MemoryWriteStreamDynamic &data) {
+	_compiledThemeKey = key;
+	_compiledTheme.resize(data.size());
+	memcpy(_compiledTheme.data(), data.getData(), data.size());
+
+	// The file is written to a temporary one first, so that an interrupted
+	// write does not leave a truncated compiled theme behind
+	Common::ScopedPtr<Common::SeekableWriteStream> file(getCompiledThemeNode().createWriteStream());
+	if (!file) {
+		warning("Couldn't create compiled theme file for theme '%s'", _themeId.c_str());
+		return;
+	}
+
+	file->writeUint32BE(kCompiledThemeTag);
+	file->writeUint32BE(kCompiledThemeVersion);
+	file->writeUint32LE(key.size());
+	file->writeString(key);
+	file->writeUint32LE(data.size());
+	file->writeUint32LE(Common::CRC32().crcFast(data.getData(), data.size()));
+	file->write(data.getData(), data.size());
+	file->finalize();
+
+	if (file->err())
+		warning("Couldn't write compiled theme file for theme '%s'", _themeId.c_str());
+}
+
 
 
 /**********************************************************
@@ -948,18 +1225,55 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 		restoreBackground(extendedRect);
 
 	if (drawData->_layer == _layerToDraw) {
+		// Drawing is only known to stay within the extended rect when clipped
+		const bool useCache = drawData->_cacheable && !_clip.isEmpty();
+		DrawDataCacheKey key;
+		byte *cachePixels = nullptr;
+
+		if (useCache) {
+			key.type = type;
+			key.dynamic = dynamic;
+			key.area = Common::Rect(area.width(), area.height());
+			key.extendedRect = extendedRect;
+			key.extendedRect.translate(-area.left, -area.top);
+			key.clip = _clip;
+			key.clip.translate(-area.left, -area.top);
+
+			if (drawCachedDD(key, drawData, area, extendedRect, dynamic)) {
+				addDirtyRect(extendedRect);
+				return;
+			}
+
+			cachePixels = _drawDataCache.begin(_vectorRenderer->getActiveSurface(), extendedRect);
+		}
+
 		Common::List<Graphics::DrawStep>::const_iterator step;
 		for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
 			_vectorRenderer->drawStep(area, _clip, *step, dynamic);
 		}
 
+		if (cachePixels)
+			_drawDataCache.end(key, _vectorRenderer->getActiveSurface(), extendedRect, cachePixels);
+
 		addDirtyRect(extendedRect);
 	}
 }
 
+bool ThemeEngine::drawCachedDD(const DrawDataCacheKey &key, const WidgetDrawData *drawData, const Common::Rect &area, const Common::Rect &extendedRect, uint32 dynamic) {
+	if (!_drawDataCache.copy(key, _vectorRenderer->getActiveSurface(), extendedRect))
+		return false;
+
+	// Leave the renderer in the same state as if the DrawSteps had been drawn
+	Common::List<Graphics::DrawStep>::const_iterator step;
+	for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step)
+		_vectorRenderer->setStepState(area, _clip, *step, dynamic);
+
+	return true;
+}
+
 void ThemeEngine::drawDDText(TextData type, TextColor color, const Common::Rect &r, const Common::U32String &text,
 	bool restoreBg, bool ellipsis, Graphics::TextAlign alignH, TextAlignVertical alignV,
-	int deltax, const Common::Rect &drawableTextArea) {
+	int deltax, const Common::Rect &drawableTextArea, bool cacheable) {
 
 	if (type == kTextDataNone || !_texts[type] || _layerToDraw == kDrawLayerBackground)
 		return;
@@ -982,12 +1296,41 @@ void ThemeEngine::drawDDText(TextData type, TextColor color, const Common::Rect
 		restoreBackground(dirty);
 
 	_vectorRenderer->setFgColor(_textColors[color]->r, _textColors[color]->g, _textColors[color]->b);
+
+	// Glyphs are blended with the background, so the cached text is only
+	// reused over the same background, like DrawData items are.
+	DrawDataCacheKey key;
+	byte *cachePixels = nullptr;
+
+	if (cacheable) {
+		key.area = Common::Rect(area.width(), area.height());
+		key.extendedRect = dirty;
+		key.extendedRect.translate(-area.left, -area.top);
+		key.font = _texts[type]->_fontPtr;
+		key.textColor = (_textColors[color]->r << 16) | (_textColors[color]->g << 8) | _textColors[color]->b;
+		key.text = text;
+		key.alignH = alignH;
+		key.alignV = alignV;
+		key.deltax = deltax;
+		key.ellipsis = ellipsis;
+
+		if (_drawDataCache.copy(key, _vectorRenderer->getActiveSurface(), dirty)) {
+			addDirtyRect(dirty);
+			return;
+		}
+
+		cachePixels = _drawDataCache.begin(_vectorRenderer->getActiveSurface(), dirty);
+	}
+
 #ifdef USE_FRIBIDI
 	_vectorRenderer->drawString(_texts[type]->_fontPtr, Common::convertBiDiU32String(text), area, alignH, alignV, deltax, ellipsis, dirty);
 #else
 	_vectorRenderer->drawString(_texts[type]->_fontPtr, text, area, alignH, alignV, deltax, ellipsis, dirty);
 #endif
 
+	if (cachePixels)
+		_drawDataCache.end(key, _vectorRenderer->getActiveSurface(), dirty, cachePixels);
+
 	addDirtyRect(dirty);
 }
 
@@ -1011,7 +1354,7 @@ void ThemeEngine::drawButton(const Common::Rect &r, const Common::U32String &str
 
 	drawDD(dd, r, 0, hints & WIDGET_CLEARBG);
 	drawDDText(getTextData(dd), getTextColor(dd), r, str, false, true, convertTextAlignH(_widgets[dd]->_textAlignH, false),
-	           _widgets[dd]->_textAlignV);
+	           _widgets[dd]->_textAlignV, 0, Common::Rect(0, 0, 0, 0), true);
 }
 
 void ThemeEngine::drawDropDownButton(const Common::Rect &r, uint32 dropdownWidth, const Common::U32String &str,
@@ -1047,7 +1390,7 @@ void ThemeEngine::drawDropDownButton(const Common::Rect &r, uint32 dropdownWidth
 	}
 
 	drawDDText(getTextData(dd), getTextColor(dd), textRect, str, false, true, convertTextAlignH(_widgets[dd]->_textAlignH, rtl),
-	           _widgets[dd]->_textAlignV);
+	           _widgets[dd]->_textAlignV, 0, Common::Rect(0, 0, 0, 0), true);
 }
 
 void ThemeEngine::drawLineSeparator(const Common::Rect &r) {
@@ -1090,7 +1433,7 @@ void ThemeEngine::drawCheckbox(const Common::Rect &r, int spacing, const Common:
 	if (r2.right > r2.left) {
 		TextColor color = overrideText ? GUI::TextColor::kTextColorOverride : getTextColor(dd);
 		drawDDText(getTextData(dd), color, r2, str, true, false, convertTextAlignH(_widgets[dd]->_textAlignH, rtl),
-		           _widgets[dd]->_textAlignV);
+		           _widgets[dd]->_textAlignV, 0, Common::Rect(0, 0, 0, 0), true);
 	}
 }
 
@@ -1124,7 +1467,7 @@ void ThemeEngine::drawRadiobutton(const Common::Rect &r, int spacing, const Comm
 	}
 
 	drawDDText(getTextData(dd), getTextColor(dd), r2, str, true, false, convertTextAlignH(_widgets[dd]->_textAlignH, rtl),
-		_widgets[dd]->_textAlignV);
+		_widgets[dd]->_textAlignV, 0, Common::Rect(0, 0, 0, 0), true);
 }
 
 void ThemeEngine::drawSlider(const Common::Rect &r, int width, WidgetStateInfo state, bool rtl) {
@@ -1344,7 +1687,8 @@ void ThemeEngine::drawTab(const Common::Rect &r, int tabHeight, const Common::Ar
 		Common::Rect tabRect(r.left + width, y1, r.left + width + tabWidths[current], y2);
 		drawDD(kDDTabInactive, tabRect, (vFlag << 31));
 		drawDDText(getTextData(kDDTabInactive), getTextColor(kDDTabInactive), tabRect, tabs[current], false, false,
-		           convertTextAlignH(_widgets[kDDTabInactive]->_textAlignH, rtl), _widgets[kDDTabInactive]->_textAlignV);
+		           convertTextAlignH(_widgets[kDDTabInactive]->_textAlignH, rtl), _widgets[kDDTabInactive]->_textAlignV,
+		           0, Common::Rect(0, 0, 0, 0), true);
 		width += tabWidths[current];
 	}
 
@@ -1354,7 +1698,8 @@ void ThemeEngine::drawTab(const Common::Rect &r, int tabHeight, const Common::Ar
 		const uint16 tabRight = MAX(r.right - tabRect.right, 0);
 		drawDD(kDDTabActive, tabRect, (vFlag << 31) | (tabLeft << 16) | (tabRight & 0xFFFF));
 		drawDDText(getTextData(kDDTabActive), getTextColor(kDDTabActive), tabRect, tabs[active], false, false,
-		           convertTextAlignH(_widgets[kDDTabActive]->_textAlignH, rtl), _widgets[kDDTabActive]->_textAlignV);
+		           convertTextAlignH(_widgets[kDDTabActive]->_textAlignH, rtl), _widgets[kDDTabActive]->_textAlignV,
+		           0, Common::Rect(0, 0, 0, 0), true);
 	}
 }
 
@@ -1581,7 +1926,7 @@ void ThemeEngine::applyScreenShading(ShadingStyle style) {
 
 bool ThemeEngine::createCursor(const Common::String &filename, int hotspotX, int hotspotY) {
 	// Try to locate the specified file among all loaded bitmaps
-	const Graphics::ManagedSurface *cursor = _bitmaps[filename];
+	const Graphics::ManagedSurface *cursor = getImageSurface(filename);
 	if (!cursor)
 		return false;
 
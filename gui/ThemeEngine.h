@@ -35,11 +35,17 @@
 #include "graphics/font.h"
 #include "graphics/pixelformat.h"
 
+#include "gui/ThemeDrawCache.h"
+
 
 #define SCUMMVM_THEME_VERSION_STR "SCUMMVM_STX0.9.20"
 
 class OSystem;
 
+namespace Common {
+class MemoryWriteStreamDynamic;
+}
+
 namespace Graphics {
 struct DrawStep;
 class VectorRenderer;
@@ -210,6 +216,17 @@ class ThemeEngine {
 protected:
 	typedef Common::HashMap<Common::String, Graphics::ManagedSurface *> ImagesMap;
 
+	/**
+	 * A bitmap declared by the theme. Bitmaps are only decoded, or
+	 * rasterized for scalable ones, when they are first used.
+	 */
+	struct BitmapSource {
+		Common::String scalableFile;
+		int width, height;
+	};
+
+	typedef Common::HashMap<Common::String, BitmapSource> BitmapSourcesMap;
+
 	friend class GUI::Dialog;
 	friend class GUI::GuiObject;
 
@@ -340,6 +357,13 @@ public:
 	/** Constant value to expand dirty rectangles, to make sure they are fully copied */
 	static const int kDirtyRectangleThreshold = 1;
 
+	/** Maximum amount of memory used by the rendered DrawData cache, in bytes. */
+#ifdef REDUCE_MEMORY_USAGE
+	static const uint32 kDrawDataCacheMaxSize = 2 * 1024 * 1024;
+#else
+	static const uint32 kDrawDataCacheMaxSize = 16 * 1024 * 1024;
+#endif
+
 	struct Renderer {
 		const char *name;
 		const char *shortname;
@@ -639,9 +663,11 @@ public:
 	inline bool supportsImages() const { return true; }
 	inline bool ownCursor() const { return _useCursor; }
 
-	Graphics::ManagedSurface *getImageSurface(const Common::String &name) const {
-		return _bitmaps.contains(name) ? _bitmaps[name] : 0;
-	}
+	/**
+	 * Returns the bitmap with the given name, loading it first if this is
+	 * the first time it is used. May return nullptr.
+	 */
+	Graphics::ManagedSurface *getImageSurface(const Common::String &name);
 
 	/**
 	 * Interface for the Theme Parser: Creates a new cursor by loading the given
@@ -688,6 +714,40 @@ protected:
 	 */
 	void unloadTheme();
 
+	/**
+	 * Frees all the DrawData, fonts and colors defined by the theme,
+	 * even if it only was partially loaded.
+	 */
+	void clearThemeData();
+
+	/**
+	 * Compiled theme handling functions.
+	 *
+	 * The STX files of a theme are recorded in the compact binary form of
+	 * Common::XMLParser while they are parsed. The result is kept for
+	 * refresh() and stored next to the configuration file, so the next time
+	 * the theme is loaded the XML does not need to be tokenized again. The
+	 * key identifies the version of the theme data the cache was made from.
+	 */
+	bool loadCompiledTheme(const Common::String &key);
+	void storeCompiledTheme(const Common::String &key, Common::MemoryWriteStreamDynamic &data);
+	Common::String getCompiledThemeFilename() const;
+	Common::FSNode getCompiledThemeNode() const;
+
+	/**
+	 * Identifies the version of the theme files from their sizes and
+	 * modification times, without reading them.
+	 *
+	 * @return the stamp, or an empty string if it could not be determined.
+	 */
+	Common::String getThemeFilesStamp(const Common::ArchiveMemberList &members) const;
+
+	/** Decodes a bitmap declared with addBitmap() */
+	Graphics::ManagedSurface *loadBitmap(const Common::String &filename, const BitmapSource &source);
+
+	/** Releases all loaded bitmaps */
+	void clearBitmaps();
+
 	/**
 	 * Unload the language specific font loaded via loadExtraFont()
 	*/
@@ -711,12 +771,24 @@ protected:
 	 * are actually drawn to the active surface.
 	 *
 	 * These functions are called from all the Widget drawing methods.
+	 * Texts are only kept in the rendered DrawData cache when cacheable
+	 * is set, which is done for the labels of buttons, tabs and the like.
 	 */
 	void drawDD(DrawData type, const Common::Rect &r, uint32 dynamic = 0, bool forceRestore = false);
 	void drawDDText(TextData type, TextColor color, const Common::Rect &r, const Common::U32String &text, bool restoreBg,
 	                bool elipsis, Graphics::TextAlign alignH = Graphics::kTextAlignLeft,
 	                TextAlignVertical alignV = kTextAlignVTop, int deltax = 0,
-	                const Common::Rect &drawableTextArea = Common::Rect(0, 0, 0, 0));
+	                const Common::Rect &drawableTextArea = Common::Rect(0, 0, 0, 0), bool cacheable = false);
+
+	/**
+	 * Copies a widget from the rendered DrawData cache, see ThemeDrawCache.
+	 *
+	 * Widgets whose DrawSteps are fully described by the theme, and the
+	 * texts of buttons, tabs and other static widget labels, are cached once
+	 * rendered. Texts which change while they are shown, such as edit fields
+	 * and list entries, are always drawn.
+	 */
+	bool drawCachedDD(const DrawDataCacheKey &key, const WidgetDrawData *drawData, const Common::Rect &area, const Common::Rect &extendedRect, uint32 dynamic);
 
 	/**
 	 * DEBUG: Draws a white square and writes some text next to it.
@@ -801,6 +873,15 @@ protected:
 	Common::Array<LangExtraFont> _langExtraFonts;
 
 	ImagesMap _bitmaps;
+	BitmapSourcesMap _bitmapSources;
+
+	/** Compiled form of the loaded theme, see loadCompiledTheme() */
+	Common::String _compiledThemeKey;
+	Common::Array<byte> _compiledTheme;
+
+	/** Rendered DrawData items and widget texts. */
+	ThemeDrawCache _drawDataCache;
+
 	Graphics::PixelFormat _overlayFormat;
 	Graphics::PixelFormat _cursorFormat;
 
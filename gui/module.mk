@@ -27,6 +27,7 @@ MODULE_OBJS := \
 	shaderbrowser-dialog.o \
 	textviewer.o \
 	themebrowser.o \
+	ThemeDrawCache.o \
 	ThemeEngine.o \
 	ThemeEval.o \
 	ThemeLayout.o \
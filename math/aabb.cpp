@@ -71,10 +71,9 @@ void AABB::transform(const Math::Matrix4 &matrix) {
 	verts[6].set(min.x(), max.y(), max.z());
 	verts[7].set(max.x(), max.y(), max.z());
 
-	for (int i = 0; i < 8; ++i) {
-		matrix.transform(&verts[i], true);
+	matrix.transform(verts, verts, 8, true);
+	for (int i = 0; i < 8; ++i)
 		expand(verts[i]);
-	}
 }
 
 bool AABB::collides(const AABB &aabb) const {
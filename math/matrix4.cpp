@@ -20,6 +20,7 @@
  */
 
 #include "math/matrix4.h"
+#include "math/simd.h"
 #include "math/vector4d.h"
 #include "math/squarematrix.h"
 
@@ -33,16 +34,115 @@ Matrix<4, 4>::Matrix(const MatrixBase<4, 4> &m) :
 	MatrixType<4, 4>(m), Rotation3D<Matrix4>() {
 }
 
+#if defined(MATH_SIMD_SSE2)
+
+// Loads the columns of a row major matrix
+static inline void loadColumns(const float *m, __m128 &c0, __m128 &c1, __m128 &c2, __m128 &c3) {
+	c0 = _mm_loadu_ps(m);
+	c1 = _mm_loadu_ps(m + 4);
+	c2 = _mm_loadu_ps(m + 8);
+	c3 = _mm_loadu_ps(m + 12);
+	_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+}
+
+static inline void storeVector3(float *dst, __m128 r) {
+	_mm_storel_pi((__m64 *)dst, r);
+	_mm_store_ss(dst + 2, _mm_movehl_ps(r, r));
+}
+
+#endif
+
+Matrix<4, 4> Matrix<4, 4>::operator*(const Matrix<4, 4> &m2) const {
+	Matrix<4, 4> result;
+	const float *d1 = getData();
+	const float *d2 = m2.getData();
+	float *r = result.getData();
+
+	// The products are summed in the same order in all versions, so the
+	// results do not depend on which one is used
+#if defined(MATH_SIMD_SSE2)
+	const __m128 b0 = _mm_loadu_ps(d2);
+	const __m128 b1 = _mm_loadu_ps(d2 + 4);
+	const __m128 b2 = _mm_loadu_ps(d2 + 8);
+	const __m128 b3 = _mm_loadu_ps(d2 + 12);
+
+	for (int i = 0; i < 16; i += 4) {
+		__m128 row = _mm_mul_ps(_mm_set1_ps(d1[i + 0]), b0);
+		row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(d1[i + 1]), b1));
+		row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(d1[i + 2]), b2));
+		row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(d1[i + 3]), b3));
+		_mm_storeu_ps(r + i, row);
+	}
+#else
+	for (int i = 0; i < 16; i += 4) {
+		for (int j = 0; j < 4; ++j) {
+			r[i + j] = (d1[i + 0] * d2[j + 0]) +
+			           (d1[i + 1] * d2[j + 4]) +
+			           (d1[i + 2] * d2[j + 8]) +
+			           (d1[i + 3] * d2[j + 12]);
+		}
+	}
+#endif
+
+	return result;
+}
+
 void Matrix<4, 4>::transform(Vector3d *v, bool trans) const {
-	Vector4d m;
-	m(0, 0) = v->x();
-	m(1, 0) = v->y();
-	m(2, 0) = v->z();
-	m(3, 0) = (trans ? 1.f : 0.f);
+	transform(v, v, 1, trans);
+}
+
+void Matrix<4, 4>::transform(const Vector3d *src, Vector3d *dst, uint count, bool trans) const {
+	const float *m = getData();
+
+#if defined(MATH_SIMD_SSE2)
+	__m128 c0, c1, c2, c3;
+	loadColumns(m, c0, c1, c2, c3);
 
-	m = *this * m;
+	for (uint i = 0; i < count; i++) {
+		const float *s = src[i].getData();
+		__m128 r = _mm_mul_ps(_mm_set1_ps(s[0]), c0);
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(s[1]), c1));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(s[2]), c2));
+		if (trans)
+			r = _mm_add_ps(r, c3);
+		storeVector3(dst[i].getData(), r);
+	}
+#else
+	const float w = trans ? 1.f : 0.f;
 
-	v->set(m(0, 0), m(1, 0), m(2, 0));
+	for (uint i = 0; i < count; i++) {
+		const float x = src[i].x(), y = src[i].y(), z = src[i].z();
+		dst[i].set(m[0] * x + m[1] * y + m[2] * z + m[3] * w,
+		           m[4] * x + m[5] * y + m[6] * z + m[7] * w,
+		           m[8] * x + m[9] * y + m[10] * z + m[11] * w);
+	}
+#endif
+}
+
+void Matrix<4, 4>::transform(const Vector4d *src, Vector4d *dst, uint count) const {
+	const float *m = getData();
+
+#if defined(MATH_SIMD_SSE2)
+	__m128 c0, c1, c2, c3;
+	loadColumns(m, c0, c1, c2, c3);
+
+	for (uint i = 0; i < count; i++) {
+		const float *s = src[i].getData();
+		__m128 r = _mm_mul_ps(_mm_set1_ps(s[0]), c0);
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(s[1]), c1));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(s[2]), c2));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(s[3]), c3));
+		_mm_storeu_ps(dst[i].getData(), r);
+	}
+#else
+	for (uint i = 0; i < count; i++) {
+		const float *s = src[i].getData();
+		float r[4];
+		for (int j = 0; j < 4; j++)
+			r[j] = m[j * 4 + 0] * s[0] + m[j * 4 + 1] * s[1] + m[j * 4 + 2] * s[2] + m[j * 4 + 3] * s[3];
+		dst[i].set(r[0], r[1], r[2], r[3]);
+	}
+#endif
 }
 
 Vector3d Matrix<4, 4>::getPosition() const {
@@ -114,6 +214,237 @@ void Matrix<4, 4>::invertAffineOrthonormal() {
 	setPosition(position);
 }
 
+#if defined(MATH_SIMD_SSE2)
+
+// Cramer's rule on the 2x2 sub-determinants, after Intel's
+// "Streaming SIMD Extensions - Inverse of 4x4 Matrix" (AP-928).
+// The inverse of the transpose is the transpose of the inverse, so
+// the layout of the source does not matter.
+static bool inverseSSE2(float *src) {
+	__m128 minor0, minor1, minor2, minor3;
+	__m128 row0, row1, row2, row3;
+	__m128 det, tmp1;
+
+	tmp1 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)(src)), (const __m64 *)(src + 4));
+	row1 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)(src + 8)), (const __m64 *)(src + 12));
+	row0 = _mm_shuffle_ps(tmp1, row1, 0x88);
+	row1 = _mm_shuffle_ps(row1, tmp1, 0xDD);
+	tmp1 = _mm_loadh_pi(_mm_loadl_pi(tmp1, (const __m64 *)(src + 2)), (const __m64 *)(src + 6));
+	row3 = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)(src + 10)), (const __m64 *)(src + 14));
+	row2 = _mm_shuffle_ps(tmp1, row3, 0x88);
+	row3 = _mm_shuffle_ps(row3, tmp1, 0xDD);
+
+	tmp1 = _mm_mul_ps(row2, row3);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+	minor0 = _mm_mul_ps(row1, tmp1);
+	minor1 = _mm_mul_ps(row0, tmp1);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+	minor0 = _mm_sub_ps(_mm_mul_ps(row1, tmp1), minor0);
+	minor1 = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor1);
+	minor1 = _mm_shuffle_ps(minor1, minor1, 0x4E);
+
+	tmp1 = _mm_mul_ps(row1, row2);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+	minor0 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor0);
+	minor3 = _mm_mul_ps(row0, tmp1);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+	minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row3, tmp1));
+	minor3 = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor3);
+	minor3 = _mm_shuffle_ps(minor3, minor3, 0x4E);
+
+	tmp1 = _mm_mul_ps(_mm_shuffle_ps(row1, row1, 0x4E), row3);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+	row2 = _mm_shuffle_ps(row2, row2, 0x4E);
+	minor0 = _mm_add_ps(_mm_mul_ps(row2, tmp1), minor0);
+	minor2 = _mm_mul_ps(row0, tmp1);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+	minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row2, tmp1));
+	minor2 = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor2);
+	minor2 = _mm_shuffle_ps(minor2, minor2, 0x4E);
+
+	tmp1 = _mm_mul_ps(row0, row1);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+	minor2 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor2);
+	minor3 = _mm_sub_ps(_mm_mul_ps(row2, tmp1), minor3);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+	minor2 = _mm_sub_ps(_mm_mul_ps(row3, tmp1), minor2);
+	minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row2, tmp1));
+
+	tmp1 = _mm_mul_ps(row0, row3);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+	minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row2, tmp1));
+	minor2 = _mm_add_ps(_mm_mul_ps(row1, tmp1), minor2);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+	minor1 = _mm_add_ps(_mm_mul_ps(row2, tmp1), minor1);
+	minor2 = _mm_sub_ps(minor2, _mm_mul_ps(row1, tmp1));
+
+	tmp1 = _mm_mul_ps(row0, row2);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+	minor1 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor1);
+	minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row1, tmp1));
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+	minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row3, tmp1));
+	minor3 = _mm_add_ps(_mm_mul_ps(row1, tmp1), minor3);
+
+	det = _mm_mul_ps(row0, minor0);
+	det = _mm_add_ps(_mm_shuffle_ps(det, det, 0x4E), det);
+	det = _mm_add_ss(_mm_shuffle_ps(det, det, 0xB1), det);
+
+	// A true division rather than the reciprocal estimate of the original,
+	// which is only accurate to 12 bits
+	float d = _mm_cvtss_f32(det);
+	if (d == 0)
+		return false;
+	det = _mm_set1_ps((float)(1.0 / d));
+
+	_mm_storel_pi((__m64 *)(src), _mm_mul_ps(det, minor0));
+	_mm_storeh_pi((__m64 *)(src + 2), _mm_mul_ps(det, minor0));
+	_mm_storel_pi((__m64 *)(src + 4), _mm_mul_ps(det, minor1));
+	_mm_storeh_pi((__m64 *)(src + 6), _mm_mul_ps(det, minor1));
+	_mm_storel_pi((__m64 *)(src + 8), _mm_mul_ps(det, minor2));
+	_mm_storeh_pi((__m64 *)(src + 10), _mm_mul_ps(det, minor2));
+	_mm_storel_pi((__m64 *)(src + 12), _mm_mul_ps(det, minor3));
+	_mm_storeh_pi((__m64 *)(src + 14), _mm_mul_ps(det, minor3));
+	return true;
+}
+
+#endif
+
+bool Matrix<4, 4>::inverse() {
+#if defined(MATH_SIMD_SSE2)
+	return inverseSSE2(getData());
+#else
+	Matrix<4, 4> invMatrix;
+	float *inv = invMatrix.getData();
+	float *m = getData();
+
+	inv[0] = m[5]  * m[10] * m[15] -
+	         m[5]  * m[11] * m[14] -
+	         m[9]  * m[6]  * m[15] +
+	         m[9]  * m[7]  * m[14] +
+	         m[13] * m[6]  * m[11] -
+	         m[13] * m[7]  * m[10];
+
+	inv[4] = -m[4]  * m[10] * m[15] +
+	          m[4]  * m[11] * m[14] +
+	          m[8]  * m[6]  * m[15] -
+	          m[8]  * m[7]  * m[14] -
+	          m[12] * m[6]  * m[11] +
+	          m[12] * m[7]  * m[10];
+
+	inv[8] = m[4]  * m[9]  * m[15] -
+	         m[4]  * m[11] * m[13] -
+	         m[8]  * m[5]  * m[15] +
+	         m[8]  * m[7]  * m[13] +
+	         m[12] * m[5]  * m[11] -
+	         m[12] * m[7]  * m[9];
+
+	inv[12] = -m[4]  * m[9]  * m[14] +
+	           m[4]  * m[10] * m[13] +
+	           m[8]  * m[5]  * m[14] -
+	           m[8]  * m[6]  * m[13] -
+	           m[12] * m[5]  * m[10] +
+	           m[12] * m[6]  * m[9];
+
+	inv[1] = -m[1]  * m[10] * m[15] +
+	          m[1]  * m[11] * m[14] +
+	          m[9]  * m[2]  * m[15] -
+	          m[9]  * m[3]  * m[14] -
+	          m[13] * m[2]  * m[11] +
+	          m[13] * m[3]  * m[10];
+
+	inv[5] = m[0]  * m[10] * m[15] -
+	         m[0]  * m[11] * m[14] -
+	         m[8]  * m[2]  * m[15] +
+	         m[8]  * m[3]  * m[14] +
+	         m[12] * m[2]  * m[11] -
+	         m[12] * m[3]  * m[10];
+
+	inv[9] = -m[0]  * m[9]  * m[15] +
+	          m[0]  * m[11] * m[13] +
+	          m[8]  * m[1]  * m[15] -
+	          m[8]  * m[3]  * m[13] -
+	          m[12] * m[1]  * m[11] +
+	          m[12] * m[3]  * m[9];
+
+	inv[13] = m[0]  * m[9]  * m[14] -
+	          m[0]  * m[10] * m[13] -
+	          m[8]  * m[1]  * m[14] +
+	          m[8]  * m[2]  * m[13] +
+	          m[12] * m[1]  * m[10] -
+	          m[12] * m[2]  * m[9];
+
+	inv[2] = m[1]  * m[6] * m[15] -
+	         m[1]  * m[7] * m[14] -
+	         m[5]  * m[2] * m[15] +
+	         m[5]  * m[3] * m[14] +
+	         m[13] * m[2] * m[7] -
+	         m[13] * m[3] * m[6];
+
+	inv[6] = -m[0]  * m[6] * m[15] +
+	          m[0]  * m[7] * m[14] +
+	          m[4]  * m[2] * m[15] -
+	          m[4]  * m[3] * m[14] -
+	          m[12] * m[2] * m[7] +
+	          m[12] * m[3] * m[6];
+
+	inv[10] = m[0]  * m[5] * m[15] -
+	          m[0]  * m[7] * m[13] -
+	          m[4]  * m[1] * m[15] +
+	          m[4]  * m[3] * m[13] +
+	          m[12] * m[1] * m[7] -
+	          m[12] * m[3] * m[5];
+
+	inv[14] = -m[0]  * m[5] * m[14] +
+	           m[0]  * m[6] * m[13] +
+	           m[4]  * m[1] * m[14] -
+	           m[4]  * m[2] * m[13] -
+	           m[12] * m[1] * m[6] +
+	           m[12] * m[2] * m[5];
+
+	inv[3] = -m[1] * m[6] * m[11] +
+	          m[1] * m[7] * m[10] +
+	          m[5] * m[2] * m[11] -
+	          m[5] * m[3] * m[10] -
+	          m[9] * m[2] * m[7] +
+	          m[9] * m[3] * m[6];
+
+	inv[7] = m[0] * m[6] * m[11] -
+	         m[0] * m[7] * m[10] -
+	         m[4] * m[2] * m[11] +
+	         m[4] * m[3] * m[10] +
+	         m[8] * m[2] * m[7] -
+	         m[8] * m[3] * m[6];
+
+	inv[11] = -m[0] * m[5] * m[11] +
+	           m[0] * m[7] * m[9] +
+	           m[4] * m[1] * m[11] -
+	           m[4] * m[3] * m[9] -
+	           m[8] * m[1] * m[7] +
+	           m[8] * m[3] * m[5];
+
+	inv[15] = m[0] * m[5] * m[10] -
+	          m[0] * m[6] * m[9] -
+	          m[4] * m[1] * m[10] +
+	          m[4] * m[2] * m[9] +
+	          m[8] * m[1] * m[6] -
+	          m[8] * m[2] * m[5];
+
+	float det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+
+	if (det == 0)
+		return false;
+
+	det = 1.0 / det;
+
+	for (int i = 0; i < 16; i++) {
+		m[i] = inv[i] * det;
+	}
+
+	return true;
+#endif
+}
+
 void swap(float &a, float &b);
 
 void Matrix<4, 4>::transpose() {
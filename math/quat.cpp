@@ -38,6 +38,7 @@
 #include "common/streamdebug.h"
 
 #include "math/quat.h"
+#include "math/simd.h"
 #include "math/utils.h"
 
 namespace Math {
@@ -99,7 +100,13 @@ Quaternion Quaternion::slerpQuat(const Quaternion& to, const float t) const {
 	}
 
 	// Apply the interpolation
+#if defined(MATH_SIMD_SSE2)
+	__m128 blend = _mm_mul_ps(_mm_loadu_ps(getData()), _mm_set1_ps(scale0));
+	blend = _mm_add_ps(blend, _mm_mul_ps(_mm_loadu_ps(to.getData()), _mm_set1_ps(scale1)));
+	_mm_storeu_ps(dst.getData(), blend);
+#else
 	dst = (*this * scale0) + (to * scale1);
+#endif
 	return dst;
 }
 
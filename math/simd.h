@@ -0,0 +1,41 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef MATH_SIMD_H
+#define MATH_SIMD_H
+
+#include "common/scummsys.h"
+
+// The math kernels are only vectorized when the compiler already targets
+// the instruction set (always the case on x86_64), so unlike the blitters
+// they do not need a runtime CPU check. Other targets use the scalar code.
+#if defined(SCUMMVM_SSE2) && defined(__SSE2__)
+#define MATH_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+// Only the Matrix4 and Quaternion kernels use these. Vector3d and the generic
+// Matrix<r, c> templates keep their scalar loops: a three float vector fills
+// a register only partially and would need masked loads and stores, and the
+// fixed size template loops are already unrolled by the compiler. Code
+// transforming many vectors should use the batched Matrix4::transform().
+
+#endif
@@ -31,6 +31,7 @@
 
 namespace Math {
 
+// Not vectorized, see math/simd.h
 typedef Matrix<3, 1> Vector3d;
 
 template<>
@@ -0,0 +1,117 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/formats/xmlparser.h"
+#include "common/memstream.h"
+#include "common/system.h"
+
+#include "../null_osystem.h"
+
+class TestXMLParser : public Common::XMLParser {
+public:
+	Common::String _log;
+	bool _failClosingItems;
+
+	TestXMLParser() : _failClosingItems(false) {}
+
+protected:
+	CUSTOM_XML_PARSER(TestXMLParser) {
+		XML_KEY(menu)
+			XML_PROP(name, true)
+			XML_KEY(item)
+				XML_PROP(id, true)
+				XML_PROP(label, false)
+			KEY_END()
+		KEY_END()
+	} PARSER_END()
+
+	bool parserCallback_menu(ParserNode *node) {
+		_log += "menu(" + node->values["name"] + ")";
+		return true;
+	}
+
+	bool parserCallback_item(ParserNode *node) {
+		_log += "item(" + node->values["id"] + "," + node->values["label"] + ")";
+		return true;
+	}
+
+	bool closedKeyCallback(ParserNode *node) override {
+		_log += "/" + node->name;
+		return !_failClosingItems || node->name != "item";
+	}
+};
+
+class XMLParserTestSuite : public CxxTest::TestSuite {
+public:
+	void test_compiled_replay() {
+		static const char xml[] =
+			"<?xml version = '1.0'?>"
+			"<!-- comment -->"
+			"<menu name = 'main'>"
+			"  <item id = '1' label = 'Start game'/>"
+			"  <item id = '2'></item>"
+			"</menu>";
+
+		TestXMLParser parser;
+		Common::MemoryWriteStreamDynamic compiled(DisposeAfterUse::YES);
+
+		parser.setCompiledOutput(&compiled);
+		TS_ASSERT(parser.loadBuffer((const byte *)xml, sizeof(xml) - 1));
+		TS_ASSERT(parser.parse());
+		parser.close();
+		parser.setCompiledOutput(nullptr);
+
+		Common::String expected = parser._log;
+		TS_ASSERT_EQUALS(expected, "/xmlmenu(main)item(1,Start game)/itemitem(2,)/item/menu");
+
+		parser._log.clear();
+		Common::MemoryReadStream in(compiled.getData(), compiled.size());
+		TS_ASSERT(parser.parseCompiled(&in));
+		TS_ASSERT_EQUALS(parser._log, expected);
+	}
+
+	void test_compiled_validation() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		// Errors are logged through g_system
+		Common::install_null_g_system();
+
+		// Layout errors are still reported when replaying
+		static const char xml[] = "<?xml version = '1.0'?><menu name = 'main'><item label = 'x'/></menu>";
+
+		TestXMLParser parser;
+		Common::MemoryWriteStreamDynamic compiled(DisposeAfterUse::YES);
+
+		parser.setCompiledOutput(&compiled);
+		TS_ASSERT(parser.loadBuffer((const byte *)xml, sizeof(xml) - 1));
+		TS_ASSERT(!parser.parse());
+		parser.close();
+		parser.setCompiledOutput(nullptr);
+
+		Common::MemoryReadStream in(compiled.getData(), compiled.size());
+		TS_ASSERT(!parser.parseCompiled(&in));
+#endif
+	}
+
+	void test_compiled_callback_failure() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		// Errors are logged through g_system
+		Common::install_null_g_system();
+
+		static const char xml[] = "<?xml version = '1.0'?><menu name = 'main'><item id = '1'/></menu>";
+
+		TestXMLParser parser;
+		Common::MemoryWriteStreamDynamic compiled(DisposeAfterUse::YES);
+
+		parser.setCompiledOutput(&compiled);
+		TS_ASSERT(parser.loadBuffer((const byte *)xml, sizeof(xml) - 1));
+		TS_ASSERT(parser.parse());
+		parser.close();
+		parser.setCompiledOutput(nullptr);
+
+		// A callback failing on a self closed key fails the replay, so that
+		// the caller can fall back to the original document
+		parser._failClosingItems = true;
+		Common::MemoryReadStream in(compiled.getData(), compiled.size());
+		TS_ASSERT(!parser.parseCompiled(&in));
+#endif
+	}
+};
@@ -0,0 +1,147 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/ptr.h"
+#include "common/random.h"
+#include "common/system.h"
+#include "common/util.h"
+#include "graphics/surface.h"
+
+#include "engines/bladerunner/slice_span.h"
+
+#include "../../null_osystem.h"
+
+/**
+ * Test suite for the slice span fill in engines/bladerunner/slice_span.h
+ *
+ * SliceRenderer::drawSlice writes whole spans through a row pointer on
+ * surfaces which are at least as wide as the original game. These tests draw
+ * synthetic slices both that way and with the per pixel loop drawSlice used
+ * before, and check that the pixels and the z-buffer come out the same.
+ */
+class SliceSpanTestSuite : public CxxTest::TestSuite {
+	public:
+	static const int kWidth = 640;
+	static const int kLines = 8;
+
+	Common::ScopedPtr<Common::RandomSource> _random;
+
+	/* Restart the random data from a fixed seed, so every run is the same */
+	void seedRandom(uint32 seed) {
+		if (!_random) {
+#if NULL_OSYSTEM_IS_AVAILABLE
+			// RandomSource needs g_system
+			if (!g_system)
+				Common::install_null_g_system();
+#endif
+			_random.reset(new Common::RandomSource("slicespan"));
+		}
+		_random->setSeed(seed);
+	}
+
+	/* A projected slice vertex, as drawSlice computes it from the frame data */
+	struct Vertex {
+		int x;
+		int z;
+		uint32 color;
+	};
+
+	/* Makes the polygons of one slice line, in the order drawSlice reads them */
+	void makeSlice(Common::Array<Common::Array<Vertex> > &polygons) {
+		polygons.resize(1 + _random->getRandomNumber(5));
+		for (uint i = 0; i < polygons.size(); ++i) {
+			polygons[i].resize(_random->getRandomNumber(40));
+			for (uint j = 0; j < polygons[i].size(); ++j) {
+				Vertex &v = polygons[i][j];
+				v.x = _random->getRandomNumber(kWidth);
+				// Out of range depths are skipped by drawSlice
+				v.z = (int)_random->getRandomNumber(70000) - 1000;
+				v.color = _random->getRandomNumber(0xFFFFFFFF);
+			}
+		}
+	}
+
+	/* The line loop of drawSlice after the vertices are projected */
+	void drawLine(const Common::Array<Common::Array<Vertex> > &polygons, bool spans, int y, Graphics::Surface &surface, uint16 *zbufferLine) {
+		const bool directSpans = spans && surface.w >= kWidth;
+		byte *rowPtr = (byte *)surface.getBasePtr(0, CLIP(y, 0, surface.h - 1));
+
+		for (uint i = 0; i < polygons.size(); ++i) {
+			const Common::Array<Vertex> &polygon = polygons[i];
+			if (polygon.empty())
+				continue;
+
+			int previousVertexX = polygon.back().x;
+			for (uint j = 0; j < polygon.size(); ++j) {
+				int vertexX = polygon[j].x;
+				int vertexZ = polygon[j].z;
+
+				if (vertexX > previousVertexX && vertexZ >= 0 && vertexZ < 65536) {
+					uint32 outColor = polygon[j].color;
+
+					if (!directSpans || !BladeRunner::drawSliceSpan(rowPtr, surface.format.bytesPerPixel, zbufferLine, previousVertexX, vertexX, (uint16)vertexZ, outColor)) {
+						for (int x = previousVertexX; x != vertexX; ++x) {
+							if (vertexZ < zbufferLine[x]) {
+								zbufferLine[x] = (uint16)vertexZ;
+
+								void *dstPtr = surface.getBasePtr(CLIP(x, 0, surface.w - 1), CLIP(y, 0, surface.h - 1));
+								switch (surface.format.bytesPerPixel) {
+								case 1:
+									*(uint8 *)dstPtr = (uint8)outColor;
+									break;
+								case 2:
+									*(uint16 *)dstPtr = (uint16)outColor;
+									break;
+								case 4:
+									*(uint32 *)dstPtr = (uint32)outColor;
+									break;
+								default:
+									break;
+								}
+							}
+						}
+					}
+				}
+				previousVertexX = vertexX;
+			}
+		}
+	}
+
+	/* Draws the same slices both ways onto a surface of the given size */
+	void compareSlices(int width, const Graphics::PixelFormat &format) {
+		Graphics::Surface expected, actual;
+		expected.create(width, kLines, format);
+		actual.create(width, kLines, format);
+
+		// Spans reach up to the original game width, whatever the surface
+		uint16 expectedZ[kWidth + 1];
+		uint16 actualZ[kWidth + 1];
+
+		for (int y = 0; y < kLines; ++y) {
+			for (int x = 0; x <= kWidth; ++x)
+				expectedZ[x] = actualZ[x] = 0xFFFF;
+
+			// Each line gets a few slices on top of each other, like a model
+			for (int slice = 0; slice < 4; ++slice) {
+				Common::Array<Common::Array<Vertex> > polygons;
+				makeSlice(polygons);
+				drawLine(polygons, false, y, expected, expectedZ);
+				drawLine(polygons, true, y, actual, actualZ);
+			}
+
+			TS_ASSERT_EQUALS(memcmp(expectedZ, actualZ, sizeof(expectedZ)), 0);
+		}
+
+		for (int y = 0; y < kLines; ++y)
+			TS_ASSERT_EQUALS(memcmp(expected.getBasePtr(0, y), actual.getBasePtr(0, y), width * format.bytesPerPixel), 0);
+
+		expected.free();
+		actual.free();
+	}
+
+	void test_spans_match_per_pixel_fill() {
+		seedRandom(0x5e1ce);
+		compareSlices(kWidth, Graphics::PixelFormat::createFormatCLUT8());
+		compareSlices(kWidth, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+		compareSlices(kWidth, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+	}
+};
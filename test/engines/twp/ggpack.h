@@ -0,0 +1,235 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/debug.h"
+#include "common/formats/json.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/random.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+
+#include "engines/twp/ggpack.h"
+
+#include "../../null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+/**
+ * Test suite for the ggpack decoding in engines/twp/ggpack.h
+ *
+ * XorStream decodes a word at a time with a precomputed key stream. These
+ * tests compare it with the original byte at a time loop, and read the
+ * entries of a pack built in memory.
+ */
+class GGPackTestSuite : public CxxTest::TestSuite {
+	public:
+	GGPackTestSuite() {
+		Common::Array<int> magicBytes;
+		for (int i = 0; i < 16; i++)
+			magicBytes.push_back(0x4F + i * 0x1D);
+		_key = Twp::XorKey(magicBytes, 0x6D);
+	}
+
+	Common::ScopedPtr<Common::RandomSource> _random;
+
+	/* Restart the random data from a fixed seed, so every run is the same */
+	void seedRandom(uint32 seed) {
+		if (!_random) {
+#if NULL_OSYSTEM_IS_AVAILABLE
+			// RandomSource needs g_system
+			if (!g_system)
+				Common::install_null_g_system();
+#endif
+			_random.reset(new Common::RandomSource("ggpack"));
+		}
+		_random->setSeed(seed);
+	}
+	Twp::XorKey _key;
+
+	uint32 nextRandom() {
+		return _random->getRandomNumber(0xFFFF);
+	}
+
+	/* The decoder as it was before, for a single read */
+	void referenceRead(byte *buf, uint32 size, int p, int &previous) {
+		for (size_t i = 0; i < size; i++) {
+			int x = (char)buf[i] ^ _key.magicBytes[p & 0x0F] ^ (i * _key.multiplier);
+			buf[i] = (byte)(x ^ previous);
+			previous = x;
+			p++;
+		}
+	}
+
+	/* The inverse of reading the whole buffer at once */
+	void encrypt(byte *buf, uint32 size) {
+		byte previous = size & 0xFF;
+		for (uint32 i = 0; i < size; i++) {
+			byte x = buf[i] ^ previous;
+			buf[i] = x ^ (byte)(_key.magicBytes[i & 0x0F] ^ (i * _key.multiplier));
+			previous = x;
+		}
+	}
+
+	void checkChunks(const Common::Array<byte> &data, uint32 chunk) {
+		Common::Array<byte> expected(data), decoded(data.size());
+		int previous = data.size() & 0xFF;
+		for (uint32 pos = 0; pos < data.size(); pos += chunk)
+			referenceRead(expected.data() + pos, MIN<uint32>(chunk, data.size() - pos), pos, previous);
+
+		Common::MemoryReadStream in(data.data(), data.size());
+		Twp::XorStream xs;
+		xs.open(&in, data.size(), _key);
+		for (uint32 pos = 0; pos < data.size(); pos += chunk)
+			xs.read(decoded.data() + pos, MIN<uint32>(chunk, data.size() - pos));
+
+		TS_ASSERT(expected == decoded);
+	}
+
+	Common::Array<byte> makeEntry(uint32 size) {
+		Common::Array<byte> entry(size);
+		for (uint32 i = 0; i < size; i++)
+			entry[i] = nextRandom() & 0xFF;
+		return entry;
+	}
+
+	/* A pack with the entry table at the end, like the game's */
+	void buildPack(const Common::Array<Common::Array<byte> > &entries, Common::MemoryWriteStreamDynamic &pack) {
+		pack.writeUint32LE(0);
+		pack.writeUint32LE(0);
+
+		Common::JSONArray files;
+		for (uint i = 0; i < entries.size(); i++) {
+			Common::Array<byte> data(entries[i]);
+			encrypt(data.data(), data.size());
+
+			Common::JSONObject file;
+			file["filename"] = new Common::JSONValue(Common::String::format("entry%u.bin", i));
+			file["offset"] = new Common::JSONValue((long long int)pack.pos());
+			file["size"] = new Common::JSONValue((long long int)data.size());
+			files.push_back(new Common::JSONValue(file));
+			pack.write(data.data(), data.size());
+		}
+
+		Common::JSONObject root;
+		root["files"] = new Common::JSONValue(files);
+		Common::JSONValue table(root);
+
+		Common::MemoryWriteStreamDynamic tableStream(DisposeAfterUse::YES);
+		Twp::GGHashMapEncoder encoder;
+		encoder.open(&tableStream);
+		encoder.write(table.asObject());
+
+		Common::Array<byte> tableData(tableStream.getData(), tableStream.size());
+		encrypt(tableData.data(), tableData.size());
+
+		uint32 tableOffset = pack.pos();
+		pack.write(tableData.data(), tableData.size());
+		pack.seek(0, SEEK_SET);
+		pack.writeUint32LE(tableOffset);
+		pack.writeUint32LE(tableData.size());
+	}
+
+	bool readEntry(Twp::GGPackSet &packs, uint i, const Common::Array<byte> &expected) {
+		Twp::GGPackEntryReader reader;
+		if (!reader.open(packs, Common::String::format("entry%u.bin", i)) || reader.size() != (int64)expected.size())
+			return false;
+
+		Common::Array<byte> data(expected.size());
+		reader.read(data.data(), data.size());
+		return data == expected;
+	}
+
+	void test_xor_stream_matches_reference() {
+		seedRandom(1);
+		for (uint32 size = 0; size < 300; size += 13) {
+			Common::Array<byte> data = makeEntry(size);
+			static const uint32 chunks[] = { 1, 3, 8, 17, 64, 256, 1000 };
+			for (int i = 0; i < ARRAYSIZE(chunks); i++)
+				checkChunks(data, chunks[i]);
+		}
+	}
+
+	void test_pack_entries() {
+		seedRandom(2);
+		Common::Array<Common::Array<byte> > entries;
+		for (int i = 0; i < 20; i++)
+			entries.push_back(makeEntry(nextRandom() % 5000));
+
+		Common::MemoryWriteStreamDynamic packData(DisposeAfterUse::YES);
+		buildPack(entries, packData);
+		Common::MemoryReadStream packStream(packData.getData(), packData.size());
+
+		Twp::GGPackSet packs;
+		TS_ASSERT(packs._packs[1].open(&packStream, _key));
+
+		// The second pass is served from the cache of decoded entries
+		for (int pass = 0; pass < 2; pass++) {
+			for (uint i = 0; i < entries.size(); i++)
+				TS_ASSERT(readEntry(packs, i, entries[i]));
+		}
+
+		// Entry names are not case sensitive, and neither is the cache
+		Twp::GGPackEntryReader upper;
+		TS_ASSERT(upper.open(packs, "ENTRY3.BIN"));
+		TS_ASSERT_EQUALS(upper.size(), (int64)entries[3].size());
+		TS_ASSERT(packs.getCachedEntry("Entry3.Bin"));
+		TS_ASSERT(packs.getCachedEntry("entry3.bin") == packs.getCachedEntry("ENTRY3.BIN"));
+
+		// Evicting everything must not change what is read
+		packs.setCacheBudget(8192);
+		for (uint i = 0; i < entries.size(); i++)
+			TS_ASSERT(readEntry(packs, i, entries[i]));
+
+		Twp::GGPackEntryReader reader;
+		TS_ASSERT(!reader.open(packs, "missing.bin"));
+	}
+
+	void test_decode_speed() {
+#if BENCHMARK_TIME
+		Common::install_null_g_system();
+
+#ifdef SLOW_TESTS
+		const int count = 400;
+#else
+		const int count = 20;
+#endif
+		seedRandom(3);
+		Common::Array<Common::Array<byte> > entries;
+		for (int i = 0; i < count; i++)
+			entries.push_back(makeEntry(64 * 1024 + nextRandom()));
+
+		Common::MemoryWriteStreamDynamic packData(DisposeAfterUse::YES);
+		buildPack(entries, packData);
+
+		uint32 start = g_system->getMillis();
+		Common::Array<byte> data;
+		for (uint i = 0; i < entries.size(); i++) {
+			data = entries[i];
+			int previous = data.size() & 0xFF;
+			referenceRead(data.data(), data.size(), 0, previous);
+		}
+		uint32 referenceTime = g_system->getMillis() - start;
+
+		Common::MemoryReadStream packStream(packData.getData(), packData.size());
+		Twp::GGPackSet packs;
+		packs._packs[1].open(&packStream, _key);
+
+		start = g_system->getMillis();
+		for (uint i = 0; i < entries.size(); i++)
+			TS_ASSERT(readEntry(packs, i, entries[i]));
+		uint32 decodeTime = g_system->getMillis() - start;
+
+		start = g_system->getMillis();
+		for (uint i = 0; i < entries.size(); i++)
+			TS_ASSERT(readEntry(packs, i, entries[i]));
+		uint32 cachedTime = g_system->getMillis() - start;
+
+		debug("ggpack %u kB: byte decoder %u ms, word decoder %u ms, cached %u ms",
+		      (uint32)packData.size() / 1024, referenceTime, decodeTime, cachedTime);
+#endif
+	}
+};
@@ -0,0 +1,223 @@
+#include <cxxtest/TestSuite.h>
+#include "common/stream.h"
+#include "common/ptr.h"
+#include "common/random.h"
+#include "common/system.h"
+#include "engines/ultima/ultima8/world/item_sorter.h"
+#include "engines/ultima/ultima8/world/sort_item.h"
+#include "engines/ultima/ultima8/misc/point3.h"
+
+#include "../../../../null_osystem.h"
+
+/**
+ * Test suite for the display list built by engines/ultima/ultima8/world/item_sorter.h
+ *
+ * The sorter only compares items whose screenspace rects share a grid cell.
+ * These tests build pseudo-random scenes and check that the paint order is
+ * the same as with the original approach of comparing every pair of items.
+ */
+class U8ItemSorterTestSuite : public CxxTest::TestSuite {
+	public:
+	struct SceneItem {
+		Ultima::Ultima8::Box box;
+		bool occl, solid, roof, land, trans, draw, fixed;
+	};
+
+	Common::ScopedPtr<Common::RandomSource> _random;
+
+	/* Restart the random data from a fixed seed, so every run is the same */
+	void seedRandom(uint32 seed) {
+		if (!_random) {
+#if NULL_OSYSTEM_IS_AVAILABLE
+			// RandomSource needs g_system
+			if (!g_system)
+				Common::install_null_g_system();
+#endif
+			_random.reset(new Common::RandomSource("item_sorter"));
+		}
+		_random->setSeed(seed);
+	}
+
+	uint32 nextRandom(uint32 max) {
+		return _random->getRandomNumber(max - 1);
+	}
+
+	/* Floor tiles with walls, objects and roofs on top, roughly like a map */
+	void makeScene(Common::Array<SceneItem> &scene, int count) {
+		scene.clear();
+
+		for (int i = 0; i < count; i++) {
+			SceneItem item;
+			uint32 kind = nextRandom(4);
+			int x = nextRandom(16) * 128 + 128;
+			int y = nextRandom(16) * 128 + 128;
+
+			if (kind == 0) {
+				// Floor tile
+				item.box = Ultima::Ultima8::Box(x, y, nextRandom(2) * 40, 128, 128, 0);
+			} else if (kind == 1) {
+				// Wall
+				if (nextRandom(2))
+					item.box = Ultima::Ultima8::Box(x, y, 0, 32, 128, 40 + nextRandom(40));
+				else
+					item.box = Ultima::Ultima8::Box(x, y, 0, 128, 32, 40 + nextRandom(40));
+			} else {
+				// Object
+				item.box = Ultima::Ultima8::Box(x - nextRandom(96), y - nextRandom(96), nextRandom(48),
+					8 + nextRandom(64), 8 + nextRandom(64), nextRandom(32));
+			}
+
+			item.occl = kind <= 1 || nextRandom(4) == 0;
+			item.solid = kind != 0;
+			item.roof = kind == 0 && item.box._z > 0;
+			item.land = kind == 0;
+			item.trans = nextRandom(8) == 0;
+			item.draw = kind != 1 || nextRandom(2);
+			item.fixed = kind <= 1;
+			scene.push_back(item);
+		}
+	}
+
+	void setupItem(Ultima::Ultima8::SortItem *si, const SceneItem &item, int num) {
+		si->_itemNum = num;
+		si->setBoxBounds(item.box, 0, 0);
+		si->_occl = item.occl && !item.trans;
+		si->_solid = item.solid;
+		si->_roof = item.roof;
+		si->_land = item.land;
+		si->_trans = item.trans;
+		si->_draw = item.draw;
+		si->_fixed = item.fixed;
+		si->_sprite = false;
+		si->_invitem = false;
+	}
+
+	/* The list insertion as it was before the grid, comparing every pair */
+	void referenceInsert(Ultima::Ultima8::SortItem *&items, Ultima::Ultima8::SortItem *&tail, Ultima::Ultima8::SortItem *si) {
+		si->_occluded = false;
+		si->_order = -1;
+		si->_depends.clear();
+
+		Ultima::Ultima8::SortItem *addpoint = nullptr;
+		for (Ultima::Ultima8::SortItem *si2 = items; si2 != nullptr; si2 = si2->_next) {
+			if (!addpoint && si->listLessThan(*si2))
+				addpoint = si2;
+
+			if (si2->_occluded)
+				continue;
+
+			if (si->overlap(*si2)) {
+				if (si->below(*si2)) {
+					if (si2->_occl && si2->occludes(*si)) {
+						si->_occluded = true;
+						break;
+					} else {
+						si2->_depends.insert_sorted(si);
+					}
+				} else {
+					if (si->_occl && si->occludes(*si2)) {
+						si2->_occluded = true;
+					} else {
+						si->_depends.insert_sorted(si2);
+					}
+				}
+			}
+		}
+
+		if (addpoint) {
+			si->_next = addpoint;
+			si->_prev = addpoint->_prev;
+			addpoint->_prev = si;
+			if (si->_prev)
+				si->_prev->_next = si;
+			else
+				items = si;
+		} else {
+			if (tail)
+				tail->_next = si;
+			if (!items)
+				items = si;
+			si->_next = nullptr;
+			si->_prev = tail;
+			tail = si;
+		}
+	}
+
+	void referencePaint(Ultima::Ultima8::SortItem *si, int32 &order) {
+		if (si->_occluded)
+			return;
+
+		si->_order = -2;
+		for (auto *d : si->_depends) {
+			if (d->_order == -2)
+				break;
+			else if (d->_order == -1)
+				referencePaint(d, order);
+		}
+		si->_order = order++;
+	}
+
+	Common::String dumpOrder(const Ultima::Ultima8::SortItem *items) {
+		Common::String result;
+		for (const Ultima::Ultima8::SortItem *si = items; si != nullptr; si = si->_next)
+			result += Common::String::format("%d:%d ", si->_itemNum, si->_occluded ? -1 : si->_order);
+		return result;
+	}
+
+	void checkScene(const Common::Array<SceneItem> &scene, const Ultima::Ultima8::Rect &clip) {
+		Ultima::Ultima8::ItemSorter sorter(16);
+		sorter.BeginDisplayList(clip, Ultima::Ultima8::Point3(0, 0, 0));
+
+		Common::Array<Ultima::Ultima8::SortItem *> refItems;
+		Ultima::Ultima8::SortItem *refList = nullptr, *refTail = nullptr;
+
+		for (uint i = 0; i < scene.size(); i++) {
+			Ultima::Ultima8::SortItem *si = sorter.GetUnusedItem();
+			setupItem(si, scene[i], i);
+			if (!clip.intersects(si->_sr))
+				continue;
+			sorter.InsertItem(si);
+
+			Ultima::Ultima8::SortItem *ref = new Ultima::Ultima8::SortItem();
+			setupItem(ref, scene[i], i);
+			refItems.push_back(ref);
+			referenceInsert(refList, refTail, ref);
+		}
+
+		sorter.PaintDisplayList(nullptr);
+
+		int32 order = 0;
+		for (Ultima::Ultima8::SortItem *si = refList; si != nullptr; si = si->_next) {
+			if (si->_order == -1)
+				referencePaint(si, order);
+		}
+
+		TS_ASSERT_EQUALS(dumpOrder(sorter._items), dumpOrder(refList));
+
+		for (uint i = 0; i < refItems.size(); i++)
+			delete refItems[i];
+	}
+
+	void test_paint_order_matches_pairwise() {
+		Common::Array<SceneItem> scene;
+		const Ultima::Ultima8::Rect fullClip(-640, -200, 640, 600);
+
+		for (int i = 0; i < 20; i++) {
+			seedRandom(i);
+			makeScene(scene, 50 + i * 20);
+			checkScene(scene, fullClip);
+		}
+	}
+
+	void test_paint_order_partially_clipped() {
+		Common::Array<SceneItem> scene;
+		// Many items reach outside this, so they end up in the edge cells
+		const Ultima::Ultima8::Rect smallClip(-150, 50, 170, 290);
+
+		for (int i = 0; i < 20; i++) {
+			seedRandom(1000 + i);
+			makeScene(scene, 200 + i * 10);
+			checkScene(scene, smallClip);
+		}
+	}
+};
@@ -0,0 +1,52 @@
+#include <cxxtest/TestSuite.h>
+#include "engines/wintermute/base/scriptables/script_atom_table.h"
+
+/**
+ * Test suite for the name interning in engines/wintermute/base/scriptables/script_atom_table.h
+ *
+ * ScValue keys its properties by these atoms, so equal names must always
+ * map to the same atom, and different names to different ones.
+ */
+class ScAtomTableTestSuite : public CxxTest::TestSuite {
+	public:
+	void test_intern() {
+		Wintermute::ScAtomTable table;
+
+		uint32 width = table.intern("Width");
+		uint32 height = table.intern("Height");
+		TS_ASSERT_DIFFERS(width, height);
+		TS_ASSERT_EQUALS(table.intern("Width"), width);
+		TS_ASSERT_EQUALS(table.intern("Height"), height);
+	}
+
+	void test_find() {
+		Wintermute::ScAtomTable table;
+
+		TS_ASSERT_EQUALS(table.find("Width"), Wintermute::ScAtomTable::kNoAtom);
+		uint32 width = table.intern("Width");
+		TS_ASSERT_EQUALS(table.find("Width"), width);
+		// Property names are case sensitive
+		TS_ASSERT_EQUALS(table.find("width"), Wintermute::ScAtomTable::kNoAtom);
+	}
+
+	void test_names_are_copied() {
+		Wintermute::ScAtomTable table;
+
+		char name[] = "Height";
+		uint32 height = table.intern(name);
+		name[0] = 'W';
+
+		TS_ASSERT_EQUALS(Common::String(table.getName(height)), "Height");
+		TS_ASSERT_EQUALS(table.find("Height"), height);
+		TS_ASSERT_EQUALS(table.find(name), Wintermute::ScAtomTable::kNoAtom);
+	}
+
+	void test_many_names() {
+		Wintermute::ScAtomTable table;
+
+		for (int i = 0; i < 1000; i++)
+			TS_ASSERT_EQUALS(table.intern(Common::String::format("var%d", i).c_str()), (uint32)i);
+		for (int i = 0; i < 1000; i++)
+			TS_ASSERT_EQUALS(table.find(Common::String::format("var%d", i).c_str()), (uint32)i);
+	}
+};
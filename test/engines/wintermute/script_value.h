@@ -0,0 +1,173 @@
+#include <cxxtest/TestSuite.h>
+#include "engines/wintermute/base/scriptables/script_property_array.h"
+
+#include "common/str.h"
+
+/**
+ * Test suite for the property storage of ScValue, in
+ * engines/wintermute/base/scriptables/script_property_array.h
+ *
+ * The properties must stay sorted by atom however they are added, copied or
+ * restored, since they are found with a binary search.
+ */
+class ScPropertyArrayTestSuite : public CxxTest::TestSuite {
+	/**
+	 * Stands in for BasePersistenceManager, keeping the transferred data in
+	 * memory. Pointers are kept as is, as the class registry would map them.
+	 */
+	class MemoryPersistenceManager {
+	public:
+		MemoryPersistenceManager() : _saving(true), _intPos(0), _stringPos(0), _ptrPos(0) {}
+
+		bool getIsSaving() { return _saving; }
+		void startLoading() { _saving = false; }
+
+		bool transferSint32(const char *name, int32 *val) {
+			if (_saving)
+				_ints.push_back(*val);
+			else
+				*val = _ints[_intPos++];
+			return true;
+		}
+
+		bool transferConstChar(const char *name, const char **val) {
+			if (_saving) {
+				_strings.push_back(*val);
+			} else {
+				// Like BasePersistenceManager, hand out a copy to be delete[]d
+				const Common::String &str = _strings[_stringPos++];
+				char *copy = new char[str.size() + 1];
+				memcpy(copy, str.c_str(), str.size() + 1);
+				*val = copy;
+			}
+			return true;
+		}
+
+		bool transferPtr(const char *name, void *val) {
+			if (_saving)
+				_ptrs.push_back(*(void **)val);
+			else
+				*(void **)val = _ptrs[_ptrPos++];
+			return true;
+		}
+
+	private:
+		bool _saving;
+		uint _intPos, _stringPos, _ptrPos;
+		Common::Array<int32> _ints;
+		Common::Array<Common::String> _strings;
+		Common::Array<void *> _ptrs;
+	};
+
+	static Wintermute::ScValue *fakeValue(int i) {
+		// The array never dereferences its values
+		return (Wintermute::ScValue *)(size_t)(0x1000 + i * 16);
+	}
+
+	static bool isSorted(const Wintermute::ScPropertyArray &props) {
+		for (uint i = 1; i < props.size(); i++) {
+			if (props[i - 1].atom >= props[i].atom)
+				return false;
+		}
+		return true;
+	}
+
+	public:
+	void test_sorted_insert() {
+		Wintermute::ScPropertyArray props;
+
+		const uint32 atoms[] = { 7, 2, 9, 0, 5, 2, 8, 1 };
+		for (int i = 0; i < ARRAYSIZE(atoms); i++) {
+			Wintermute::ScValue *&slot = props.slot(atoms[i]);
+			if (!slot)
+				slot = fakeValue(i);
+			TS_ASSERT(isSorted(props));
+		}
+
+		TS_ASSERT_EQUALS(props.size(), 7u);
+		for (int i = 0; i < ARRAYSIZE(atoms); i++) {
+			int index = props.find(atoms[i]);
+			TS_ASSERT(index >= 0);
+			TS_ASSERT_EQUALS(props[index].atom, atoms[i]);
+		}
+
+		// A property set twice keeps its first slot
+		TS_ASSERT_EQUALS(props[props.find(2)].value, fakeValue(1));
+		TS_ASSERT_EQUALS(props.find(3), -1);
+		TS_ASSERT_EQUALS(props.find(Wintermute::ScAtomTable::kNoAtom), -1);
+		TS_ASSERT_EQUALS(props.size(), 7u);
+	}
+
+	void test_delete() {
+		Wintermute::ScPropertyArray props;
+		for (int i = 0; i < 10; i++)
+			props.slot(9 - i) = fakeValue(i);
+
+		// ScValue::deleteProp() frees the value but keeps the property, as
+		// the original engine did
+		int index = props.find(4);
+		props[index].value = nullptr;
+		TS_ASSERT_EQUALS(props.find(4), index);
+		TS_ASSERT(props.slot(4) == nullptr);
+		TS_ASSERT_EQUALS(props.size(), 10u);
+		TS_ASSERT(isSorted(props));
+
+		props.clear();
+		TS_ASSERT(props.empty());
+		TS_ASSERT_EQUALS(props.find(4), -1);
+	}
+
+	void test_copy() {
+		Wintermute::ScPropertyArray props;
+		props.slot(3) = fakeValue(3);
+		props.slot(1) = fakeValue(1);
+		props.slot(2) = fakeValue(2);
+
+		// ScValue::copy() copies the layout, then replaces the values
+		Wintermute::ScPropertyArray copy;
+		copy.slot(5) = fakeValue(5);
+		copy = props;
+		TS_ASSERT_EQUALS(copy.size(), 3u);
+		TS_ASSERT(isSorted(copy));
+		TS_ASSERT_EQUALS(copy.find(5), -1);
+		for (uint i = 0; i < copy.size(); i++)
+			TS_ASSERT_EQUALS(copy[i].value, props[i].value);
+
+		copy.slot(0) = fakeValue(0);
+		copy[copy.find(1)].value = fakeValue(10);
+		TS_ASSERT_EQUALS(props.size(), 3u);
+		TS_ASSERT_EQUALS(props.find(0), -1);
+		TS_ASSERT_EQUALS(props[props.find(1)].value, fakeValue(1));
+	}
+
+	void test_persist_round_trip() {
+		Wintermute::ScAtomTable savedAtoms;
+		Wintermute::ScPropertyArray props;
+		const char *const names[] = { "Width", "Height", "Caption", "Visible", "Alpha" };
+		for (int i = 0; i < ARRAYSIZE(names); i++)
+			props.slot(savedAtoms.intern(names[i])) = fakeValue(i);
+
+		MemoryPersistenceManager persistMgr;
+		TS_ASSERT(props.persist(&persistMgr, &savedAtoms));
+
+		// Properties are saved by name, so they must survive the atoms being
+		// assigned in a different order in the next session
+		Wintermute::ScAtomTable loadedAtoms;
+		loadedAtoms.intern("Visible");
+		loadedAtoms.intern("Caption");
+		loadedAtoms.intern("Unrelated");
+
+		Wintermute::ScPropertyArray restored;
+		persistMgr.startLoading();
+		TS_ASSERT(restored.persist(&persistMgr, &loadedAtoms));
+
+		TS_ASSERT_EQUALS(restored.size(), props.size());
+		TS_ASSERT(isSorted(restored));
+		for (int i = 0; i < ARRAYSIZE(names); i++) {
+			int index = restored.find(loadedAtoms.find(names[i]));
+			TS_ASSERT(index >= 0);
+			if (index >= 0)
+				TS_ASSERT_EQUALS(restored[index].value, fakeValue(i));
+		}
+	}
+};
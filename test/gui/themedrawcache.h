@@ -0,0 +1,161 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/managed_surface.h"
+
+#include "gui/ThemeDrawCache.h"
+
+/**
+ * Test suite for the rendered DrawData cache of the ThemeEngine in
+ * gui/ThemeDrawCache.h
+ */
+class ThemeDrawCacheTestSuite : public CxxTest::TestSuite {
+	public:
+	/* Draws a widget into rect through the cache, and tells whether it was copied from it */
+	bool drawWidget(GUI::ThemeDrawCache &cache, const GUI::DrawDataCacheKey &key, Graphics::ManagedSurface &surface, const Common::Rect &rect, uint32 color) {
+		if (cache.copy(key, &surface, rect))
+			return true;
+
+		byte *pixels = cache.begin(&surface, rect);
+		surface.fillRect(Common::Rect(rect.left + 1, rect.top + 1, rect.right - 1, rect.bottom - 1), color);
+		if (pixels)
+			cache.end(key, &surface, rect, pixels);
+		return false;
+	}
+
+	GUI::DrawDataCacheKey makeKey(int type, const Common::Rect &rect) {
+		GUI::DrawDataCacheKey key;
+		key.type = type;
+		key.area = Common::Rect(rect.width(), rect.height());
+		key.extendedRect = key.area;
+		return key;
+	}
+
+	void test_hits_and_misses() {
+		GUI::ThemeDrawCache cache(1024 * 1024);
+		Graphics::ManagedSurface surface(64, 32, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+		surface.clear(0x112233ff);
+
+		const Common::Rect first(2, 2, 22, 12);
+		const GUI::DrawDataCacheKey key = makeKey(1, first);
+		TS_ASSERT(!drawWidget(cache, key, surface, first, 0xff0000ff));
+		TS_ASSERT_EQUALS(cache.size(), 1u);
+
+		// The same widget elsewhere on the same background is copied
+		const Common::Rect second(30, 10, 50, 20);
+		TS_ASSERT(drawWidget(cache, key, surface, second, 0x00ff00ff));
+		TS_ASSERT_EQUALS(surface.getPixel(40, 15), 0xff0000ffu);
+		TS_ASSERT_EQUALS(surface.getPixel(30, 10), 0x112233ffu);
+		TS_ASSERT_EQUALS(cache.getHits(), 1u);
+
+		// Another widget, or the same one over another background, is drawn
+		const Common::Rect third(2, 18, 22, 28);
+		TS_ASSERT(!drawWidget(cache, makeKey(2, third), surface, third, 0x0000ffff));
+		surface.fillRect(first, 0x445566ff);
+		TS_ASSERT(!drawWidget(cache, key, surface, first, 0x00ff00ff));
+		TS_ASSERT_EQUALS(surface.getPixel(10, 5), 0x00ff00ffu);
+		TS_ASSERT_EQUALS(cache.getMisses(), 3u);
+
+		// The entry drawn over the new background replaced the old one
+		TS_ASSERT_EQUALS(cache.size(), 2u);
+		surface.fillRect(second, 0x445566ff);
+		TS_ASSERT(drawWidget(cache, key, surface, second, 0xff0000ff));
+		TS_ASSERT_EQUALS(surface.getPixel(40, 15), 0x00ff00ffu);
+	}
+
+	void test_texts_are_keyed_on_their_contents() {
+		GUI::ThemeDrawCache cache(1024 * 1024);
+		Graphics::ManagedSurface surface(64, 32, Graphics::PixelFormat::createFormatCLUT8());
+		surface.clear(0);
+
+		const Common::Rect rect(0, 0, 20, 10);
+		GUI::DrawDataCacheKey key = makeKey(-1, rect);
+		key.text = Common::U32String("OK");
+		TS_ASSERT(!drawWidget(cache, key, surface, rect, 1));
+		surface.clear(0);
+		TS_ASSERT(drawWidget(cache, key, surface, rect, 1));
+
+		surface.clear(0);
+		key.text = Common::U32String("Cancel");
+		TS_ASSERT(!drawWidget(cache, key, surface, rect, 2));
+		TS_ASSERT_EQUALS(cache.size(), 2u);
+	}
+
+	void test_large_items_are_not_cached() {
+		GUI::ThemeDrawCache cache(4096);
+		Graphics::ManagedSurface surface(64, 32, Graphics::PixelFormat::createFormatCLUT8());
+		surface.clear(0);
+
+		// More than a quarter of the cache for its two copies
+		const Common::Rect rect(0, 0, 32, 20);
+		TS_ASSERT(!drawWidget(cache, makeKey(1, rect), surface, rect, 1));
+		TS_ASSERT_EQUALS(cache.size(), 0u);
+		TS_ASSERT_EQUALS(cache.getUsedMemory(), 0u);
+	}
+
+	void test_least_recently_used_items_are_dropped() {
+		// Room for four 16x8 CLUT8 items
+		GUI::ThemeDrawCache cache(4 * 2 * 16 * 8);
+		Graphics::ManagedSurface surface(64, 32, Graphics::PixelFormat::createFormatCLUT8());
+		surface.clear(0);
+
+		const Common::Rect rect(0, 0, 16, 8);
+		for (int i = 0; i < 4; i++) {
+			surface.clear(0);
+			drawWidget(cache, makeKey(i, rect), surface, rect, i + 1);
+		}
+		TS_ASSERT_EQUALS(cache.size(), 4u);
+
+		// Using the first one makes the second one the oldest
+		surface.clear(0);
+		TS_ASSERT(drawWidget(cache, makeKey(0, rect), surface, rect, 1));
+		surface.clear(0);
+		drawWidget(cache, makeKey(4, rect), surface, rect, 5);
+		TS_ASSERT_EQUALS(cache.size(), 4u);
+		TS_ASSERT(cache.getUsedMemory() <= 4 * 2 * 16 * 8u);
+
+		surface.clear(0);
+		TS_ASSERT(drawWidget(cache, makeKey(0, rect), surface, rect, 1));
+		surface.clear(0);
+		TS_ASSERT(!drawWidget(cache, makeKey(1, rect), surface, rect, 2));
+	}
+
+	void test_theme_and_resolution_changes_clear_the_cache() {
+		GUI::ThemeDrawCache cache(1024 * 1024);
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		Graphics::ManagedSurface surface(64, 32, format);
+		surface.clear(0);
+
+		const Common::Rect rect(0, 0, 16, 8);
+		cache.setTheme("scummremastered");
+		cache.setScreen(format, 640, 480, 1);
+		cache.setScale(1.0f);
+		drawWidget(cache, makeKey(1, rect), surface, rect, 1);
+		TS_ASSERT_EQUALS(cache.size(), 1u);
+
+		// Setting the same values again keeps the entries
+		cache.setTheme("scummremastered");
+		cache.setScreen(format, 640, 480, 1);
+		cache.setScale(1.0f);
+		TS_ASSERT_EQUALS(cache.size(), 1u);
+
+		cache.setTheme("scummmodern");
+		TS_ASSERT_EQUALS(cache.size(), 0u);
+
+		drawWidget(cache, makeKey(1, rect), surface, rect, 1);
+		cache.setScreen(format, 800, 600, 1);
+		TS_ASSERT_EQUALS(cache.size(), 0u);
+
+		drawWidget(cache, makeKey(1, rect), surface, rect, 1);
+		cache.setScreen(format, 800, 600, 2);
+		TS_ASSERT_EQUALS(cache.size(), 0u);
+
+		drawWidget(cache, makeKey(1, rect), surface, rect, 1);
+		cache.setScreen(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0), 800, 600, 2);
+		TS_ASSERT_EQUALS(cache.size(), 0u);
+
+		drawWidget(cache, makeKey(1, rect), surface, rect, 1);
+		cache.setScale(2.0f);
+		TS_ASSERT_EQUALS(cache.size(), 0u);
+		TS_ASSERT_EQUALS(cache.getUsedMemory(), 0u);
+	}
+};
@@ -0,0 +1,366 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/debug.h"
+#include "common/list.h"
+#include "common/memstream.h"
+#include "common/rect.h"
+#include "common/system.h"
+
+#include "graphics/pixelformat.h"
+#include "graphics/surface.h"
+
+#ifdef USE_TINYGL
+#include "graphics/tinygl/tinygl.h"
+#include "graphics/tinygl/texelbuffer.h"
+#endif
+
+#include "../null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+/**
+ * Test suite for the draw call queue and texturing of graphics/tinygl
+ *
+ * With dirty rects, the draw calls of a frame are compared with the ones
+ * of the previous frame through their signatures. These tests check that
+ * unchanged frames are not redrawn and that changed ones still match a
+ * context which redraws everything. Minified textures are sampled from
+ * mip levels when they were generated and the filter asks for them.
+ * Captured frames are drawn the same way when they are replayed.
+ */
+class TinyGLTestSuite : public CxxTest::TestSuite {
+public:
+#ifdef USE_TINYGL
+	static const int kWidth = 64;
+	static const int kHeight = 48;
+
+	void drawFrame(float offset, TinyGL::BlitImage *blitImage) {
+		tglViewport(0, 0, kWidth, kHeight);
+		tglMatrixMode(TGL_PROJECTION);
+		tglLoadIdentity();
+		tglOrtho(0, kWidth, kHeight, 0, -1, 1);
+		tglMatrixMode(TGL_MODELVIEW);
+		tglLoadIdentity();
+
+		tglClearColor(0.0f, 0.0f, 0.2f, 1.0f);
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+
+		for (int i = 0; i < 4; i++) {
+			tglBegin(TGL_TRIANGLES);
+			tglColor3f(1.0f, i * 0.25f, 0.0f);
+			tglVertex3f(4 + i * 14 + (i == 2 ? offset : 0), 4, 0);
+			tglVertex3f(14 + i * 14, 20, 0);
+			tglVertex3f(4 + i * 14, 30, 0);
+			tglEnd();
+		}
+
+		if (blitImage)
+			tglBlit(blitImage, TinyGL::BlitTransform(40, 36));
+	}
+
+	TinyGL::BlitImage *createBlitImage(const Graphics::PixelFormat &format) {
+		Graphics::Surface image;
+		image.create(8, 8, format);
+		image.fillRect(Common::Rect(8, 8), format.ARGBToColor(255, 255, 0, 255));
+		TinyGL::BlitImage *blitImage = tglGenBlitImage();
+		tglUploadBlitImage(blitImage, image, 0, false);
+		image.free();
+		return blitImage;
+	}
+
+	void test_unchanged_frames_are_skipped() {
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		TinyGL::ContextHandle *dirty = TinyGL::createContext(kWidth, kHeight, format, 256, false, true);
+		TinyGL::ContextHandle *full = TinyGL::createContext(kWidth, kHeight, format, 256, false, false);
+		TinyGL::FrameStats stats;
+
+		TinyGL::setContext(dirty);
+		TinyGL::BlitImage *dirtyImage = createBlitImage(format);
+		TinyGL::setContext(full);
+		TinyGL::BlitImage *fullImage = createBlitImage(format);
+
+		// The fourth frame has no blit
+		static const float offsets[] = { 0.0f, 0.0f, 3.0f, 3.0f, 0.0f, 0.0f };
+		static const bool changedFrames[] = { true, false, true, true, true, false };
+		for (int frame = 0; frame < ARRAYSIZE(offsets); frame++) {
+			Common::List<Common::Rect> dirtyAreas;
+
+			TinyGL::setContext(dirty);
+			drawFrame(offsets[frame], frame != 3 ? dirtyImage : nullptr);
+			TinyGL::presentBuffer(dirtyAreas);
+			TinyGL::getFrameStats(stats);
+
+			TS_ASSERT_EQUALS(stats.drawCalls, frame != 3 ? 6u : 5u);
+			TS_ASSERT(stats.allocations >= stats.drawCalls);
+			TS_ASSERT(stats.allocatedBytes > 0 && stats.allocatedBytes <= stats.peakBytes);
+			TS_ASSERT(stats.peakBytes < stats.capacityBytes);
+
+			TS_ASSERT_EQUALS(dirtyAreas.empty(), !changedFrames[frame]);
+			if (!changedFrames[frame])
+				TS_ASSERT_EQUALS(stats.changedCalls, 0u);
+
+			Graphics::Surface dirtySurface, fullSurface;
+			TinyGL::getSurfaceRef(dirtySurface);
+
+			TinyGL::setContext(full);
+			drawFrame(offsets[frame], frame != 3 ? fullImage : nullptr);
+			TinyGL::presentBuffer();
+			TinyGL::getFrameStats(stats);
+			TS_ASSERT_EQUALS(stats.changedCalls, stats.drawCalls);
+			TinyGL::getSurfaceRef(fullSurface);
+
+			for (int y = 0; y < kHeight; y++)
+				TS_ASSERT_EQUALS(memcmp(dirtySurface.getBasePtr(0, y), fullSurface.getBasePtr(0, y), kWidth * 4), 0);
+		}
+
+		TinyGL::setContext(dirty);
+		tglDeleteBlitImage(dirtyImage);
+		TinyGL::setContext(full);
+		tglDeleteBlitImage(fullImage);
+		TinyGL::destroyContext();
+	}
+
+	/* A 256x256 black and white checkerboard with single texel squares */
+	TGLuint createCheckerboard(TGLint minFilter, bool mipmaps) {
+		const int size = 256;
+		Common::Array<byte> pixels(size * size * 4);
+		for (int y = 0; y < size; y++) {
+			for (int x = 0; x < size; x++) {
+				byte c = ((x ^ y) & 1) ? 255 : 0;
+				byte *p = &pixels[(y * size + x) * 4];
+				p[0] = p[1] = p[2] = c;
+				p[3] = 255;
+			}
+		}
+
+		TGLuint texture;
+		tglGenTextures(1, &texture);
+		tglBindTexture(TGL_TEXTURE_2D, texture);
+		tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_MAG_FILTER, TGL_NEAREST);
+		tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_MIN_FILTER, minFilter);
+		tglTexImage2D(TGL_TEXTURE_2D, 0, TGL_RGBA, size, size, 0, TGL_RGBA, TGL_UNSIGNED_BYTE, pixels.data());
+		if (mipmaps)
+			tglGenerateMipmap(TGL_TEXTURE_2D);
+		return texture;
+	}
+
+	/* Draws the bound texture on a square of the given size */
+	void drawTexturedQuad(TGLuint texture, float size) {
+		tglViewport(0, 0, kWidth, kHeight);
+		tglMatrixMode(TGL_PROJECTION);
+		tglLoadIdentity();
+		tglOrtho(0, kWidth, kHeight, 0, -1, 1);
+		tglMatrixMode(TGL_MODELVIEW);
+		tglLoadIdentity();
+
+		tglClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+
+		tglEnable(TGL_TEXTURE_2D);
+		tglBindTexture(TGL_TEXTURE_2D, texture);
+		tglColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+		tglBegin(TGL_QUADS);
+		tglTexCoord2f(0.0f, 0.0f);
+		tglVertex3f(0, 0, 0);
+		tglTexCoord2f(1.0f, 0.0f);
+		tglVertex3f(size, 0, 0);
+		tglTexCoord2f(1.0f, 1.0f);
+		tglVertex3f(size, size, 0);
+		tglTexCoord2f(0.0f, 1.0f);
+		tglVertex3f(0, size, 0);
+		tglEnd();
+		tglDisable(TGL_TEXTURE_2D);
+	}
+
+	/* The number of pixels inside the quad which are neither black nor white */
+	int countGreyPixels(const Graphics::Surface &surface, int size) {
+		int grey = 0;
+		for (int y = 2; y < size - 2; y++) {
+			for (int x = 2; x < size - 2; x++) {
+				uint8 a, r, g, b;
+				surface.format.colorToARGB(surface.getPixel(x, y), a, r, g, b);
+				if (r >= 64 && r < 192)
+					grey++;
+			}
+		}
+		return grey;
+	}
+
+	void test_minified_textures_use_mipmaps() {
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		TinyGL::ContextHandle *context = TinyGL::createContext(kWidth, kHeight, format, 256, false, false);
+
+		// Each pixel covers 8x8 texels
+		const int size = 32;
+		const int inside = (size - 4) * (size - 4);
+		static const TGLint mipmapFilters[] = {
+			TGL_NEAREST_MIPMAP_NEAREST, TGL_NEAREST_MIPMAP_LINEAR,
+			TGL_LINEAR_MIPMAP_NEAREST, TGL_LINEAR_MIPMAP_LINEAR
+		};
+		for (int i = 0; i < ARRAYSIZE(mipmapFilters); i++) {
+			TGLuint texture = createCheckerboard(mipmapFilters[i], true);
+			drawTexturedQuad(texture, size);
+			TinyGL::presentBuffer();
+
+			Graphics::Surface surface;
+			TinyGL::getSurfaceRef(surface);
+			TS_ASSERT_EQUALS(countGreyPixels(surface, size), inside);
+			tglDeleteTextures(1, &texture);
+		}
+
+		// Without mip levels, every pixel picks a single texel. They are
+		// not built on upload, even with the default mipmap filter.
+		static const TGLint filters[] = { TGL_NEAREST, TGL_NEAREST_MIPMAP_LINEAR };
+		for (int i = 0; i < ARRAYSIZE(filters); i++) {
+			TGLuint texture = createCheckerboard(filters[i], false);
+			drawTexturedQuad(texture, size);
+			TinyGL::presentBuffer();
+
+			Graphics::Surface surface;
+			TinyGL::getSurfaceRef(surface);
+			TS_ASSERT_EQUALS(countGreyPixels(surface, size), 0);
+			tglDeleteTextures(1, &texture);
+		}
+
+		TinyGL::destroyContext(context);
+	}
+
+	void test_texels_read_back() {
+		// Frame captures store the texels of each texture as they were uploaded
+		uint32 argb[5 * 3];
+		for (int i = 0; i < ARRAYSIZE(argb); i++)
+			argb[i] = 0xff000000 | (i * 0x110d07);
+
+		for (int bilinear = 0; bilinear < 2; bilinear++) {
+			TinyGL::TexelBuffer *texture = TinyGL::createTexelBuffer(argb, 5, 3, 256, bilinear, false);
+			for (int y = 0; y < 3; y++) {
+				for (int x = 0; x < 5; x++) {
+					uint8 a, r, g, b;
+					texture->getTexel(x, y, a, r, g, b);
+					TS_ASSERT_EQUALS((uint32)((a << 24) | (r << 16) | (g << 8) | b), argb[y * 5 + x]);
+				}
+			}
+			delete texture;
+		}
+	}
+
+	void test_odd_sized_mipmaps_keep_every_texel() {
+		// A 3x3 white texture with a black last row and column
+		uint32 argb[9];
+		for (int i = 0; i < 9; i++)
+			argb[i] = (i % 3 == 2 || i >= 6) ? 0xff000000 : 0xffffffff;
+
+		TinyGL::TexelBuffer *texture = TinyGL::createTexelBuffer(argb, 3, 3, 256, false, true);
+		const TinyGL::TexelBuffer *level = texture->getLevel(UINT_MAX);
+		TS_ASSERT_EQUALS(level->getWidth(), 1u);
+		TS_ASSERT_EQUALS(level->getHeight(), 1u);
+
+		// The 1x1 level averages all 9 texels, 4 of which are white
+		uint8 a, r, g, b;
+		level->getTexel(0, 0, a, r, g, b);
+		TS_ASSERT_EQUALS(a, 255);
+		TS_ASSERT_EQUALS(r, (4 * 255 + 4) / 9);
+		TS_ASSERT_EQUALS(g, r);
+		TS_ASSERT_EQUALS(b, r);
+		delete texture;
+	}
+
+	void test_frame_capture_replay() {
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+
+		for (int dirtyRects = 0; dirtyRects < 2; dirtyRects++) {
+			TinyGL::ContextHandle *context = TinyGL::createContext(kWidth, kHeight, format, 256, false, dirtyRects);
+			TinyGL::BlitImage *blitImage = createBlitImage(format);
+			TGLuint texture = createCheckerboard(TGL_LINEAR_MIPMAP_NEAREST, true);
+
+			Common::MemoryWriteStreamDynamic capture(DisposeAfterUse::YES);
+			TinyGL::captureFrame(&capture, DisposeAfterUse::NO);
+			drawTexturedQuad(texture, 24);
+			drawFrame(2.0f, blitImage);
+			TinyGL::presentBuffer();
+			TS_ASSERT(capture.size() > 0);
+
+			Graphics::Surface surface;
+			TinyGL::getSurfaceRef(surface);
+			Graphics::Surface expected;
+			expected.copyFrom(surface);
+
+			// The capture is only taken once
+			int32 size = capture.size();
+			drawFrame(0.0f, blitImage);
+			TinyGL::presentBuffer();
+			TS_ASSERT_EQUALS(capture.size(), size);
+
+			tglDeleteBlitImage(blitImage);
+			tglDeleteTextures(1, &texture);
+			TinyGL::destroyContext(context);
+
+			Common::MemoryReadStream stream(capture.getData(), capture.size());
+			TinyGL::ContextHandle *replay = TinyGL::loadFrameCapture(&stream);
+			TS_ASSERT(replay);
+			if (!replay) {
+				expected.free();
+				continue;
+			}
+
+			// Replaying twice draws the same image
+			for (int i = 0; i < 2; i++) {
+				TinyGL::replayFrame();
+				TinyGL::getSurfaceRef(surface);
+				for (int y = 0; y < kHeight; y++)
+					TS_ASSERT_EQUALS(memcmp(expected.getBasePtr(0, y), surface.getBasePtr(0, y), kWidth * 4), 0);
+			}
+			TinyGL::destroyContext(replay);
+			expected.free();
+		}
+
+		static const byte garbage[] = "not a frame capture";
+		Common::MemoryReadStream stream(garbage, sizeof(garbage));
+		TS_ASSERT(!TinyGL::loadFrameCapture(&stream));
+	}
+
+	void test_texture_fill_speed() {
+#if BENCHMARK_TIME
+		Common::install_null_g_system();
+
+#ifdef SLOW_TESTS
+		const int frames = 2000;
+#else
+		const int frames = 50;
+#endif
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		TinyGL::ContextHandle *context = TinyGL::createContext(kWidth, kHeight, format, 256, false, false);
+		TGLuint nearest = createCheckerboard(TGL_NEAREST, false);
+		TGLuint mipmapped = createCheckerboard(TGL_LINEAR_MIPMAP_NEAREST, true);
+
+		static const float sizes[] = { 16.0f, kHeight };
+		for (int i = 0; i < ARRAYSIZE(sizes); i++) {
+			uint32 start = g_system->getMillis();
+			for (int frame = 0; frame < frames; frame++) {
+				drawTexturedQuad(nearest, sizes[i]);
+				TinyGL::presentBuffer();
+			}
+			uint32 nearestTime = g_system->getMillis() - start;
+
+			start = g_system->getMillis();
+			for (int frame = 0; frame < frames; frame++) {
+				drawTexturedQuad(mipmapped, sizes[i]);
+				TinyGL::presentBuffer();
+			}
+			uint32 mipmappedTime = g_system->getMillis() - start;
+
+			debug("TinyGL %d frames of a 256x256 texture on %dx%d pixels: nearest %u ms, mipmapped %u ms",
+			      frames, (int)sizes[i], (int)sizes[i], nearestTime, mipmappedTime);
+		}
+
+		tglDeleteTextures(1, &nearest);
+		tglDeleteTextures(1, &mipmapped);
+		TinyGL::destroyContext(context);
+#endif
+	}
+#endif
+};
@@ -0,0 +1,138 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/system.h"
+#include "common/textconsole.h"
+
+#include "graphics/managed_surface.h"
+#include "graphics/VectorRendererSpec.h"
+
+#include "../null_osystem.h"
+#include "../instrset_detect.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+template<typename PixelType>
+class TestVectorRenderer : public Graphics::VectorRendererSpec<PixelType> {
+public:
+	TestVectorRenderer(const Graphics::PixelFormat &format) : Graphics::VectorRendererSpec<PixelType>(format) {}
+
+	void setSIMD(bool enable) {
+		this->_useSSE2 = enable;
+	}
+
+	bool hasSIMD() const {
+		return this->_useSSE2;
+	}
+};
+
+class VectorRendererTestSuite : public CxxTest::TestSuite {
+public:
+	void setUp() {
+		// The null backend has no graphics manager to query for CPU features
+#ifdef SCUMMVM_SSE2
+		Graphics::VectorRendererSSE2::_cpuSupport = instrset_detect() >= 2 ? 1 : 0;
+#endif
+	}
+
+	template<typename PixelType>
+	uint32 drawWidgets(TestVectorRenderer<PixelType> &renderer, Graphics::ManagedSurface &surf, int iters) {
+		renderer.setSurface(&surf);
+		renderer.setGradientColors(0xff, 0xe0, 0x80, 0x40, 0x20, 0x10);
+		renderer.setBgColor(0x80, 0x80, 0xc0);
+		renderer.setFgColor(0x10, 0x10, 0x10);
+		renderer.setShadowOffset(4);
+		renderer.setShadowIntensity(1 << 16);
+
+		const int cols = 4, rows = 6;
+		const int w = surf.w / cols, h = surf.h / rows;
+
+		uint32 start = g_system->getMillis();
+		for (int i = 0; i < iters; i++) {
+			renderer.setFillMode(Graphics::VectorRenderer::kFillBackground);
+			renderer.fillSurface();
+			for (int y = 0; y < rows; y++) {
+				for (int x = 0; x < cols; x++) {
+					renderer.setFillMode((x + y) & 1 ? Graphics::VectorRenderer::kFillGradient : Graphics::VectorRenderer::kFillBackground);
+					if (y & 1)
+						renderer.drawRoundedSquare(x * w + 4, y * h + 4, 6, w - 12, h - 12);
+					else
+						renderer.drawSquare(x * w + 4, y * h + 4, w - 12, h - 12);
+				}
+			}
+		}
+		return g_system->getMillis() - start;
+	}
+
+	template<typename PixelType>
+	void benchmarkFormat(const Graphics::PixelFormat &format, const char *name) {
+#ifdef SLOW_TESTS
+		const int iters = 200;
+#else
+		const int iters = 1;
+#endif
+		static const int resolutions[][2] = { { 320, 200 }, { 640, 480 }, { 1280, 960 }, { 1920, 1080 } };
+
+		TestVectorRenderer<PixelType> renderer(format);
+		bool simd = renderer.hasSIMD();
+
+		for (int i = 0; i < ARRAYSIZE(resolutions); i++) {
+			Graphics::ManagedSurface surfGeneric(resolutions[i][0], resolutions[i][1], format);
+			Graphics::ManagedSurface surfSIMD(resolutions[i][0], resolutions[i][1], format);
+
+			renderer.setSIMD(false);
+			uint32 genericTime = drawWidgets(renderer, surfGeneric, iters);
+			renderer.setSIMD(simd);
+			uint32 simdTime = drawWidgets(renderer, surfSIMD, iters);
+
+			TS_ASSERT_EQUALS(memcmp(surfGeneric.getPixels(), surfSIMD.getPixels(), surfSIMD.pitch * surfSIMD.h), 0);
+
+			debug("VectorRenderer %s %dx%d: generic %u ms, %s %u ms (%d iters)", name,
+			      resolutions[i][0], resolutions[i][1], genericTime,
+			      simd ? "SIMD" : "generic", simdTime, iters);
+		}
+	}
+
+	template<typename PixelType>
+	void checkFormat(const Graphics::PixelFormat &format) {
+		TestVectorRenderer<PixelType> renderer(format);
+		if (!renderer.hasSIMD())
+			return;
+
+		// Odd sizes so the SIMD kernels also have to handle the row tails
+		Graphics::ManagedSurface surfGeneric(203, 151, format);
+		Graphics::ManagedSurface surfSIMD(203, 151, format);
+
+		renderer.setSIMD(false);
+		drawWidgets(renderer, surfGeneric, 1);
+		renderer.setSIMD(true);
+		drawWidgets(renderer, surfSIMD, 1);
+
+		TS_ASSERT_EQUALS(memcmp(surfGeneric.getPixels(), surfSIMD.getPixels(), surfSIMD.pitch * surfSIMD.h), 0);
+	}
+
+	void test_simd_matches_generic() {
+#if BENCHMARK_TIME
+		Common::install_null_g_system();
+
+		checkFormat<uint32>(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+		checkFormat<uint32>(Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24));
+		checkFormat<uint32>(Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0));
+		checkFormat<uint16>(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+		checkFormat<uint16>(Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0));
+		checkFormat<uint16>(Graphics::PixelFormat(2, 4, 4, 4, 4, 12, 8, 4, 0));
+#endif
+	}
+
+	void test_render_speed() {
+#if BENCHMARK_TIME
+		Common::install_null_g_system();
+
+		benchmarkFormat<uint32>(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0), "RGBA8888");
+		benchmarkFormat<uint16>(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0), "RGB565");
+#endif
+	}
+};
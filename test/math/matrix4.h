@@ -0,0 +1,302 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/debug.h"
+#include "common/ptr.h"
+#include "common/random.h"
+#include "common/system.h"
+
+#include "math/matrix4.h"
+#include "math/quat.h"
+
+#include "../null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+/**
+ * Test suite for the Matrix4 and Quaternion kernels, which are vectorized
+ * where SSE2 is available.
+ *
+ * The multiplications and transforms sum their products in the same order
+ * as the plain loops below, so they only differ where the compiler fuses
+ * multiplies and adds differently. The inverse and slerp are compared
+ * against double precision references.
+ */
+class Matrix4TestSuite : public CxxTest::TestSuite {
+public:
+	Common::ScopedPtr<Common::RandomSource> _random;
+
+	/* Restart the random data from a fixed seed, so every run is the same */
+	void seedRandom(uint32 seed) {
+		if (!_random) {
+#if NULL_OSYSTEM_IS_AVAILABLE
+			// RandomSource needs g_system
+			if (!g_system)
+				Common::install_null_g_system();
+#endif
+			_random.reset(new Common::RandomSource("matrix4"));
+		}
+		_random->setSeed(seed);
+	}
+
+	float nextFloat() {
+		return _random->getRandomNumber(0xFFFF) / 32768.0f - 1.0f;
+	}
+
+	void assertClose(const float *a, const float *b, int n) {
+		for (int i = 0; i < n; i++)
+			TS_ASSERT_DELTA(a[i], b[i], 1e-5f * MAX(1.0f, fabsf(b[i])));
+	}
+
+	Math::Matrix4 randomMatrix() {
+		Math::Matrix4 m;
+		for (int i = 0; i < 16; i++)
+			m.getData()[i] = nextFloat() * 4.0f;
+		return m;
+	}
+
+	/* The loop Matrix4::operator* used before it was vectorized */
+	Math::Matrix4 referenceMultiply(const Math::Matrix4 &m1, const Math::Matrix4 &m2) {
+		Math::Matrix4 result;
+		const float *d1 = m1.getData();
+		const float *d2 = m2.getData();
+		float *r = result.getData();
+
+		for (int i = 0; i < 16; i += 4) {
+			for (int j = 0; j < 4; ++j) {
+				r[i + j] = (d1[i + 0] * d2[j + 0]) +
+				           (d1[i + 1] * d2[j + 4]) +
+				           (d1[i + 2] * d2[j + 8]) +
+				           (d1[i + 3] * d2[j + 12]);
+			}
+		}
+		return result;
+	}
+
+	/* Gauss-Jordan elimination in double precision */
+	bool referenceInverse(const Math::Matrix4 &m, double inv[16]) {
+		double a[4][8];
+		for (int i = 0; i < 4; i++) {
+			for (int j = 0; j < 4; j++) {
+				a[i][j] = m.getData()[i * 4 + j];
+				a[i][j + 4] = i == j ? 1.0 : 0.0;
+			}
+		}
+
+		for (int col = 0; col < 4; col++) {
+			int pivot = col;
+			for (int i = col + 1; i < 4; i++) {
+				if (fabs(a[i][col]) > fabs(a[pivot][col]))
+					pivot = i;
+			}
+			if (a[pivot][col] == 0.0)
+				return false;
+			for (int j = 0; j < 8; j++)
+				SWAP(a[col][j], a[pivot][j]);
+
+			double scale = 1.0 / a[col][col];
+			for (int j = 0; j < 8; j++)
+				a[col][j] *= scale;
+			for (int i = 0; i < 4; i++) {
+				if (i == col)
+					continue;
+				double f = a[i][col];
+				for (int j = 0; j < 8; j++)
+					a[i][j] -= f * a[col][j];
+			}
+		}
+
+		for (int i = 0; i < 4; i++) {
+			for (int j = 0; j < 4; j++)
+				inv[i * 4 + j] = a[i][j + 4];
+		}
+		return true;
+	}
+
+	void test_multiply_matches_reference() {
+		seedRandom(1);
+		for (int i = 0; i < 200; i++) {
+			Math::Matrix4 m1 = randomMatrix();
+			Math::Matrix4 m2 = randomMatrix();
+			Math::Matrix4 expected = referenceMultiply(m1, m2);
+			Math::Matrix4 result = m1 * m2;
+			assertClose(result.getData(), expected.getData(), 16);
+		}
+	}
+
+	void test_transform_arrays() {
+		seedRandom(2);
+		const uint count = 37;
+
+		for (int i = 0; i < 20; i++) {
+			Math::Matrix4 m = randomMatrix();
+			const float *d = m.getData();
+
+			Math::Vector3d points[count], vectors[count], single[count];
+			Math::Vector4d points4[count], result4[count];
+			for (uint j = 0; j < count; j++) {
+				points[j].set(nextFloat() * 100.0f, nextFloat() * 100.0f, nextFloat() * 100.0f);
+				points4[j].set(points[j].x(), points[j].y(), points[j].z(), nextFloat());
+				single[j] = points[j];
+			}
+
+			m.transform(points, vectors, count, false);
+			for (uint j = 0; j < count; j++) {
+				const float x = single[j].x(), y = single[j].y(), z = single[j].z();
+				const float expected[3] = {
+					d[0] * x + d[1] * y + d[2] * z,
+					d[4] * x + d[5] * y + d[6] * z,
+					d[8] * x + d[9] * y + d[10] * z
+				};
+				assertClose(vectors[j].getData(), expected, 3);
+			}
+
+			// In place, and the same as transforming the points one at a time
+			m.transform(points, points, count, true);
+			for (uint j = 0; j < count; j++) {
+				const float x = single[j].x(), y = single[j].y(), z = single[j].z();
+				const float expected[3] = {
+					d[0] * x + d[1] * y + d[2] * z + d[3],
+					d[4] * x + d[5] * y + d[6] * z + d[7],
+					d[8] * x + d[9] * y + d[10] * z + d[11]
+				};
+				assertClose(points[j].getData(), expected, 3);
+
+				m.transform(&single[j], true);
+				TS_ASSERT_EQUALS(memcmp(points[j].getData(), single[j].getData(), sizeof(float) * 3), 0);
+			}
+
+			m.transform(points4, result4, count);
+			for (uint j = 0; j < count; j++) {
+				Math::Vector4d expected = m * points4[j];
+				assertClose(result4[j].getData(), expected.getData(), 4);
+			}
+		}
+	}
+
+	void test_inverse() {
+		seedRandom(3);
+		for (int i = 0; i < 200; i++) {
+			Math::Matrix4 m = randomMatrix();
+			double expected[16];
+			if (!referenceInverse(m, expected))
+				continue;
+
+			// Keep clear of nearly singular matrices, which no float
+			// implementation can invert accurately
+			double maxValue = 0.0;
+			for (int j = 0; j < 16; j++)
+				maxValue = MAX(maxValue, fabs(expected[j]));
+			if (maxValue > 100.0)
+				continue;
+
+			Math::Matrix4 inv = m;
+			TS_ASSERT(inv.inverse());
+			for (int j = 0; j < 16; j++)
+				TS_ASSERT_DELTA(inv.getData()[j], expected[j], 1e-4 * MAX(1.0, maxValue));
+		}
+
+		Math::Matrix4 singular;
+		singular.setValue(2, 2, 0.0f);
+		Math::Matrix4 copy = singular;
+		TS_ASSERT(!singular.inverse());
+		TS_ASSERT_EQUALS(memcmp(copy.getData(), singular.getData(), sizeof(float) * 16), 0);
+
+		Math::Matrix4 translation;
+		translation.setPosition(Math::Vector3d(1.0f, -2.0f, 3.0f));
+		TS_ASSERT(translation.inverse());
+		TS_ASSERT_EQUALS(translation.getPosition(), Math::Vector3d(-1.0f, 2.0f, -3.0f));
+	}
+
+	void test_slerp() {
+		seedRandom(4);
+		for (int i = 0; i < 200; i++) {
+			Math::Quaternion from(nextFloat(), nextFloat(), nextFloat(), nextFloat());
+			Math::Quaternion to(nextFloat(), nextFloat(), nextFloat(), nextFloat());
+			from.normalize();
+			to.normalize();
+			if (i == 0)
+				to = from;
+			float t = (nextFloat() + 1.0f) / 2.0f;
+
+			double dot = 0.0;
+			for (int j = 0; j < 4; j++)
+				dot += (double)from.getData()[j] * to.getData()[j];
+			double flip = dot < 0.0 ? -1.0 : 1.0;
+			dot = fabs(dot);
+
+			double scale0 = 1.0 - t, scale1 = t * flip;
+			if (dot < 1.0 - 1e-6) {
+				double theta = acos(dot);
+				scale0 = sin((1.0 - t) * theta) / sin(theta);
+				scale1 = sin(t * theta) / sin(theta) * flip;
+			}
+
+			Math::Quaternion result = from.slerpQuat(to, t);
+			for (int j = 0; j < 4; j++)
+				TS_ASSERT_DELTA(result.getData()[j], scale0 * from.getData()[j] + scale1 * to.getData()[j], 1e-4);
+		}
+	}
+
+	void test_kernel_speed() {
+#if BENCHMARK_TIME
+		Common::install_null_g_system();
+
+#ifdef SLOW_TESTS
+		const uint iters = 2000;
+#else
+		const uint iters = 20;
+#endif
+		const uint count = 1024;
+
+		seedRandom(5);
+		Math::Matrix4 m = randomMatrix();
+		Math::Matrix4 m2 = randomMatrix();
+		Common::Array<Math::Vector3d> points(count), results(count);
+		for (uint j = 0; j < count; j++)
+			points[j].set(nextFloat(), nextFloat(), nextFloat());
+
+		uint32 start = g_system->getMillis();
+		Math::Matrix4 acc;
+		for (uint i = 0; i < iters * count; i++)
+			acc = referenceMultiply(m, m2);
+		uint32 referenceMultiplyTime = g_system->getMillis() - start;
+
+		start = g_system->getMillis();
+		for (uint i = 0; i < iters * count; i++)
+			acc = m * m2;
+		uint32 multiplyTime = g_system->getMillis() - start;
+
+		// One matrix vector product per point, as transform() did before
+		start = g_system->getMillis();
+		for (uint i = 0; i < iters; i++) {
+			for (uint j = 0; j < count; j++) {
+				Math::Vector4d v(points[j].x(), points[j].y(), points[j].z(), 1.0f);
+				v = m * v;
+				results[j].set(v.x(), v.y(), v.z());
+			}
+		}
+		uint32 referenceTransformTime = g_system->getMillis() - start;
+
+		start = g_system->getMillis();
+		for (uint i = 0; i < iters; i++)
+			m.transform(points.data(), results.data(), count, true);
+		uint32 transformTime = g_system->getMillis() - start;
+
+		start = g_system->getMillis();
+		for (uint i = 0; i < iters * count / 16; i++) {
+			acc = m;
+			acc.inverse();
+		}
+		uint32 inverseTime = g_system->getMillis() - start;
+
+		debug("Matrix4 x %u: multiply %u ms (loop %u ms), inverse %u ms",
+		      iters * count, multiplyTime, referenceMultiplyTime, inverseTime * 16);
+		debug("Matrix4 transform %u points: %u ms (one at a time %u ms)",
+		      iters * count, transformTime, referenceTransformTime);
+#endif
+	}
+};
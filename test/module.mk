@@ -5,7 +5,7 @@
 #
 ######################################################################
 
-TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/common/formats/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/math/*.h $(srcdir)/test/image/*.h
+TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/common/formats/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/math/*.h $(srcdir)/test/image/*.h $(srcdir)/test/gui/*.h
 TEST_LIBS    :=
 
 ifdef POSIX
@@ -28,13 +28,17 @@ TEST_LIBS += test/null_osystem.o \
 	backends/platform/sdl/win32/win32_wrapper.o
 endif
 
-TEST_LIBS +=	audio/libaudio.a math/libmath.a common/formats/libformats.a common/compression/libcompression.a common/libcommon.a image/libimage.a graphics/libgraphics.a
+TEST_LIBS +=	gui/ThemeDrawCache.o audio/libaudio.a math/libmath.a common/formats/libformats.a common/compression/libcompression.a common/libcommon.a image/libimage.a graphics/libgraphics.a
 
 ifeq ($(ENABLE_WINTERMUTE), STATIC_PLUGIN)
 	TESTS += $(srcdir)/test/engines/wintermute/*.h
 	TEST_LIBS += engines/wintermute/libwintermute.a
 endif
 
+ifeq ($(ENABLE_BLADERUNNER), STATIC_PLUGIN)
+	TESTS += $(srcdir)/test/engines/bladerunner/*.h
+endif
+
 ifeq ($(ENABLE_ULTIMA), STATIC_PLUGIN)
 ifdef ENABLE_ULTIMA1
 	TESTS += $(srcdir)/test/engines/ultima/shared/*/*.h
@@ -45,6 +49,11 @@ endif
 	TEST_LIBS += engines/ultima/libultima.a
 endif
 
+ifeq ($(ENABLE_TWP), STATIC_PLUGIN)
+	TESTS += $(srcdir)/test/engines/twp/*.h
+	TEST_LIBS += engines/twp/libtwp.a
+endif
+
 #
 TEST_FLAGS   := --runner=StdioPrinter --no-std --no-eh
 TEST_CFLAGS  := $(CFLAGS) -I$(srcdir)/test/cxxtest
@@ -79,9 +88,28 @@ test/runner.cpp: $(TESTS) $(srcdir)/test/module.mk
 	@mkdir -p test
 	$(srcdir)/test/cxxtest/cxxtestgen.py $(TEST_FLAGS) -o $@ $+
 
+ifdef USE_TINYGL
+# Replays the TinyGL frame captures in the TINYGL_CAPTURES directory, and
+# reports the time each frame takes and a checksum of its image.
+TINYGL_CAPTURES ?= tinygl-captures
+
+tinygl-replay: test/tinygl-replay
+	./test/tinygl-replay
+# Always linked again, as the directory is built in. The libraries graphics
+# depends on are listed again, as only TinyGL pulls them in here.
+test/tinygl-replay: test/tinygl-replay.cpp $(TEST_LIBS)
+	+$(QUIET_CXX)$(LD) $(TEST_CXXFLAGS) $(CPPFLAGS) $(TEST_CFLAGS) -DTINYGL_CAPTURE_DIR='"$(TINYGL_CAPTURES)"' -o $@ test/tinygl-replay.cpp $(TEST_LIBS) math/libmath.a common/libcommon.a $(TEST_LDFLAGS)
+test/tinygl-replay.cpp: $(srcdir)/test/tinygl/replay.h $(srcdir)/test/module.mk
+	@mkdir -p test
+	$(srcdir)/test/cxxtest/cxxtestgen.py $(TEST_FLAGS) -o $@ $<
+
+.PHONY: tinygl-replay test/tinygl-replay
+endif
+
 clean: clean-test
 clean-test:
 	-$(RM) test/runner.cpp test/runner test/engine-data/encoding.dat test/null_osystem.o
+	-$(RM) test/tinygl-replay.cpp test/tinygl-replay
 	-rmdir test/engine-data
 
 test/engine-data/encoding.dat: $(srcdir)/dists/engine-data/encoding.dat
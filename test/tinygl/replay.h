@@ -0,0 +1,74 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/algorithm.h"
+#include "common/crc.h"
+#include "common/fs.h"
+#include "common/str.h"
+#include "common/stream.h"
+#include "common/system.h"
+
+#include "graphics/tinygl/tinygl.h"
+
+#include "../null_osystem.h"
+
+#ifndef TINYGL_CAPTURE_DIR
+#define TINYGL_CAPTURE_DIR "tinygl-captures"
+#endif
+
+/**
+ * Replays the TinyGL frame captures in TINYGL_CAPTURE_DIR, and reports how
+ * long each frame takes to draw and a checksum of its image.
+ *
+ * This is not part of the test target, it is built and run with
+ *   make tinygl-replay TINYGL_CAPTURES=<directory>
+ * Frames are captured with TinyGL::captureFrame().
+ */
+class TinyGLReplayTestSuite : public CxxTest::TestSuite {
+public:
+	void test_replay_captures() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::FSNode dir(TINYGL_CAPTURE_DIR);
+		Common::FSList files;
+		if (!dir.getChildren(files, Common::FSNode::kListFilesOnly)) {
+			TS_FAIL("No capture directory " TINYGL_CAPTURE_DIR);
+			return;
+		}
+		Common::sort(files.begin(), files.end());
+
+		const int iterations = 20;
+		for (uint i = 0; i < files.size(); i++) {
+			Common::SeekableReadStream *stream = files[i].createReadStream();
+			if (!stream)
+				continue;
+			TinyGL::ContextHandle *context = TinyGL::loadFrameCapture(stream);
+			delete stream;
+			if (!context) {
+				TS_WARN(Common::String::format("%s is not a frame capture", files[i].getName().c_str()).c_str());
+				continue;
+			}
+
+			// The first replay also warms up the caches
+			uint32 start = g_system->getMillis();
+			TinyGL::replayFrame();
+			uint32 firstTime = g_system->getMillis() - start;
+
+			start = g_system->getMillis();
+			for (int j = 0; j < iterations; j++)
+				TinyGL::replayFrame();
+			uint32 time = g_system->getMillis() - start;
+
+			Graphics::Surface surface;
+			TinyGL::getSurfaceRef(surface);
+			Common::CRC32 crc;
+			uint32 checksum = crc.crcFast((const byte *)surface.getPixels(), surface.pitch * surface.h);
+
+			TS_TRACE(Common::String::format("%s: %dx%d, first %u ms, average %.2f ms, checksum %08x",
+			                                files[i].getName().c_str(), surface.w, surface.h, firstTime,
+			                                (float)time / iterations, checksum).c_str());
+			TinyGL::destroyContext(context);
+		}
+#endif
+	}
+};